@@ -0,0 +1,133 @@
+// Compara LAYOUT_LINHAS e LAYOUT_BLOCOS em mapas largos.
+// Uso: ./bench_layout [n_linhas] [n_colunas] [prob_obstaculo]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../src/search/labirinto.h"
+#include "../src/search/labirinto_interno.h"
+#include "../src/search/algorithms.h"
+
+double _agora()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+Labirinto *_gerar(int n_linhas, int n_colunas, double prob)
+{
+    Labirinto *l = labirinto_criar(n_linhas, n_colunas);
+    srand(42);
+
+    for (int i = 0; i < n_linhas; i++)
+        for (int j = 0; j < n_colunas; j++)
+            if (rand() < prob * RAND_MAX)
+                labirinto_atribuir(l, i, j, OCUPADO);
+
+    return l;
+}
+
+// percorre o mapa coluna a coluna: cada acesso e' o vizinho de baixo do anterior
+long _varredura_vertical(Labirinto *l)
+{
+    long livres = 0;
+
+    for (int j = 0; j < l->n_colunas; j++)
+        for (int i = 0; i < l->n_linhas; i++)
+            livres += _labirinto_obter(l, i, j) == LIVRE;
+
+    return livres;
+}
+
+// BFS de 8 vizinhos a partir do centro, com fila de indices e marcas no
+// proprio labirinto, como fazem os motores de busca
+long _bfs_grade(Labirinto *l)
+{
+    static const int dirs[8][2] = {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}};
+    int *fila = (int *)malloc((size_t)l->n_linhas * l->n_colunas * sizeof(int) * 2);
+    long ini = 0, fim = 0;
+
+    int x = l->n_colunas / 2, y = l->n_linhas / 2;
+    _labirinto_marcar(l, y, x, EXPANDIDO);
+    fila[fim++] = x;
+    fila[fim++] = y;
+
+    while (ini < fim)
+    {
+        x = fila[ini++];
+        y = fila[ini++];
+
+        for (int k = 0; k < 8; k++)
+        {
+            int nx = x + dirs[k][0], ny = y + dirs[k][1];
+
+            if (_labirinto_obter(l, ny, nx) == LIVRE)
+            {
+                _labirinto_marcar(l, ny, nx, EXPANDIDO);
+                fila[fim++] = nx;
+                fila[fim++] = ny;
+            }
+        }
+    }
+
+    free(fila);
+    return fim / 2;
+}
+
+void _medir(const char *nome, Labirinto *l)
+{
+    double t0 = _agora();
+    long livres = _varredura_vertical(l);
+    double t1 = _agora();
+    long visitadas = _bfs_grade(l);
+    double t2 = _agora();
+
+    printf("%-8s varredura vertical: %8.3lf s (%ld livres)   bfs: %8.3lf s (%ld visitadas)\n", nome, t1 - t0, livres, t2 - t1, visitadas);
+}
+
+void _medir_a_star(const char *nome, Labirinto *l)
+{
+    Celula inicio = {0}, fim = {0};
+    inicio.x = 0;
+    inicio.y = 0;
+    fim.x = l->n_colunas < 400 ? l->n_colunas - 1 : 400;
+    fim.y = l->n_linhas - 1;
+
+    labirinto_atribuir(l, inicio.y, inicio.x, LIVRE);
+    labirinto_atribuir(l, fim.y, fim.x, LIVRE);
+
+    double t0 = _agora();
+    ResultData r = a_star(l, inicio, fim);
+    double t1 = _agora();
+
+    printf("%-8s a_star (0,0)->(%d,%d): %8.3lf s (%d expandidos, custo %.2lf)\n", nome, fim.x, fim.y, t1 - t0, r.nos_expandidos, r.custo_caminho);
+
+    if (r.caminho)
+        free(r.caminho);
+}
+
+int main(int argc, char **argv)
+{
+    int n_linhas = argc > 1 ? atoi(argv[1]) : 1000;
+    int n_colunas = argc > 2 ? atoi(argv[2]) : 100000;
+    double prob = argc > 3 ? atof(argv[3]) : 0.2;
+
+    printf("labirinto %d x %d, %.0lf%% de obstaculos\n", n_linhas, n_colunas, prob * 100);
+
+    for (int layout = LAYOUT_LINHAS; layout <= LAYOUT_BLOCOS; layout++)
+    {
+        const char *nome = layout == LAYOUT_LINHAS ? "linhas" : "blocos";
+
+        Labirinto *l = _gerar(n_linhas, n_colunas, prob);
+        labirinto_definir_layout(l, layout);
+        _medir(nome, l);
+        labirinto_destruir(l);
+
+        l = _gerar(n_linhas, n_colunas, prob);
+        labirinto_definir_layout(l, layout);
+        _medir_a_star(nome, l);
+        labirinto_destruir(l);
+    }
+
+    return 0;
+}
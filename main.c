@@ -1,60 +1,88 @@
-
-#include <stdio.h>
-#include <stdlib.h>
-#include "src/search/labirinto.h"
-#include "src/search/algorithms.h"
-
-void print_result(ResultData *result)
-{
-    if (!result->sucesso)
-    {
-        printf("IMPOSSIVEL\n");
-        return;
-    }
-
-    for (int i = 0; i < result->tamanho_caminho; i++)
-        printf("%d %d\n", result->caminho[i].x, result->caminho[i].y);
-
-    printf("%.2lf\n", result->custo_caminho);
-    printf("%d\n", result->tamanho_caminho);
-    printf("%d\n", result->nos_expandidos);
-}
-
-void mostra_caminho(Labirinto *l, ResultData *result, Celula inicio, Celula fim)
-{
-    if (result->sucesso)
-    {
-        for (int i = 0; i < result->tamanho_caminho; i++)
-            labirinto_atribuir(l, result->caminho[i].y, result->caminho[i].x, CAMINHO);
-    }
-
-    labirinto_atribuir(l, inicio.y, inicio.x, INICIO);
-    labirinto_atribuir(l, fim.y, fim.x, FIM);
-    labirinto_print(l);
-}
-
-int main()
-{
-    char arquivo_labirinto[100];
-    char algoritmo[100];
-    Celula inicio, fim;
-    ResultData result;
-    Labirinto *lab;
-
-    scanf("%s", arquivo_labirinto);
-    scanf("%d %d", &inicio.x, &inicio.y);
-    scanf("%d %d", &fim.x, &fim.y);
-    scanf("\n%s", algoritmo);
-
-    lab = labirinto_carregar(arquivo_labirinto);
-
-    result = dummy_search(lab, inicio, fim);
-    print_result(&result);
-    mostra_caminho(lab, &result, inicio, fim);
-
-    labirinto_destruir(lab);
-    if (result.caminho != NULL)
-        free(result.caminho);
-
-    return 0;
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "src/search/labirinto.h"
+#include "src/search/algorithms.h"
+#include "src/search/corrida.h"
+#include "src/search/qualquer_angulo.h"
+#include "src/search/vizinhanca.h"
+
+void print_result(ResultData *result)
+{
+    if (!result->sucesso)
+    {
+        printf("IMPOSSIVEL\n");
+        return;
+    }
+
+    for (int i = 0; i < result->tamanho_caminho; i++)
+        printf("%d %d\n", result->caminho[i].x, result->caminho[i].y);
+
+    printf("%.2lf\n", result->custo_caminho);
+    printf("%d\n", result->tamanho_caminho);
+    printf("%d\n", result->nos_expandidos);
+}
+
+void mostra_caminho(Labirinto *l, ResultData *result, Celula inicio, Celula fim)
+{
+    if (result->sucesso)
+    {
+        for (int i = 0; i < result->tamanho_caminho; i++)
+            labirinto_atribuir(l, result->caminho[i].y, result->caminho[i].x, CAMINHO);
+    }
+
+    labirinto_atribuir(l, inicio.y, inicio.x, INICIO);
+    labirinto_atribuir(l, fim.y, fim.x, FIM);
+    labirinto_print(l);
+}
+
+ResultData executa_algoritmo(char *algoritmo, Labirinto *lab, Celula inicio, Celula fim)
+{
+    if (!strcmp(algoritmo, "A*"))
+        return a_star(lab, inicio, fim);
+    else if (!strcmp(algoritmo, "BFS"))
+        return breadth_first_search(lab, inicio, fim);
+    else if (!strcmp(algoritmo, "DFS"))
+        return depth_first_search(lab, inicio, fim);
+    else if (!strcmp(algoritmo, "RACE"))
+        // varios motores em paralelo; vale a resposta do primeiro
+        return corrida(lab, inicio, fim, NULL, NULL);
+    else if (!strcmp(algoritmo, "THETA*"))
+        // so' os pontos de virada, com custo euclidiano
+        return theta_star(lab, inicio, fim, NULL);
+    else if (!strcmp(algoritmo, "A*4"))
+        return a_star_vizinhanca(lab, inicio, fim, VIZINHANCA_4, NULL);
+    else if (!strcmp(algoritmo, "A*8"))
+        return a_star_vizinhanca(lab, inicio, fim, VIZINHANCA_8, NULL);
+    else if (!strcmp(algoritmo, "A*8-SEM-QUINAS"))
+        return a_star_vizinhanca(lab, inicio, fim, VIZINHANCA_8_SEM_QUINAS, NULL);
+
+    return dummy_search(lab, inicio, fim);
+}
+
+int main()
+{
+    char arquivo_labirinto[100];
+    char algoritmo[100];
+    Celula inicio, fim;
+    ResultData result;
+    Labirinto *lab;
+
+    scanf("%s", arquivo_labirinto);
+    scanf("%d %d", &inicio.x, &inicio.y);
+    scanf("%d %d", &fim.x, &fim.y);
+    scanf("\n%s", algoritmo);
+
+    lab = labirinto_carregar(arquivo_labirinto);
+
+    result = executa_algoritmo(algoritmo, lab, inicio, fim);
+    print_result(&result);
+    mostra_caminho(lab, &result, inicio, fim);
+
+    labirinto_destruir(lab);
+    if (result.caminho != NULL)
+        free(result.caminho);
+
+    return 0;
 }
\ No newline at end of file
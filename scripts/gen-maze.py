@@ -25,6 +25,65 @@ def save_maze(maze, output_path):
                 f.write(struct.pack('B', maze[i][j]))
 
 
+def _varint(value):
+    out = bytearray()
+    while True:
+        b = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return bytes(out)
+
+
+def _encode_block(rows):
+    """Codifica um bloco de linhas como bits (1) ou RLE (2), o que for menor."""
+    width = len(rows[0])
+
+    bits = bytearray()
+    for row in rows:
+        packed = bytearray((width + 7) // 8)
+        for j, cell in enumerate(row):
+            if cell:
+                packed[j >> 3] |= 1 << (j & 7)
+        bits += packed
+
+    # corridas alternadas de livre/ocupado, comecando por livre
+    rle = bytearray()
+    value, run = 0, 0
+    for row in rows:
+        for cell in row:
+            if cell != value:
+                rle += _varint(run)
+                value, run = cell, 0
+            run += 1
+    if run:
+        rle += _varint(run)
+
+    if len(rle) < len(bits):
+        return b'\x02' + bytes(rle)
+    return b'\x01' + bytes(bits)
+
+
+def save_maze_compact(maze, output_path, rows_per_block=256):
+    """Formato compactado lido por labirinto_carregar (ver labirinto.c)."""
+    blocks = [_encode_block(maze[i:i + rows_per_block])
+              for i in range(0, len(maze), rows_per_block)]
+
+    offsets = [0]
+    for block in blocks:
+        offsets.append(offsets[-1] + len(block))
+
+    with open(output_path, "wb") as f:
+        f.write(b'LABZ')
+        f.write(struct.pack('iiiii', 1, len(maze), len(maze[0]),
+                            rows_per_block, len(blocks)))
+        f.write(struct.pack('%dq' % len(offsets), *offsets))
+        for block in blocks:
+            f.write(block)
+
+
 def parse_args():
     parser = argparse.ArgumentParser(description="Generate a maze.")
     parser.add_argument('output_path', type=str,
@@ -33,6 +92,8 @@ def parse_args():
     parser.add_argument('n_colunas', type=int, help="Numero de colunas.")
     parser.add_argument('prob', type=float, default=0.3,
                         help="Probabilidade de uma celula ser um obstaculo.")
+    parser.add_argument('--compactado', action='store_true',
+                        help="Salva no formato compactado (bits/RLE por bloco).")
     return parser.parse_args()
 
 
@@ -48,7 +109,10 @@ def main():
             maze[i][len(maze) - i - 1] = 0
     """
 
-    save_maze(maze, args.output_path)
+    if args.compactado:
+        save_maze_compact(maze, args.output_path)
+    else:
+        save_maze(maze, args.output_path)
 
 
 if __name__ == "__main__":
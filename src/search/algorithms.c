@@ -1,315 +1,418 @@
-
-#include <math.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include "algorithms.h"
-#include "../ed/heap.h"
-#include "../ed/queue.h"
-#include "../ed/stack.h"
-#include "../ed/deque.h"
-#include "../ed/hash.h"
-
-ResultData _default_result()
-{
-    ResultData result;
-
-    result.caminho = NULL;
-    result.custo_caminho = 0;
-    result.nos_expandidos = 0;
-    result.tamanho_caminho = 0;
-    result.sucesso = 0;
-
-    return result;
-}
-
-double _cell_distance(Celula *c1, Celula *c2) {
-    return sqrt(pow(c1->x - c2->x, 2) + pow(c1->y - c2->y, 2));
-}
-
-ResultData _process_path(ResultData result, Celula *c) {
-    while (c) {
-        result.caminho[result.tamanho_caminho] = *c;
-        result.tamanho_caminho++;
-
-        Celula *prev = c->prev;
-
-        if (prev) {
-            result.custo_caminho += _cell_distance(c, prev);
-        }
-        c = prev;
-    }
-
-    // Fixing path (reversing)
-    for (int i = 0; i < result.tamanho_caminho / 2; i++) {
-        Celula aux = result.caminho[i];
-        result.caminho[i] = result.caminho[result.tamanho_caminho - i - 1];
-        result.caminho[result.tamanho_caminho - i - 1] = aux;
-    }
-
-    return result;
-}
-
-Celula *celula_create(int x, int y, Celula* prev)
-{
-    Celula *c = malloc(sizeof(Celula));
-    c->x = x;
-    c->y = y;
-    c->prev = prev;
-    c->g = c->h = 0;
-    return c;
-}
-
-void celula_destroy(Celula *c)
-{
-    free(c);
-}
-
-void free_fn (void *cel) {
-    celula_destroy(cel);
-}
-
-int celula_hash(HashTable *h, void *key)
-{
-    Celula *c = (Celula *)key;
-    // 83 e 97 sao primos e o operador "^" é o XOR bit a bit
-    return ((c->x * 83) ^ (c->y * 97)) % hash_table_size(h);
-}
-
-int celula_cmp(void *c1, void *c2)
-{
-    Celula *a = (Celula *)c1;
-    Celula *b = (Celula *)c2;
-
-    if (a->x == b->x && a->y == b->y)
-        return 0;
-    else
-        return 1;
-}
-
-int celula_hash_cmp(void *c1, void *c2) {
-    HashTableItem *d1 = (HashTableItem *)c1;
-    Celula *a = (Celula *)d1->key;
-    Celula *b = (Celula *)c2;
-    
-    if (a->x == b->x && a->y == b->y) {
-        return 0;
-    }
-    else
-        return 1;
-}
-
-int directions[8][2] = {{0,-1}, {1,-1}, {1,0}, {1,1}, {0,1}, {-1,1}, {-1,0}, {-1,-1}};
-
-ResultData a_star(Labirinto *l, Celula inicio, Celula fim)
-{
-    ResultData result = _default_result();
-    int max_length = labirinto_n_linhas(l) * labirinto_n_colunas(l);
-
-    result.caminho = calloc(max_length, sizeof(Celula));
-
-    HashTable *ht = hash_table_construct(101, celula_hash, celula_hash_cmp, free, free);
-    Heap *heap = heap_construct(ht);
-
-    Celula *curr = celula_create(inicio.x, inicio.y, NULL);
-    curr->g = 0;
-    curr->h = _cell_distance(curr, &fim);
-
-    heap_push(heap, curr, curr->g + curr->h);
-
-    Deque *deque = deque_construct(free);
-
-    while (!heap_empty(heap)) {
-        curr = heap_pop(heap);
-        labirinto_atribuir(l, curr->y, curr->x, EXPANDIDO);
-        result.nos_expandidos++;
-
-        deque_push_back(deque, curr);
-
-        if (celula_cmp(curr, &fim) == 0) {
-            result.sucesso = 1;
-            result = _process_path(result, curr);
-            break;
-        }
-
-        for (int i = 0; i < 8; i++) {
-            int x = curr->x + directions[i][0];
-            int y = curr->y + directions[i][1];
-
-            if (x >= 0 && y >= 0 && x < labirinto_n_colunas(l) && y < labirinto_n_linhas(l)) {
-                TipoCelula tipo = labirinto_obter(l, y, x);
-
-                if (tipo != EXPANDIDO && tipo != OCUPADO) {
-                    labirinto_atribuir(l, y, x, FRONTEIRA);
-                    
-                    Celula *cel = celula_create(x, y, curr);
-                    cel->g = curr->g + _cell_distance(curr, cel);
-                    cel->h = _cell_distance(cel, &fim);
-
-                    cel = heap_push(heap, cel, cel->g + cel->h);
-
-                    if (cel) {
-                        celula_destroy(cel);
-                    }
-                }
-            }
-        }
-    }
-
-    if (result.sucesso == 0) {
-        free(result.caminho);
-        result.caminho = NULL;
-    }
-
-    heap_destroy(heap);
-    hash_table_destroy(ht);
-    deque_destroy(deque);
-
-    return result;
-}
-
-ResultData breadth_first_search(Labirinto *l, Celula inicio, Celula fim)
-{
-    ResultData result = _default_result();
-    int max_length = labirinto_n_linhas(l) * labirinto_n_colunas(l);
-
-    result.caminho = calloc(max_length, sizeof(Celula));
-
-    Queue *queue = queue_construct(free_fn);
-    queue_push(queue, celula_create(inicio.x, inicio.y, NULL));
-
-    Deque *deque = deque_construct(free_fn);
-
-    while (!queue_empty(queue)) {
-        Celula *curr = queue_pop(queue);
-        labirinto_atribuir(l, curr->y, curr->x, EXPANDIDO);
-        result.nos_expandidos++;
-
-        deque_push_back(deque, curr);
-
-        if (celula_cmp(curr, &fim) == 0) {
-            result.sucesso = 1;
-            result = _process_path(result, curr);
-            break;
-        }
-
-        for (int i = 0; i < 8; i++) {
-            int x = curr->x + directions[i][0];
-            int y = curr->y + directions[i][1];
-
-            if (x >= 0 && y >= 0 && x < labirinto_n_colunas(l) && y < labirinto_n_linhas(l)) {
-                TipoCelula cel = labirinto_obter(l, y, x);
-
-                if (cel == LIVRE || cel == FIM) {
-                    queue_push(queue, celula_create(x, y, curr));
-                    labirinto_atribuir(l, y, x, FRONTEIRA);
-                }
-            }
-        }
-    }
-
-    if (result.sucesso == 0) {
-        free(result.caminho);
-        result.caminho = NULL;
-    }
-
-    queue_destroy(queue);
-    deque_destroy(deque);
-
-    return result;
-}
-
-ResultData depth_first_search(Labirinto *l, Celula inicio, Celula fim)
-{
-    ResultData result = _default_result();
-    int max_length = labirinto_n_linhas(l) * labirinto_n_colunas(l);
-
-    result.caminho = calloc(max_length, sizeof(Celula));
-
-    Stack *stack = stack_construct(free_fn);
-    stack_push(stack, celula_create(inicio.x, inicio.y, NULL));
-
-    Deque *deque = deque_construct(free_fn);
-
-    while (!stack_empty(stack)) {
-        Celula *curr = stack_pop(stack);
-        labirinto_atribuir(l, curr->y, curr->x, EXPANDIDO);
-        result.nos_expandidos++;
-
-        deque_push_back(deque, curr);
-
-        if (celula_cmp(curr, &fim) == 0) {
-            result.sucesso = 1;
-            result = _process_path(result, curr);
-            break;
-        }
-
-        for (int i = 0; i < 8; i++) {
-            int x = curr->x + directions[i][0];
-            int y = curr->y + directions[i][1];
-
-            if (x >= 0 && y >= 0 && x < labirinto_n_colunas(l) && y < labirinto_n_linhas(l)) {
-                TipoCelula cel = labirinto_obter(l, y, x);
-
-                if (cel == LIVRE || cel == FIM) {
-                    stack_push(stack, celula_create(x, y, curr));
-                    labirinto_atribuir(l, y, x, FRONTEIRA);
-                }
-            }
-        }
-    }
-
-    if (result.sucesso == 0) {
-        free(result.caminho);
-        result.caminho = NULL;
-    }
-
-    stack_destroy(stack);
-    deque_destroy(deque);
-
-    return result;
-}
-
-ResultData dummy_search(Labirinto *l, Celula inicio, Celula fim)
-{
-    int max_path_length = 0;
-    float dx, dy;
-
-    ResultData result = _default_result();
-
-    max_path_length = abs(fim.x - inicio.x) + abs(fim.y - inicio.y);
-    result.caminho = (Celula *)malloc(sizeof(Celula) * max_path_length);
-    result.sucesso = 1;
-
-    Celula atual = inicio;
-    result.caminho[result.tamanho_caminho++] = atual;
-    result.nos_expandidos++;
-
-    while ((atual.x != fim.x) || (atual.y != fim.y))
-    {
-        dx = fim.x - atual.x;
-        dy = fim.y - atual.y;
-
-        if (dx != 0)
-            dx /= fabs(dx);
-
-        if (dy != 0)
-            dy /= fabs(dy);
-
-        atual.x += (int)dx;
-        atual.y += (int)dy;
-
-        if (labirinto_obter(l, atual.y, atual.x) == OCUPADO || (atual.x > labirinto_n_colunas(l) - 1) || (atual.y > labirinto_n_linhas(l) - 1) || (atual.x < 0) || (atual.y < 0))
-        {
-            result.sucesso = 0;
-            free(result.caminho);
-            result.caminho = NULL;
-            return result;
-        }
-
-        result.caminho[result.tamanho_caminho++] = atual;
-        result.nos_expandidos++;
-        result.custo_caminho += sqrt(pow(dx, 2) + pow(dy, 2));
-    }
-
-    return result;
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "algorithms.h"
+#include "labirinto_interno.h"
+#include "../ed/heap.h"
+#include "../ed/queue.h"
+#include "../ed/stack.h"
+#include "../ed/deque.h"
+#include "../ed/hash.h"
+
+ResultData _default_result()
+{
+    ResultData result;
+
+    result.caminho = NULL;
+    result.custo_caminho = 0;
+    result.nos_expandidos = 0;
+    result.tamanho_caminho = 0;
+    result.sucesso = 0;
+    result.status = BUSCA_CONCLUIDA;
+
+    return result;
+}
+
+double _busca_agora()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+ControleBusca controle_criar(double segundos)
+{
+    ControleBusca controle;
+
+    controle.cancelado = 0;
+    controle.prazo = segundos > 0 ? _busca_agora() + segundos : 0;
+
+    return controle;
+}
+
+void controle_cancelar(ControleBusca *controle)
+{
+    __atomic_store_n(&controle->cancelado, 1, __ATOMIC_RELAXED);
+}
+
+int controle_cancelado(ControleBusca *controle)
+{
+    return controle && __atomic_load_n(&controle->cancelado, __ATOMIC_RELAXED);
+}
+
+StatusBusca controle_verificar(ControleBusca *controle)
+{
+    if (!controle)
+        return BUSCA_CONCLUIDA;
+
+    if (__atomic_load_n(&controle->cancelado, __ATOMIC_RELAXED))
+        return BUSCA_CANCELADA;
+
+    if (controle->prazo > 0 && _busca_agora() > controle->prazo)
+        return BUSCA_TEMPO_ESGOTADO;
+
+    return BUSCA_CONCLUIDA;
+}
+
+double _cell_distance(Celula *c1, Celula *c2) {
+    return sqrt(pow(c1->x - c2->x, 2) + pow(c1->y - c2->y, 2));
+}
+
+ResultData _process_path(ResultData result, Celula *c) {
+    while (c) {
+        result.caminho[result.tamanho_caminho] = *c;
+        result.tamanho_caminho++;
+
+        Celula *prev = c->prev;
+
+        if (prev) {
+            result.custo_caminho += _cell_distance(c, prev);
+        }
+        c = prev;
+    }
+
+    // Fixing path (reversing)
+    for (int i = 0; i < result.tamanho_caminho / 2; i++) {
+        Celula aux = result.caminho[i];
+        result.caminho[i] = result.caminho[result.tamanho_caminho - i - 1];
+        result.caminho[result.tamanho_caminho - i - 1] = aux;
+    }
+
+    return result;
+}
+
+Celula *celula_create(int x, int y, Celula* prev)
+{
+    Celula *c = malloc(sizeof(Celula));
+    c->x = x;
+    c->y = y;
+    c->prev = prev;
+    c->g = c->h = 0;
+    return c;
+}
+
+void celula_destroy(Celula *c)
+{
+    free(c);
+}
+
+void free_fn (void *cel) {
+    celula_destroy(cel);
+}
+
+int celula_hash(HashTable *h, void *key)
+{
+    Celula *c = (Celula *)key;
+    // 83 e 97 sao primos e o operador "^" é o XOR bit a bit
+    return ((c->x * 83) ^ (c->y * 97)) % hash_table_size(h);
+}
+
+int celula_cmp(void *c1, void *c2)
+{
+    Celula *a = (Celula *)c1;
+    Celula *b = (Celula *)c2;
+
+    if (a->x == b->x && a->y == b->y)
+        return 0;
+    else
+        return 1;
+}
+
+int celula_hash_cmp(void *c1, void *c2) {
+    HashTableItem *d1 = (HashTableItem *)c1;
+    Celula *a = (Celula *)d1->key;
+    Celula *b = (Celula *)c2;
+    
+    if (a->x == b->x && a->y == b->y) {
+        return 0;
+    }
+    else
+        return 1;
+}
+
+int directions[8][2] = {{0,-1}, {1,-1}, {1,0}, {1,1}, {0,1}, {-1,1}, {-1,0}, {-1,-1}};
+
+double _heuristica_euclidiana(Celula *c, Celula *fim, void *contexto)
+{
+    return _cell_distance(c, fim);
+}
+
+ResultData a_star(Labirinto *l, Celula inicio, Celula fim)
+{
+    return a_star_heuristica(l, inicio, fim, _heuristica_euclidiana, NULL, NULL);
+}
+
+ResultData a_star_controlado(Labirinto *l, Celula inicio, Celula fim, ControleBusca *controle)
+{
+    return a_star_heuristica(l, inicio, fim, _heuristica_euclidiana, NULL, controle);
+}
+
+ResultData a_star_heuristica(Labirinto *l, Celula inicio, Celula fim, Heuristica heuristica, void *contexto, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+
+    // sem isso a busca marcaria um inicio OCUPADO como EXPANDIDO
+    if (!_labirinto_livre(l, inicio.y, inicio.x) || !_labirinto_livre(l, fim.y, fim.x))
+        return result;
+
+    int max_length = labirinto_n_linhas(l) * labirinto_n_colunas(l);
+
+    result.caminho = calloc(max_length, sizeof(Celula));
+
+    HashTable *ht = hash_table_construct(101, celula_hash, celula_hash_cmp, free, free);
+    Heap *heap = heap_construct(ht);
+
+    Celula *curr = celula_create(inicio.x, inicio.y, NULL);
+    curr->g = 0;
+    curr->h = heuristica(curr, &fim, contexto);
+
+    heap_push(heap, curr, curr->g + curr->h);
+
+    Deque *deque = deque_construct(free);
+
+    // as marcas sao so' para labirinto_print (nao cobrem terreno)
+    uint64_t *fechados = _labirinto_conjunto_criar(l);
+
+    while (!heap_empty(heap)) {
+        if (result.nos_expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        curr = heap_pop(heap);
+        _labirinto_conjunto_inserir(l, fechados, curr->y, curr->x);
+        _labirinto_marcar(l, curr->y, curr->x, EXPANDIDO);
+        result.nos_expandidos++;
+
+        deque_push_back(deque, curr);
+
+        if (celula_cmp(curr, &fim) == 0) {
+            result.sucesso = 1;
+            result = _process_path(result, curr);
+            break;
+        }
+
+        for (int i = 0; i < 8; i++) {
+            int x = curr->x + directions[i][0];
+            int y = curr->y + directions[i][1];
+
+            // a borda OCUPADO do labirinto dispensa a checagem de limites
+            if (!_labirinto_bloqueado(l, y, x) && !_labirinto_conjunto_contem(l, fechados, y, x)) {
+                _labirinto_marcar(l, y, x, FRONTEIRA);
+
+                Celula *cel = celula_create(x, y, curr);
+                cel->g = curr->g + _cell_distance(curr, cel);
+                cel->h = heuristica(cel, &fim, contexto);
+
+                // heuristica infinita: o fim nao e' alcancavel a partir daqui
+                if (isinf(cel->h)) {
+                    celula_destroy(cel);
+                    continue;
+                }
+
+                cel = heap_push(heap, cel, cel->g + cel->h);
+
+                if (cel) {
+                    celula_destroy(cel);
+                }
+            }
+        }
+    }
+
+    if (result.sucesso == 0) {
+        free(result.caminho);
+        result.caminho = NULL;
+    }
+
+    heap_destroy(heap);
+    hash_table_destroy(ht);
+    deque_destroy(deque);
+    free(fechados);
+
+    return result;
+}
+
+ResultData breadth_first_search(Labirinto *l, Celula inicio, Celula fim)
+{
+    return breadth_first_search_controlado(l, inicio, fim, NULL);
+}
+
+ResultData breadth_first_search_controlado(Labirinto *l, Celula inicio, Celula fim, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+
+    if (!_labirinto_livre(l, inicio.y, inicio.x) || !_labirinto_livre(l, fim.y, fim.x))
+        return result;
+
+    int max_length = labirinto_n_linhas(l) * labirinto_n_colunas(l);
+
+    result.caminho = calloc(max_length, sizeof(Celula));
+
+    Queue *queue = queue_construct(free_fn);
+    queue_push(queue, celula_create(inicio.x, inicio.y, NULL));
+
+    // celulas ja' colocadas na fila (as marcas sao so' para labirinto_print)
+    uint64_t *vistos = _labirinto_conjunto_criar(l);
+    _labirinto_conjunto_inserir(l, vistos, inicio.y, inicio.x);
+
+    Deque *deque = deque_construct(free_fn);
+
+    while (!queue_empty(queue)) {
+        if (result.nos_expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        Celula *curr = queue_pop(queue);
+        _labirinto_marcar(l, curr->y, curr->x, EXPANDIDO);
+        result.nos_expandidos++;
+
+        deque_push_back(deque, curr);
+
+        if (celula_cmp(curr, &fim) == 0) {
+            result.sucesso = 1;
+            result = _process_path(result, curr);
+            break;
+        }
+
+        for (int i = 0; i < 8; i++) {
+            int x = curr->x + directions[i][0];
+            int y = curr->y + directions[i][1];
+
+            if (!_labirinto_bloqueado(l, y, x) && !_labirinto_conjunto_contem(l, vistos, y, x)) {
+                _labirinto_conjunto_inserir(l, vistos, y, x);
+                queue_push(queue, celula_create(x, y, curr));
+                _labirinto_marcar(l, y, x, FRONTEIRA);
+            }
+        }
+    }
+
+    if (result.sucesso == 0) {
+        free(result.caminho);
+        result.caminho = NULL;
+    }
+
+    queue_destroy(queue);
+    deque_destroy(deque);
+    free(vistos);
+
+    return result;
+}
+
+ResultData depth_first_search(Labirinto *l, Celula inicio, Celula fim)
+{
+    return depth_first_search_controlado(l, inicio, fim, NULL);
+}
+
+ResultData depth_first_search_controlado(Labirinto *l, Celula inicio, Celula fim, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+
+    if (!_labirinto_livre(l, inicio.y, inicio.x) || !_labirinto_livre(l, fim.y, fim.x))
+        return result;
+
+    int max_length = labirinto_n_linhas(l) * labirinto_n_colunas(l);
+
+    result.caminho = calloc(max_length, sizeof(Celula));
+
+    Stack *stack = stack_construct(free_fn);
+    stack_push(stack, celula_create(inicio.x, inicio.y, NULL));
+
+    // celulas ja' colocadas na fila (as marcas sao so' para labirinto_print)
+    uint64_t *vistos = _labirinto_conjunto_criar(l);
+    _labirinto_conjunto_inserir(l, vistos, inicio.y, inicio.x);
+
+    Deque *deque = deque_construct(free_fn);
+
+    while (!stack_empty(stack)) {
+        if (result.nos_expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        Celula *curr = stack_pop(stack);
+        _labirinto_marcar(l, curr->y, curr->x, EXPANDIDO);
+        result.nos_expandidos++;
+
+        deque_push_back(deque, curr);
+
+        if (celula_cmp(curr, &fim) == 0) {
+            result.sucesso = 1;
+            result = _process_path(result, curr);
+            break;
+        }
+
+        for (int i = 0; i < 8; i++) {
+            int x = curr->x + directions[i][0];
+            int y = curr->y + directions[i][1];
+
+            if (!_labirinto_bloqueado(l, y, x) && !_labirinto_conjunto_contem(l, vistos, y, x)) {
+                _labirinto_conjunto_inserir(l, vistos, y, x);
+                stack_push(stack, celula_create(x, y, curr));
+                _labirinto_marcar(l, y, x, FRONTEIRA);
+            }
+        }
+    }
+
+    if (result.sucesso == 0) {
+        free(result.caminho);
+        result.caminho = NULL;
+    }
+
+    stack_destroy(stack);
+    deque_destroy(deque);
+    free(vistos);
+
+    return result;
+}
+
+ResultData dummy_search(Labirinto *l, Celula inicio, Celula fim)
+{
+    int max_path_length = 0;
+    float dx, dy;
+
+    ResultData result = _default_result();
+
+    max_path_length = abs(fim.x - inicio.x) + abs(fim.y - inicio.y);
+    result.caminho = (Celula *)malloc(sizeof(Celula) * max_path_length);
+    result.sucesso = 1;
+
+    Celula atual = inicio;
+    result.caminho[result.tamanho_caminho++] = atual;
+    result.nos_expandidos++;
+
+    while ((atual.x != fim.x) || (atual.y != fim.y))
+    {
+        dx = fim.x - atual.x;
+        dy = fim.y - atual.y;
+
+        if (dx != 0)
+            dx /= fabs(dx);
+
+        if (dy != 0)
+            dy /= fabs(dy);
+
+        atual.x += (int)dx;
+        atual.y += (int)dy;
+
+        if ((atual.x > labirinto_n_colunas(l) - 1) || (atual.y > labirinto_n_linhas(l) - 1) || (atual.x < 0) || (atual.y < 0) || labirinto_bloqueado(l, atual.y, atual.x))
+        {
+            result.sucesso = 0;
+            free(result.caminho);
+            result.caminho = NULL;
+            return result;
+        }
+
+        result.caminho[result.tamanho_caminho++] = atual;
+        result.nos_expandidos++;
+        result.custo_caminho += sqrt(pow(dx, 2) + pow(dy, 2));
+    }
+
+    return result;
 }
\ No newline at end of file
@@ -1,32 +1,89 @@
-
-#ifndef _ALGORITHMS_H_
-#define _ALGORITHMS_H_
-
-#include "labirinto.h"
-
-typedef struct celula
-{
-    int x;
-    int y;
-    double g, h;
-    struct celula *prev;
-} Celula;
-
-typedef struct
-{
-    Celula *caminho;
-    double custo_caminho;
-    int tamanho_caminho;
-    int nos_expandidos;
-    int sucesso;
-} ResultData;
-
-ResultData a_star(Labirinto *l, Celula inicio, Celula fim);
-ResultData breadth_first_search(Labirinto *l, Celula inicio, Celula fim);
-ResultData depth_first_search(Labirinto *l, Celula inicio, Celula fim);
-
-// algoritmo bobo de teste que tenta ir em linha reta do inicio ao fim
-// e retorna impossível se encontrar um obstáculo
-ResultData dummy_search(Labirinto *l, Celula inicio, Celula fim);
-
+
+#ifndef _ALGORITHMS_H_
+#define _ALGORITHMS_H_
+
+#include "labirinto.h"
+
+typedef struct celula
+{
+    int x;
+    int y;
+    double g, h;
+    struct celula *prev;
+} Celula;
+
+// como a busca terminou. Interrompida antes de encontrar um caminho, a busca
+// devolve sucesso = 0, o motivo em status e as estatisticas parciais
+// (nos_expandidos ate a interrupcao)
+typedef enum
+{
+    BUSCA_CONCLUIDA = 0,
+    BUSCA_TEMPO_ESGOTADO,
+    BUSCA_CANCELADA
+} StatusBusca;
+
+typedef struct
+{
+    Celula *caminho;
+    double custo_caminho;
+    int tamanho_caminho;
+    int nos_expandidos;
+    int sucesso;
+    StatusBusca status;
+} ResultData;
+
+// expansoes entre duas consultas ao ControleBusca
+#define BUSCA_INTERVALO_CONTROLE 256
+
+// permite interromper uma busca em andamento a partir de outra thread ou
+// por um prazo: as buscas que recebem um ControleBusca o consultam a cada
+// BUSCA_INTERVALO_CONTROLE expansoes
+typedef struct
+{
+    int cancelado;
+
+    // instante limite em segundos de CLOCK_MONOTONIC (0 para nao limitar)
+    double prazo;
+} ControleBusca;
+
+// controle sem cancelamento e com prazo de segundos a partir de agora
+// (segundos <= 0 para nao limitar o tempo)
+ControleBusca controle_criar(double segundos);
+void controle_cancelar(ControleBusca *controle);
+
+// 1 se o cancelamento foi pedido (controle pode ser NULL)
+int controle_cancelado(ControleBusca *controle);
+
+// BUSCA_CONCLUIDA enquanto a busca pode continuar, ou o motivo para parar
+StatusBusca controle_verificar(ControleBusca *controle);
+
+// estimativa admissivel do custo de c ate fim usada pelo A*
+typedef double (*Heuristica)(Celula *c, Celula *fim, void *contexto);
+
+// auxiliares compartilhados pelos modulos de busca
+ResultData _default_result();
+double _busca_agora();
+double _cell_distance(Celula *c1, Celula *c2);
+double _heuristica_euclidiana(Celula *c, Celula *fim, void *contexto);
+
+// deslocamentos (dx, dy) dos 8 vizinhos, no sentido horario a partir do norte
+extern int directions[8][2];
+
+ResultData a_star(Labirinto *l, Celula inicio, Celula fim);
+
+// A* com heuristica fornecida pelo chamador (a_star usa a distancia euclidiana)
+// e controle opcional (NULL para buscar sem prazo nem cancelamento)
+ResultData a_star_heuristica(Labirinto *l, Celula inicio, Celula fim, Heuristica heuristica, void *contexto, ControleBusca *controle);
+ResultData breadth_first_search(Labirinto *l, Celula inicio, Celula fim);
+ResultData depth_first_search(Labirinto *l, Celula inicio, Celula fim);
+
+// versoes interrompiveis das buscas acima
+ResultData a_star_controlado(Labirinto *l, Celula inicio, Celula fim, ControleBusca *controle);
+ResultData breadth_first_search_controlado(Labirinto *l, Celula inicio, Celula fim, ControleBusca *controle);
+ResultData depth_first_search_controlado(Labirinto *l, Celula inicio, Celula fim, ControleBusca *controle);
+
+// algoritmo bobo de teste que tenta ir em linha reta do inicio ao fim
+// e retorna impossível se encontrar um obstáculo
+ResultData dummy_search(Labirinto *l, Celula inicio, Celula fim);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,288 @@
+#include <math.h>
+#include <stdlib.h>
+#include "ara.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+// estados de uma celula no ARA*. g, h e prev so' valem depois de NOVA, entao
+// os vetores nao precisam ser preenchidos para o mapa inteiro
+#define ARA_NOVA 0
+#define ARA_VISTA 1
+#define ARA_ABERTA 2
+#define ARA_FECHADA 3
+#define ARA_INCONSISTENTE 4
+
+typedef struct
+{
+    Labirinto *l;
+    Celula fim;
+    ConfigARA config;
+
+    double *g;
+    double *h;
+    int *prev;
+    unsigned char *estado;
+
+    IndexHeap *abertos;
+
+    // celulas que melhoraram depois de fechadas na iteracao atual
+    int *incons;
+    int n_incons, cap_incons;
+
+    // celulas fechadas na iteracao atual, reabertas na seguinte sem
+    // percorrer o mapa
+    int *fechados;
+    int n_fechados, cap_fechados;
+
+    // motivo da interrupcao pelo orcamento ou pelo controle
+    StatusBusca status;
+} _BuscaARA;
+
+// inicializa a celula na primeira vez que a busca chega a ela
+void _ara_alcancar(_BuscaARA *b, int u)
+{
+    if (b->estado[u] != ARA_NOVA)
+        return;
+
+    Celula c = {0};
+    c.x = u % b->l->n_colunas;
+    c.y = u / b->l->n_colunas;
+
+    b->g[u] = INFINITY;
+    b->h[u] = b->config.heuristica(&c, &b->fim, b->config.contexto);
+    b->prev[u] = -1;
+    b->estado[u] = ARA_VISTA;
+}
+
+void _ara_adicionar(int **lista, int *n, int *cap, int u)
+{
+    if (*n >= *cap)
+    {
+        *cap = *cap ? 2 * *cap : 64;
+        *lista = (int *)realloc(*lista, *cap * sizeof(int));
+    }
+
+    (*lista)[(*n)++] = u;
+}
+
+StatusBusca _ara_verificar(_BuscaARA *b, double limite_tempo)
+{
+    if (limite_tempo > 0 && _busca_agora() > limite_tempo)
+        return BUSCA_TEMPO_ESGOTADO;
+
+    return controle_verificar(b->config.controle);
+}
+
+// expande ate o fim ter f minimo, somando as expansoes em *expandidos.
+// Retorna 0, ou -1 se a iteracao foi interrompida (motivo em b->status).
+int _ara_melhorar(_BuscaARA *b, double peso, int alvo, double limite_tempo, int *expandidos)
+{
+    int n_exp = 0;
+
+    while (!index_heap_empty(b->abertos) && index_heap_min_priority(b->abertos) < b->g[alvo] + peso * b->h[alvo])
+    {
+        if (n_exp % BUSCA_INTERVALO_CONTROLE == 0 && (b->status = _ara_verificar(b, limite_tempo)) != BUSCA_CONCLUIDA)
+            return -1;
+
+        int u = index_heap_pop(b->abertos);
+        b->estado[u] = ARA_FECHADA;
+        _ara_adicionar(&b->fechados, &b->n_fechados, &b->cap_fechados, u);
+        n_exp++;
+        (*expandidos)++;
+
+        int y = u / b->l->n_colunas, x = u % b->l->n_colunas;
+
+        for (int d = 0; d < 8; d++)
+        {
+            int ny = y + directions[d][1], nx = x + directions[d][0];
+
+            if (_labirinto_bloqueado(b->l, ny, nx))
+                continue;
+
+            int v = ny * b->l->n_colunas + nx;
+            _ara_alcancar(b, v);
+
+            double custo = b->g[u] + ((directions[d][0] && directions[d][1]) ? M_SQRT2 : 1.0);
+
+            if (custo >= b->g[v])
+                continue;
+
+            b->g[v] = custo;
+            b->prev[v] = u;
+
+            if (b->estado[v] == ARA_FECHADA)
+            {
+                // ja fechada nesta iteracao: fica para a proxima
+                _ara_adicionar(&b->incons, &b->n_incons, &b->cap_incons, v);
+                b->estado[v] = ARA_INCONSISTENTE;
+            }
+            else if (b->estado[v] != ARA_INCONSISTENTE)
+            {
+                if (isinf(b->h[v]))
+                    continue;
+
+                b->estado[v] = ARA_ABERTA;
+                index_heap_push(b->abertos, v, custo + peso * b->h[v]);
+            }
+        }
+    }
+
+    return 0;
+}
+
+ConfigARA ara_config_padrao(double orcamento)
+{
+    ConfigARA config;
+    config.peso_inicial = ARA_PESO_INICIAL;
+    config.decremento = ARA_DECREMENTO;
+    config.orcamento = orcamento;
+    config.heuristica = NULL;
+    config.contexto = NULL;
+    config.controle = NULL;
+    return config;
+}
+
+ResultData _ara_caminho(_BuscaARA *b, int alvo, int expandidos)
+{
+    ResultData result = _default_result();
+    result.nos_expandidos = expandidos;
+
+    int tamanho = 0;
+    for (int v = alvo; v >= 0; v = b->prev[v])
+        tamanho++;
+
+    result.caminho = (Celula *)calloc(tamanho, sizeof(Celula));
+    result.tamanho_caminho = tamanho;
+    result.sucesso = 1;
+
+    int i = tamanho;
+    for (int v = alvo; v >= 0; v = b->prev[v])
+    {
+        i--;
+        result.caminho[i].x = v % b->l->n_colunas;
+        result.caminho[i].y = v / b->l->n_colunas;
+    }
+
+    for (i = 1; i < tamanho; i++)
+        result.custo_caminho += _cell_distance(&result.caminho[i - 1], &result.caminho[i]);
+
+    return result;
+}
+
+ResultData ara_star(Labirinto *l, Celula inicio, Celula fim, ConfigARA config, double *subotimalidade)
+{
+    ResultData result = _default_result();
+
+    if (subotimalidade)
+        *subotimalidade = INFINITY;
+
+    if (!_labirinto_livre(l, inicio.y, inicio.x) || !_labirinto_livre(l, fim.y, fim.x))
+        return result;
+
+    if (config.heuristica == NULL)
+        config.heuristica = _heuristica_euclidiana;
+    if (config.peso_inicial < 1)
+        config.peso_inicial = 1;
+    if (config.decremento <= 0)
+        config.decremento = ARA_DECREMENTO;
+
+    double limite_tempo = config.orcamento > 0 ? _busca_agora() + config.orcamento : 0;
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+
+    _BuscaARA b = {0};
+    b.l = l;
+    b.fim = fim;
+    b.config = config;
+    b.g = (double *)malloc(n * sizeof(double));
+    b.h = (double *)malloc(n * sizeof(double));
+    b.prev = (int *)malloc(n * sizeof(int));
+    b.estado = (unsigned char *)calloc(n, sizeof(unsigned char));
+    b.abertos = index_heap_construct(n);
+
+    int origem = inicio.y * l->n_colunas + inicio.x;
+    int alvo = fim.y * l->n_colunas + fim.x;
+    double peso = config.peso_inicial;
+    int expandidos = 0;
+
+    _ara_alcancar(&b, origem);
+    _ara_alcancar(&b, alvo);
+
+    b.g[origem] = 0;
+    b.estado[origem] = ARA_ABERTA;
+    index_heap_push(b.abertos, origem, peso * b.h[origem]);
+
+    while (1)
+    {
+        if (_ara_melhorar(&b, peso, alvo, limite_tempo, &expandidos) < 0)
+            break;
+
+        if (b.g[alvo] == INFINITY)
+            break;
+
+        if (result.caminho)
+            free(result.caminho);
+
+        result = _ara_caminho(&b, alvo, expandidos);
+
+        // limite de subotimalidade: g(fim) dividido pelo menor g + h entre
+        // abertos e inconsistentes, que e' um limite inferior do custo otimo
+        double inferior = b.g[alvo];
+        for (int k = 0; k < index_heap_size(b.abertos); k++)
+        {
+            int u = index_heap_at(b.abertos, k);
+            if (b.g[u] + b.h[u] < inferior)
+                inferior = b.g[u] + b.h[u];
+        }
+        for (int k = 0; k < b.n_incons; k++)
+            if (b.g[b.incons[k]] + b.h[b.incons[k]] < inferior)
+                inferior = b.g[b.incons[k]] + b.h[b.incons[k]];
+
+        double limite = peso;
+        if (inferior > 0 && b.g[alvo] / inferior < limite)
+            limite = b.g[alvo] / inferior;
+        if (limite < 1)
+            limite = 1;
+
+        if (subotimalidade)
+            *subotimalidade = limite;
+
+        if (limite <= 1 || peso <= 1 || _ara_verificar(&b, limite_tempo) != BUSCA_CONCLUIDA)
+            break;
+
+        // proxima iteracao: peso menor. Abertos e inconsistentes voltam ao
+        // heap com a prioridade do novo peso, e os fechados desta iteracao
+        // podem ser abertos de novo
+        peso = peso - config.decremento < 1 ? 1 : peso - config.decremento;
+
+        for (int k = 0; k < index_heap_size(b.abertos); k++)
+            _ara_adicionar(&b.incons, &b.n_incons, &b.cap_incons, index_heap_at(b.abertos, k));
+        index_heap_clear(b.abertos);
+
+        for (int k = 0; k < b.n_incons; k++)
+        {
+            b.estado[b.incons[k]] = ARA_ABERTA;
+            index_heap_push(b.abertos, b.incons[k], b.g[b.incons[k]] + peso * b.h[b.incons[k]]);
+        }
+        b.n_incons = 0;
+
+        for (int k = 0; k < b.n_fechados; k++)
+            if (b.estado[b.fechados[k]] == ARA_FECHADA)
+                b.estado[b.fechados[k]] = ARA_VISTA;
+        b.n_fechados = 0;
+    }
+
+    // interrompida antes do primeiro caminho: devolve so' as estatisticas
+    if (!result.sucesso)
+        result.status = b.status;
+    result.nos_expandidos = expandidos;
+
+    free(b.g);
+    free(b.h);
+    free(b.prev);
+    free(b.estado);
+    free(b.incons);
+    free(b.fechados);
+    index_heap_destroy(b.abertos);
+
+    return result;
+}
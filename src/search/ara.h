@@ -0,0 +1,40 @@
+
+#ifndef _ARA_H_
+#define _ARA_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+#define ARA_PESO_INICIAL 3.0
+#define ARA_DECREMENTO 0.5
+
+// A* anytime (ARA*): encontra rapidamente um primeiro caminho com a
+// heuristica inflada por um peso e depois vai reduzindo o peso, reaproveitando
+// a busca anterior, enquanto houver tempo. Cada solucao tem custo no maximo
+// subotimalidade vezes o otimo.
+typedef struct
+{
+    // peso inicial (>= 1) e quanto subtrair a cada refinamento
+    double peso_inicial;
+    double decremento;
+
+    // tempo maximo em segundos (<= 0 para refinar ate o otimo)
+    double orcamento;
+
+    // heuristica admissivel a inflar (NULL usa a distancia euclidiana)
+    Heuristica heuristica;
+    void *contexto;
+
+    // opcional: cancelamento e prazo, que param a busca como o orcamento
+    ControleBusca *controle;
+} ConfigARA;
+
+ConfigARA ara_config_padrao(double orcamento);
+
+// devolve o melhor caminho encontrado dentro do orcamento. Em *subotimalidade
+// (se nao for NULL) vem o limite alcancado: 1.0 quando o caminho e' otimo.
+// Nao marca celulas no labirinto. Interrompida antes do primeiro caminho,
+// devolve sucesso = 0 com o status da interrupcao.
+ResultData ara_star(Labirinto *l, Celula inicio, Celula fim, ConfigARA config, double *subotimalidade);
+
+#endif
@@ -0,0 +1,199 @@
+#include <stdlib.h>
+#include "bfs_bits.h"
+#include "labirinto_interno.h"
+
+typedef struct
+{
+    const uint64_t *obstaculos;
+    int palavras;
+    int n_linhas;
+
+    uint64_t *visitadas;
+    uint64_t *fronteira;
+    uint64_t *proxima;
+
+    // indices das palavras nao nulas de fronteira e de proxima
+    int *lista;
+    int n_lista;
+    int *lista_proxima;
+    int n_lista_proxima;
+} _BuscaBits;
+
+static inline void _bfs_bits_adicionar(_BuscaBits *b, int j, uint64_t bits)
+{
+    uint64_t novos = bits & ~b->obstaculos[j] & ~b->visitadas[j];
+
+    if (!novos)
+        return;
+
+    if (!b->proxima[j])
+        b->lista_proxima[b->n_lista_proxima++] = j;
+
+    b->proxima[j] |= novos;
+}
+
+// cada palavra da fronteira espalha os seus bits para as 9 palavras vizinhas
+void _bfs_bits_top_down(_BuscaBits *b)
+{
+    int W = b->palavras;
+
+    for (int i = 0; i < b->n_lista; i++)
+    {
+        int j = b->lista[i];
+        int w = j % W;
+        uint64_t f = b->fronteira[j];
+
+        uint64_t centro = f | (f << 1) | (f >> 1);
+        uint64_t esquerda = f << 63;
+        uint64_t direita = f >> 63;
+
+        // as linhas de borda existem no mapa de bits e sao todas bloqueadas
+        for (int k = j - W; k <= j + W; k += W)
+        {
+            _bfs_bits_adicionar(b, k, centro);
+            if (w > 0 && esquerda)
+                _bfs_bits_adicionar(b, k - 1, esquerda);
+            if (w < W - 1 && direita)
+                _bfs_bits_adicionar(b, k + 1, direita);
+        }
+    }
+}
+
+// cada palavra com celulas livres nao visitadas procura vizinhos na fronteira
+void _bfs_bits_bottom_up(_BuscaBits *b)
+{
+    int W = b->palavras;
+
+    for (int r = 1; r <= b->n_linhas; r++)
+    {
+        const uint64_t *cima = b->fronteira + (size_t)(r - 1) * W;
+        const uint64_t *meio = cima + W;
+        const uint64_t *baixo = meio + W;
+
+        uint64_t anterior = 0;
+        uint64_t atual = cima[0] | meio[0] | baixo[0];
+
+        for (int w = 0; w < W; w++)
+        {
+            uint64_t seguinte = w < W - 1 ? cima[w + 1] | meio[w + 1] | baixo[w + 1] : 0;
+            int j = r * W + w;
+            uint64_t livres = ~b->obstaculos[j] & ~b->visitadas[j];
+
+            if (livres)
+            {
+                uint64_t vizinhos = atual | (atual << 1) | (atual >> 1) | (anterior >> 63) | (seguinte << 63);
+                uint64_t novos = vizinhos & livres;
+
+                if (novos)
+                {
+                    b->proxima[j] = novos;
+                    b->lista_proxima[b->n_lista_proxima++] = j;
+                }
+            }
+
+            anterior = atual;
+            atual = seguinte;
+        }
+    }
+}
+
+Alcance bfs_bits(Labirinto *l, Celula inicio, Celula fim)
+{
+    Alcance a = {0};
+    a.saltos = -1;
+
+    if (!_labirinto_livre(l, inicio.y, inicio.x))
+        return a;
+
+    int tem_fim = _labirinto_dentro(l, fim.y, fim.x);
+
+    if (tem_fim && _labirinto_bloqueado(l, fim.y, fim.x))
+        return a;
+
+    _BuscaBits b;
+    b.obstaculos = l->obstaculos;
+    b.palavras = l->palavras_por_linha;
+    b.n_linhas = l->n_linhas;
+
+    size_t total = (size_t)(l->n_linhas + 2) * b.palavras;
+    b.visitadas = (uint64_t *)calloc(total, sizeof(uint64_t));
+    b.fronteira = (uint64_t *)calloc(total, sizeof(uint64_t));
+    b.proxima = (uint64_t *)calloc(total, sizeof(uint64_t));
+    b.lista = (int *)malloc(total * sizeof(int));
+    b.lista_proxima = (int *)malloc(total * sizeof(int));
+
+    int j_fim = 0;
+    uint64_t bit_fim = 0;
+    if (tem_fim)
+    {
+        j_fim = (fim.y + 1) * b.palavras + ((fim.x + 1) >> 6);
+        bit_fim = 1ULL << ((fim.x + 1) & 63);
+    }
+
+    int j = (inicio.y + 1) * b.palavras + ((inicio.x + 1) >> 6);
+    b.fronteira[j] = b.visitadas[j] = 1ULL << ((inicio.x + 1) & 63);
+    b.lista[0] = j;
+    b.n_lista = 1;
+    a.visitadas = 1;
+
+    long palavras_mapa = (long)l->n_linhas * b.palavras;
+
+    int nivel;
+    for (nivel = 0; b.n_lista > 0; nivel++)
+    {
+        if (tem_fim && (b.visitadas[j_fim] & bit_fim))
+        {
+            a.alcancavel = 1;
+            a.saltos = nivel;
+            break;
+        }
+
+        b.n_lista_proxima = 0;
+
+        if ((long)b.n_lista * BFS_BITS_ALFA > palavras_mapa)
+        {
+            _bfs_bits_bottom_up(&b);
+            a.niveis_bottom_up++;
+        }
+        else
+        {
+            _bfs_bits_top_down(&b);
+            a.niveis_top_down++;
+        }
+
+        for (int i = 0; i < b.n_lista; i++)
+            b.fronteira[b.lista[i]] = 0;
+
+        for (int i = 0; i < b.n_lista_proxima; i++)
+        {
+            int k = b.lista_proxima[i];
+            b.visitadas[k] |= b.proxima[k];
+            a.visitadas += __builtin_popcountll(b.proxima[k]);
+        }
+
+        // a proxima fronteira passa a ser a atual
+        uint64_t *aux = b.fronteira;
+        b.fronteira = b.proxima;
+        b.proxima = aux;
+
+        int *aux_lista = b.lista;
+        b.lista = b.lista_proxima;
+        b.lista_proxima = aux_lista;
+        b.n_lista = b.n_lista_proxima;
+    }
+
+    // sem fim, o ultimo nivel nao vazio e' a celula mais distante
+    if (!tem_fim)
+    {
+        a.alcancavel = 1;
+        a.saltos = nivel - 1;
+    }
+
+    free(b.visitadas);
+    free(b.fronteira);
+    free(b.proxima);
+    free(b.lista);
+    free(b.lista_proxima);
+
+    return a;
+}
@@ -0,0 +1,38 @@
+#ifndef _BFS_BITS_H_
+#define _BFS_BITS_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// a partir de quantas palavras de fronteira para cada BFS_BITS_ALFA palavras
+// do mapa o passo passa de top-down para bottom-up
+#define BFS_BITS_ALFA 4
+
+typedef struct
+{
+    int alcancavel;
+
+    // numero de movimentos (8 vizinhos, todos com peso 1) de inicio a fim, ou
+    // -1 se o fim nao e' alcancavel. Sem fim, a maior distancia alcancada.
+    int saltos;
+
+    // celulas alcancadas ate a busca parar, contando o inicio
+    long visitadas;
+
+    // quantos niveis foram expandidos em cada modo
+    int niveis_top_down;
+    int niveis_bottom_up;
+} Alcance;
+
+/**
+ * @brief BFS sem pesos com a fronteira em um mapa de bits no formato do mapa
+ * de obstaculos, expandindo 64 celulas por operacao com deslocamentos e
+ * mascaras. Cada nivel escolhe o modo conforme a densidade da fronteira:
+ * top-down percorre so as palavras da fronteira; bottom-up percorre todas as
+ * palavras ainda nao visitadas procurando vizinhos na fronteira.
+ * Com fim fora do mapa, percorre toda a componente do inicio.
+ * Nao marca celulas no labirinto.
+ */
+Alcance bfs_bits(Labirinto *l, Celula inicio, Celula fim);
+
+#endif
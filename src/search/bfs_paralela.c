@@ -0,0 +1,265 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "bfs_paralela.h"
+#include "dijkstra.h"
+#include "labirinto_interno.h"
+
+// direcao gravada na origem, que nao tem pai
+#define BFS_PARALELA_ORIGEM 8
+
+typedef struct
+{
+    int *celulas;
+    int n, capacidade;
+} _ListaLocal;
+
+typedef struct
+{
+    Labirinto *l;
+    int n_threads;
+    int alvo;
+
+    // direcao do pai de cada celula (DIRECAO_NENHUMA se nao visitada)
+    unsigned char *dir;
+
+    // fronteira atual (listas locais do nivel anterior) e a proxima, uma
+    // lista por thread; inicio[t] e' a posicao global da lista t da fronteira
+    _ListaLocal *atual;
+    _ListaLocal *proxima;
+    long *inicio;
+    long tamanho;
+
+    long proximo_bloco;
+    int encontrado;
+    int terminar;
+
+    pthread_barrier_t barreira;
+} _BuscaParalela;
+
+typedef struct
+{
+    _BuscaParalela *b;
+    int id;
+} _TarefaParalela;
+
+void _bfs_paralela_adicionar(_ListaLocal *lista, int celula)
+{
+    if (lista->n == lista->capacidade)
+    {
+        lista->capacidade = lista->capacidade ? 2 * lista->capacidade : BFS_PARALELA_BLOCO;
+        lista->celulas = (int *)realloc(lista->celulas, lista->capacidade * sizeof(int));
+    }
+
+    lista->celulas[lista->n++] = celula;
+}
+
+void _bfs_paralela_expandir(_BuscaParalela *b, int id)
+{
+    int n_colunas = b->l->n_colunas;
+    _ListaLocal *saida = &b->proxima[id];
+    saida->n = 0;
+
+    while (1)
+    {
+        long i = __atomic_fetch_add(&b->proximo_bloco, BFS_PARALELA_BLOCO, __ATOMIC_RELAXED);
+        if (i >= b->tamanho)
+            break;
+
+        long fim_bloco = i + BFS_PARALELA_BLOCO < b->tamanho ? i + BFS_PARALELA_BLOCO : b->tamanho;
+
+        // lista da fronteira que contem a posicao global i
+        int t = 0;
+        while (t + 1 < b->n_threads && b->inicio[t + 1] <= i)
+            t++;
+
+        for (; i < fim_bloco; i++)
+        {
+            while (i >= b->inicio[t] + b->atual[t].n)
+                t++;
+
+            int u = b->atual[t].celulas[i - b->inicio[t]];
+            int y = u / n_colunas, x = u % n_colunas;
+
+            for (int d = 0; d < 8; d++)
+            {
+                int ny = y + directions[d][1], nx = x + directions[d][0];
+
+                if (_labirinto_bloqueado(b->l, ny, nx))
+                    continue;
+
+                int v = ny * n_colunas + nx;
+                unsigned char esperado = DIRECAO_NENHUMA;
+
+                // leitura barata antes da troca atomica, que decide o dono
+                if (__atomic_load_n(&b->dir[v], __ATOMIC_RELAXED) != DIRECAO_NENHUMA ||
+                    !__atomic_compare_exchange_n(&b->dir[v], &esperado, (unsigned char)((d + 4) % 8), 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    continue;
+
+                _bfs_paralela_adicionar(saida, v);
+
+                if (v == b->alvo)
+                    __atomic_store_n(&b->encontrado, 1, __ATOMIC_RELAXED);
+            }
+        }
+    }
+}
+
+void *_bfs_paralela_trabalhar(void *arg)
+{
+    _TarefaParalela *tarefa = (_TarefaParalela *)arg;
+    _BuscaParalela *b = tarefa->b;
+
+    while (1)
+    {
+        pthread_barrier_wait(&b->barreira);
+        if (b->terminar)
+            break;
+
+        _bfs_paralela_expandir(b, tarefa->id);
+        pthread_barrier_wait(&b->barreira);
+    }
+
+    return NULL;
+}
+
+ResultData bfs_paralela(Labirinto *l, Celula inicio, Celula fim, int n_threads, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+
+    if (!_labirinto_livre(l, inicio.y, inicio.x))
+        return result;
+
+    if (n_threads <= 0)
+        n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n_threads < 1)
+        n_threads = 1;
+
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+
+    _BuscaParalela b;
+    memset(&b, 0, sizeof(b));
+    b.l = l;
+    b.n_threads = n_threads;
+    b.alvo = -1;
+    if (_labirinto_dentro(l, fim.y, fim.x))
+        b.alvo = fim.y * l->n_colunas + fim.x;
+
+    b.dir = (unsigned char *)malloc(n);
+    memset(b.dir, DIRECAO_NENHUMA, n);
+    b.atual = (_ListaLocal *)calloc(n_threads, sizeof(_ListaLocal));
+    b.proxima = (_ListaLocal *)calloc(n_threads, sizeof(_ListaLocal));
+    b.inicio = (long *)calloc(n_threads + 1, sizeof(long));
+
+    int origem = inicio.y * l->n_colunas + inicio.x;
+    b.dir[origem] = BFS_PARALELA_ORIGEM;
+    _bfs_paralela_adicionar(&b.atual[0], origem);
+    b.tamanho = 1;
+    for (int t = 1; t <= n_threads; t++)
+        b.inicio[t] = 1;
+    b.encontrado = origem == b.alvo;
+
+    pthread_barrier_init(&b.barreira, NULL, n_threads);
+    pthread_t *threads = (pthread_t *)malloc(n_threads * sizeof(pthread_t));
+    _TarefaParalela *tarefas = (_TarefaParalela *)malloc(n_threads * sizeof(_TarefaParalela));
+
+    for (int t = 0; t < n_threads; t++)
+    {
+        tarefas[t].b = &b;
+        tarefas[t].id = t;
+
+        if (t > 0)
+            pthread_create(&threads[t], NULL, _bfs_paralela_trabalhar, &tarefas[t]);
+    }
+
+    long expandidos = 0;
+
+    // a thread principal e' a thread 0 e prepara cada nivel entre as barreiras
+    while (1)
+    {
+        // o controle e' consultado a cada nivel, com as threads paradas
+        if (b.encontrado || b.tamanho == 0 || (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+        {
+            b.terminar = 1;
+            pthread_barrier_wait(&b.barreira);
+            break;
+        }
+
+        expandidos += b.tamanho;
+        b.proximo_bloco = 0;
+
+        pthread_barrier_wait(&b.barreira);
+        _bfs_paralela_expandir(&b, 0);
+        pthread_barrier_wait(&b.barreira);
+
+        // as listas novas viram a fronteira; as antigas sao reaproveitadas
+        _ListaLocal *aux = b.atual;
+        b.atual = b.proxima;
+        b.proxima = aux;
+
+        b.tamanho = 0;
+        for (int t = 0; t < n_threads; t++)
+        {
+            b.inicio[t] = b.tamanho;
+            b.tamanho += b.atual[t].n;
+        }
+        b.inicio[n_threads] = b.tamanho;
+    }
+
+    for (int t = 1; t < n_threads; t++)
+        pthread_join(threads[t], NULL);
+
+    if (b.encontrado)
+    {
+        // o fim esta na fronteira recem-montada (ou e' a origem): contam as
+        // celulas que uma fila nessa ordem retiraria ate ele, inclusive
+        long posicao = 0;
+        for (int t = 0; t < n_threads; t++)
+            for (int k = 0; k < b.atual[t].n; k++)
+                if (b.atual[t].celulas[k] == b.alvo)
+                    posicao = b.inicio[t] + k;
+
+        result.nos_expandidos = expandidos + posicao + 1;
+
+        int tamanho = 1;
+        for (int v = b.alvo; b.dir[v] != BFS_PARALELA_ORIGEM; tamanho++)
+            v += directions[b.dir[v]][1] * l->n_colunas + directions[b.dir[v]][0];
+
+        result.caminho = (Celula *)calloc(tamanho, sizeof(Celula));
+        result.tamanho_caminho = tamanho;
+        result.sucesso = 1;
+
+        int v = b.alvo;
+        for (int i = tamanho - 1; i >= 0; i--)
+        {
+            result.caminho[i].x = v % l->n_colunas;
+            result.caminho[i].y = v / l->n_colunas;
+
+            if (b.dir[v] != BFS_PARALELA_ORIGEM)
+                v += directions[b.dir[v]][1] * l->n_colunas + directions[b.dir[v]][0];
+        }
+
+        for (int i = 1; i < tamanho; i++)
+            result.custo_caminho += _cell_distance(&result.caminho[i - 1], &result.caminho[i]);
+    }
+    else
+        result.nos_expandidos = expandidos;
+
+    pthread_barrier_destroy(&b.barreira);
+
+    for (int t = 0; t < n_threads; t++)
+    {
+        free(b.atual[t].celulas);
+        free(b.proxima[t].celulas);
+    }
+
+    free(b.atual);
+    free(b.proxima);
+    free(b.inicio);
+    free(b.dir);
+    free(threads);
+    free(tarefas);
+
+    return result;
+}
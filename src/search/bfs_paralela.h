@@ -0,0 +1,25 @@
+#ifndef _BFS_PARALELA_H_
+#define _BFS_PARALELA_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// celulas da fronteira que uma thread pega de cada vez
+#define BFS_PARALELA_BLOCO 1024
+
+/**
+ * @brief BFS de 8 vizinhos sincronizada por nivel: a fronteira de cada nivel
+ * e' dividida entre n_threads threads (<= 0 usa o numero de processadores),
+ * cada uma com a sua fronteira local, e a celula e' reivindicada por quem
+ * gravar primeiro a direcao do seu pai com uma operacao atomica.
+ * O caminho tem o menor numero de movimentos, como em breadth_first_search.
+ * nos_expandidos conta as celulas retiradas da fronteira ate o fim,
+ * inclusive: todas as dos niveis anteriores e as do nivel do fim que ficaram
+ * antes dele na fronteira. Essa ordem depende de qual thread reivindica cada
+ * celula, entao a contagem pode variar um pouco entre execucoes.
+ * controle (opcional) e' consultado entre um nivel e outro.
+ * Nao marca celulas no labirinto.
+ */
+ResultData bfs_paralela(Labirinto *l, Celula inicio, Celula fim, int n_threads, ControleBusca *controle);
+
+#endif
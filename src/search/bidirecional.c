@@ -0,0 +1,155 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bidirecional.h"
+#include "dijkstra.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+typedef struct
+{
+    double *dist;
+    unsigned char *dir;
+    unsigned char *fechado;
+    IndexHeap *heap;
+} _LadoBusca;
+
+void _bidirecional_lado(_LadoBusca *lado, size_t n, int origem)
+{
+    lado->dist = (double *)malloc(n * sizeof(double));
+    lado->dir = (unsigned char *)malloc(n * sizeof(unsigned char));
+    lado->fechado = (unsigned char *)calloc(n, sizeof(unsigned char));
+    lado->heap = index_heap_construct(n);
+
+    for (size_t i = 0; i < n; i++)
+        lado->dist[i] = INFINITY;
+    memset(lado->dir, DIRECAO_NENHUMA, n);
+
+    lado->dist[origem] = 0;
+    index_heap_push(lado->heap, origem, 0);
+}
+
+void _bidirecional_liberar(_LadoBusca *lado)
+{
+    free(lado->dist);
+    free(lado->dir);
+    free(lado->fechado);
+    index_heap_destroy(lado->heap);
+}
+
+// expande o topo do lado; atualiza o melhor encontro com o outro lado
+void _bidirecional_expandir(Labirinto *l, _LadoBusca *lado, _LadoBusca *outro, double *melhor, int *encontro)
+{
+    int u = index_heap_pop(lado->heap);
+    lado->fechado[u] = 1;
+
+    int y = u / l->n_colunas, x = u % l->n_colunas;
+
+    for (int d = 0; d < 8; d++)
+    {
+        int ny = y + directions[d][1], nx = x + directions[d][0];
+
+        if (_labirinto_bloqueado(l, ny, nx))
+            continue;
+
+        int v = ny * l->n_colunas + nx;
+
+        if (lado->fechado[v])
+            continue;
+
+        double custo = lado->dist[u] + ((directions[d][0] && directions[d][1]) ? M_SQRT2 : 1.0);
+
+        if (custo < lado->dist[v])
+        {
+            lado->dist[v] = custo;
+            lado->dir[v] = (d + 4) % 8;
+            index_heap_push(lado->heap, v, custo);
+
+            if (custo + outro->dist[v] < *melhor)
+            {
+                *melhor = custo + outro->dist[v];
+                *encontro = v;
+            }
+        }
+    }
+}
+
+ResultData busca_bidirecional(Labirinto *l, Celula inicio, Celula fim, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+
+    if (!_labirinto_livre(l, inicio.y, inicio.x) || !_labirinto_livre(l, fim.y, fim.x))
+        return result;
+
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+    int origem = inicio.y * l->n_colunas + inicio.x;
+    int alvo = fim.y * l->n_colunas + fim.x;
+
+    _LadoBusca frente, tras;
+    _bidirecional_lado(&frente, n, origem);
+    _bidirecional_lado(&tras, n, alvo);
+
+    double melhor = origem == alvo ? 0 : INFINITY;
+    int encontro = origem;
+
+    while (!index_heap_empty(frente.heap) && !index_heap_empty(tras.heap))
+    {
+        if (result.nos_expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        double topo_frente = index_heap_min_priority(frente.heap);
+        double topo_tras = index_heap_min_priority(tras.heap);
+
+        // nenhum caminho ainda nao visto pode ser melhor que o encontro
+        if (topo_frente + topo_tras >= melhor)
+            break;
+
+        if (topo_frente <= topo_tras)
+            _bidirecional_expandir(l, &frente, &tras, &melhor, &encontro);
+        else
+            _bidirecional_expandir(l, &tras, &frente, &melhor, &encontro);
+
+        result.nos_expandidos++;
+    }
+
+    // interrompida antes de provar o caminho, a busca nao devolve nada
+    if (melhor < INFINITY && result.status == BUSCA_CONCLUIDA)
+    {
+        int antes = 0, depois = 0;
+
+        for (int v = encontro; frente.dir[v] != DIRECAO_NENHUMA; antes++)
+            v += directions[frente.dir[v]][1] * l->n_colunas + directions[frente.dir[v]][0];
+        for (int v = encontro; tras.dir[v] != DIRECAO_NENHUMA; depois++)
+            v += directions[tras.dir[v]][1] * l->n_colunas + directions[tras.dir[v]][0];
+
+        result.tamanho_caminho = antes + 1 + depois;
+        result.caminho = (Celula *)calloc(result.tamanho_caminho, sizeof(Celula));
+        result.sucesso = 1;
+
+        // do encontro de volta ao inicio, depois do encontro ao fim
+        int v = encontro;
+        for (int i = antes; i >= 0; i--)
+        {
+            result.caminho[i].x = v % l->n_colunas;
+            result.caminho[i].y = v / l->n_colunas;
+            if (i > 0)
+                v += directions[frente.dir[v]][1] * l->n_colunas + directions[frente.dir[v]][0];
+        }
+
+        v = encontro;
+        for (int i = antes + 1; i < result.tamanho_caminho; i++)
+        {
+            v += directions[tras.dir[v]][1] * l->n_colunas + directions[tras.dir[v]][0];
+            result.caminho[i].x = v % l->n_colunas;
+            result.caminho[i].y = v / l->n_colunas;
+        }
+
+        for (int i = 1; i < result.tamanho_caminho; i++)
+            result.custo_caminho += _cell_distance(&result.caminho[i - 1], &result.caminho[i]);
+    }
+
+    _bidirecional_liberar(&frente);
+    _bidirecional_liberar(&tras);
+
+    return result;
+}
@@ -0,0 +1,16 @@
+#ifndef _BIDIRECIONAL_H_
+#define _BIDIRECIONAL_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// Dijkstra bidirecional: uma busca a partir do inicio e outra a partir do
+// fim, alternando pelo lado com a menor distancia no topo, ate que a soma
+// dos dois topos alcance o melhor caminho ja visto no encontro das buscas.
+// Se um dos lados esgota a sua componente, o fim e' inalcancavel, o que
+// encerra cedo consultas entre regioes desconexas pequenas.
+// controle e' opcional. Nao marca celulas no labirinto.
+// Interrompida, devolve sucesso = 0 com o status da interrupcao.
+ResultData busca_bidirecional(Labirinto *l, Celula inicio, Celula fim, ControleBusca *controle);
+
+#endif
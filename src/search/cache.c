@@ -0,0 +1,419 @@
+#include <stdlib.h>
+#include "cache.h"
+#include "labirinto_interno.h"
+
+typedef struct
+{
+    // chave
+    uint64_t labirinto;
+    uint64_t algoritmo;
+    int inicio_x, inicio_y, fim_x, fim_y;
+
+    // resultado: celula inicial do caminho e direcoes de 4 bits por passo
+    double custo_caminho;
+    int tamanho_caminho;
+    int nos_expandidos;
+    int sucesso;
+    int otimo;
+    int origem_x, origem_y;
+    unsigned char *passos;
+
+    // lista LRU (mais recente na cabeca) e encadeamento do balde
+    int anterior, proximo;
+    int seguinte;
+    int usada;
+
+    // muda a cada reuso da entrada, invalidando o indice de subcaminhos
+    unsigned int geracao;
+} _EntradaCache;
+
+typedef struct
+{
+    uint64_t labirinto;
+    uint64_t algoritmo;
+    int x, y;
+    int entrada;
+    unsigned int geracao;
+    int posicao;
+} _IndiceCelula;
+
+struct CacheResultados
+{
+    _EntradaCache *entradas;
+    int capacidade, n_usadas;
+    int cabeca, cauda;
+
+    int *baldes;
+    int mascara_baldes;
+
+    _IndiceCelula *indice;
+    int mascara_indice;
+
+    EstatisticasCache estatisticas;
+};
+
+int _cache_potencia_2(int n)
+{
+    int p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+uint64_t _cache_misturar(uint64_t x)
+{
+    x = (x ^ (x >> 33)) * 0xff51afd7ed558ccdULL;
+    x = (x ^ (x >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+    return x ^ (x >> 33);
+}
+
+// FNV-1a do nome do algoritmo
+uint64_t _cache_hash_nome(const char *nome)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (; *nome; nome++)
+        h = (h ^ (unsigned char)*nome) * 0x100000001b3ULL;
+    return h;
+}
+
+// o nome mais os custos da tabela, para que resultados com tabelas
+// diferentes nao se confundam
+uint64_t _cache_hash_terreno(const char *nome, TabelaTerreno *terreno)
+{
+    uint64_t h = _cache_hash_nome(nome);
+    const unsigned char *bytes = (const unsigned char *)terreno->custo;
+
+    for (size_t i = 0; i < sizeof(terreno->custo); i++)
+        h = (h ^ bytes[i]) * 0x100000001b3ULL;
+
+    return h;
+}
+
+int _cache_balde(CacheResultados *c, uint64_t labirinto, uint64_t algoritmo, Celula inicio, Celula fim)
+{
+    uint64_t h = labirinto ^ _cache_misturar(algoritmo);
+    h = _cache_misturar(h ^ ((uint64_t)(uint32_t)inicio.x << 32 | (uint32_t)inicio.y));
+    h = _cache_misturar(h ^ ((uint64_t)(uint32_t)fim.x << 32 | (uint32_t)fim.y));
+    return (int)(h & c->mascara_baldes);
+}
+
+int _cache_posicao_indice(CacheResultados *c, uint64_t labirinto, uint64_t algoritmo, int x, int y)
+{
+    uint64_t h = _cache_misturar(labirinto ^ _cache_misturar(algoritmo ^ ((uint64_t)(uint32_t)x << 32 | (uint32_t)y)));
+    return (int)(h & c->mascara_indice);
+}
+
+int _cache_direcao(int dx, int dy)
+{
+    for (int d = 0; d < 8; d++)
+        if (directions[d][0] == dx && directions[d][1] == dy)
+            return d;
+
+    return -1;
+}
+
+CacheResultados *cache_resultados_criar(int capacidade)
+{
+    if (capacidade <= 0)
+        capacidade = CACHE_CAPACIDADE_PADRAO;
+
+    CacheResultados *c = (CacheResultados *)calloc(1, sizeof(CacheResultados));
+    c->capacidade = capacidade;
+    c->entradas = (_EntradaCache *)calloc(capacidade, sizeof(_EntradaCache));
+    c->cabeca = c->cauda = -1;
+
+    c->mascara_baldes = _cache_potencia_2(2 * capacidade) - 1;
+    c->baldes = (int *)malloc((c->mascara_baldes + 1) * sizeof(int));
+    for (int i = 0; i <= c->mascara_baldes; i++)
+        c->baldes[i] = -1;
+
+    c->mascara_indice = _cache_potencia_2(capacidade * CACHE_CELULAS_POR_ENTRADA) - 1;
+    c->indice = (_IndiceCelula *)calloc(c->mascara_indice + 1, sizeof(_IndiceCelula));
+    for (int i = 0; i <= c->mascara_indice; i++)
+        c->indice[i].entrada = -1;
+
+    return c;
+}
+
+void _cache_desligar(CacheResultados *c, int i)
+{
+    _EntradaCache *e = &c->entradas[i];
+
+    if (e->anterior >= 0)
+        c->entradas[e->anterior].proximo = e->proximo;
+    else
+        c->cabeca = e->proximo;
+
+    if (e->proximo >= 0)
+        c->entradas[e->proximo].anterior = e->anterior;
+    else
+        c->cauda = e->anterior;
+}
+
+void _cache_para_cabeca(CacheResultados *c, int i)
+{
+    if (c->cabeca == i)
+        return;
+
+    _cache_desligar(c, i);
+
+    _EntradaCache *e = &c->entradas[i];
+    e->anterior = -1;
+    e->proximo = c->cabeca;
+    if (c->cabeca >= 0)
+        c->entradas[c->cabeca].anterior = i;
+    c->cabeca = i;
+    if (c->cauda < 0)
+        c->cauda = i;
+}
+
+int _cache_procurar(CacheResultados *c, uint64_t labirinto, uint64_t algoritmo, Celula inicio, Celula fim)
+{
+    for (int i = c->baldes[_cache_balde(c, labirinto, algoritmo, inicio, fim)]; i >= 0; i = c->entradas[i].seguinte)
+    {
+        _EntradaCache *e = &c->entradas[i];
+        if (e->labirinto == labirinto && e->algoritmo == algoritmo && e->inicio_x == inicio.x && e->inicio_y == inicio.y &&
+            e->fim_x == fim.x && e->fim_y == fim.y)
+            return i;
+    }
+
+    return -1;
+}
+
+// tira a entrada do seu balde e libera o caminho; continua na lista LRU
+void _cache_esvaziar(CacheResultados *c, int i)
+{
+    _EntradaCache *e = &c->entradas[i];
+    Celula inicio = {0}, fim = {0};
+    inicio.x = e->inicio_x;
+    inicio.y = e->inicio_y;
+    fim.x = e->fim_x;
+    fim.y = e->fim_y;
+
+    int *elo = &c->baldes[_cache_balde(c, e->labirinto, e->algoritmo, inicio, fim)];
+    while (*elo != i)
+        elo = &c->entradas[*elo].seguinte;
+    *elo = e->seguinte;
+
+    free(e->passos);
+    e->passos = NULL;
+    e->geracao++;
+}
+
+// celulas do caminho da entrada de primeiro a ultimo (inclusive), na ordem
+// dada; o custo e' somado como em _cell_distance ou, com uma tabela de
+// terreno, com os custos de passo dela sobre o terreno das celulas
+ResultData _cache_decodificar(_EntradaCache *e, Labirinto *l, TabelaTerreno *terreno, int primeiro, int ultimo)
+{
+    ResultData result = _default_result();
+    int passo = primeiro <= ultimo ? 1 : -1;
+
+    result.sucesso = 1;
+    result.tamanho_caminho = (ultimo - primeiro) * passo + 1;
+    result.caminho = (Celula *)calloc(result.tamanho_caminho, sizeof(Celula));
+
+    int menor = primeiro < ultimo ? primeiro : ultimo;
+    int maior = primeiro < ultimo ? ultimo : primeiro;
+    int x = e->origem_x, y = e->origem_y;
+
+    for (int p = 0; p <= maior; p++)
+    {
+        if (p > 0)
+        {
+            int d = (e->passos[(p - 1) >> 1] >> (((p - 1) & 1) * 4)) & 15;
+            x += directions[d][0];
+            y += directions[d][1];
+        }
+
+        if (p >= menor)
+        {
+            int i = (p - primeiro) * passo;
+            result.caminho[i].x = x;
+            result.caminho[i].y = y;
+        }
+    }
+
+    for (int i = 1; i < result.tamanho_caminho; i++)
+    {
+        Celula *a = &result.caminho[i - 1], *b = &result.caminho[i];
+
+        if (terreno)
+            result.custo_caminho += terreno_custo_passo(terreno, _labirinto_terreno(l, a->y, a->x), _labirinto_terreno(l, b->y, b->x), a->x != b->x && a->y != b->y);
+        else
+            result.custo_caminho += _cell_distance(a, b);
+
+        b->g = result.custo_caminho;
+    }
+
+    return result;
+}
+
+int _cache_buscar(CacheResultados *c, Labirinto *l, Celula inicio, Celula fim, uint64_t nome, TabelaTerreno *terreno, ResultData *result)
+{
+    uint64_t labirinto = labirinto_hash(l);
+
+    int i = _cache_procurar(c, labirinto, nome, inicio, fim);
+    if (i >= 0)
+    {
+        _EntradaCache *e = &c->entradas[i];
+
+        if (e->sucesso)
+        {
+            *result = _cache_decodificar(e, l, terreno, 0, e->tamanho_caminho - 1);
+            result->custo_caminho = e->custo_caminho;
+        }
+        else
+            *result = _default_result();
+
+        result->nos_expandidos = e->nos_expandidos;
+        _cache_para_cabeca(c, i);
+        c->estatisticas.acertos++;
+        return 1;
+    }
+
+    // as duas pontas em um mesmo caminho otimo guardado
+    _IndiceCelula *a = &c->indice[_cache_posicao_indice(c, labirinto, nome, inicio.x, inicio.y)];
+    _IndiceCelula *b = &c->indice[_cache_posicao_indice(c, labirinto, nome, fim.x, fim.y)];
+
+    if (a->entrada >= 0 && a->entrada == b->entrada && a->geracao == b->geracao &&
+        a->labirinto == labirinto && a->algoritmo == nome && a->x == inicio.x && a->y == inicio.y &&
+        b->labirinto == labirinto && b->algoritmo == nome && b->x == fim.x && b->y == fim.y)
+    {
+        _EntradaCache *e = &c->entradas[a->entrada];
+
+        if (e->usada && e->geracao == a->geracao)
+        {
+            *result = _cache_decodificar(e, l, terreno, a->posicao, b->posicao);
+            _cache_para_cabeca(c, a->entrada);
+            c->estatisticas.acertos_subcaminho++;
+            return 1;
+        }
+    }
+
+    c->estatisticas.faltas++;
+    return 0;
+}
+
+void _cache_guardar(CacheResultados *c, Labirinto *l, Celula inicio, Celula fim, uint64_t nome, ResultData *result, int otimo)
+{
+    if (result->status != BUSCA_CONCLUIDA)
+        return;
+
+    if (result->sucesso)
+    {
+        if (result->tamanho_caminho < 1)
+            return;
+        for (int p = 1; p < result->tamanho_caminho; p++)
+            if (_cache_direcao(result->caminho[p].x - result->caminho[p - 1].x, result->caminho[p].y - result->caminho[p - 1].y) < 0)
+                return;
+    }
+
+    uint64_t labirinto = labirinto_hash(l);
+
+    // reaproveita a entrada da mesma chave, uma livre ou a menos usada
+    int i = _cache_procurar(c, labirinto, nome, inicio, fim);
+    if (i >= 0)
+        _cache_esvaziar(c, i);
+    else if (c->n_usadas < c->capacidade)
+    {
+        i = c->n_usadas++;
+        _EntradaCache *e = &c->entradas[i];
+        e->usada = 1;
+        e->anterior = -1;
+        e->proximo = c->cabeca;
+        if (c->cabeca >= 0)
+            c->entradas[c->cabeca].anterior = i;
+        c->cabeca = i;
+        if (c->cauda < 0)
+            c->cauda = i;
+    }
+    else
+    {
+        i = c->cauda;
+        _cache_esvaziar(c, i);
+        c->estatisticas.descartes++;
+    }
+
+    _EntradaCache *e = &c->entradas[i];
+    e->labirinto = labirinto;
+    e->algoritmo = nome;
+    e->inicio_x = inicio.x;
+    e->inicio_y = inicio.y;
+    e->fim_x = fim.x;
+    e->fim_y = fim.y;
+    e->custo_caminho = result->custo_caminho;
+    e->tamanho_caminho = result->sucesso ? result->tamanho_caminho : 0;
+    e->nos_expandidos = result->nos_expandidos;
+    e->sucesso = result->sucesso;
+    e->otimo = otimo;
+
+    int *balde = &c->baldes[_cache_balde(c, labirinto, nome, inicio, fim)];
+    e->seguinte = *balde;
+    *balde = i;
+    _cache_para_cabeca(c, i);
+
+    if (!e->sucesso)
+        return;
+
+    e->origem_x = result->caminho[0].x;
+    e->origem_y = result->caminho[0].y;
+    e->passos = (unsigned char *)calloc(e->tamanho_caminho / 2 + 1, sizeof(unsigned char));
+
+    for (int p = 1; p < e->tamanho_caminho; p++)
+    {
+        int d = _cache_direcao(result->caminho[p].x - result->caminho[p - 1].x, result->caminho[p].y - result->caminho[p - 1].y);
+        e->passos[(p - 1) >> 1] |= d << (((p - 1) & 1) * 4);
+    }
+
+    if (!otimo)
+        return;
+
+    for (int p = 0; p < e->tamanho_caminho; p++)
+    {
+        int x = result->caminho[p].x, y = result->caminho[p].y;
+        _IndiceCelula *ic = &c->indice[_cache_posicao_indice(c, labirinto, nome, x, y)];
+        ic->labirinto = labirinto;
+        ic->algoritmo = nome;
+        ic->x = x;
+        ic->y = y;
+        ic->entrada = i;
+        ic->geracao = e->geracao;
+        ic->posicao = p;
+    }
+}
+
+int cache_resultados_buscar(CacheResultados *c, Labirinto *l, Celula inicio, Celula fim, const char *algoritmo, ResultData *result)
+{
+    return _cache_buscar(c, l, inicio, fim, _cache_hash_nome(algoritmo), NULL, result);
+}
+
+void cache_resultados_guardar(CacheResultados *c, Labirinto *l, Celula inicio, Celula fim, const char *algoritmo, ResultData *result, int otimo)
+{
+    _cache_guardar(c, l, inicio, fim, _cache_hash_nome(algoritmo), result, otimo);
+}
+
+int cache_resultados_buscar_terreno(CacheResultados *c, Labirinto *l, Celula inicio, Celula fim, const char *algoritmo, TabelaTerreno *terreno, ResultData *result)
+{
+    return _cache_buscar(c, l, inicio, fim, _cache_hash_terreno(algoritmo, terreno), terreno, result);
+}
+
+void cache_resultados_guardar_terreno(CacheResultados *c, Labirinto *l, Celula inicio, Celula fim, const char *algoritmo, TabelaTerreno *terreno, ResultData *result, int otimo)
+{
+    _cache_guardar(c, l, inicio, fim, _cache_hash_terreno(algoritmo, terreno), result, otimo);
+}
+
+EstatisticasCache cache_resultados_estatisticas(CacheResultados *c)
+{
+    return c->estatisticas;
+}
+
+void cache_resultados_destruir(CacheResultados *c)
+{
+    for (int i = 0; i < c->n_usadas; i++)
+        free(c->entradas[i].passos);
+
+    free(c->entradas);
+    free(c->baldes);
+    free(c->indice);
+    free(c);
+}
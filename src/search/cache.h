@@ -0,0 +1,60 @@
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+#include "terreno.h"
+
+#define CACHE_CAPACIDADE_PADRAO 1024
+
+// celulas do indice de subcaminhos por entrada da cache
+#define CACHE_CELULAS_POR_ENTRADA 64
+
+/**
+ * Cache LRU de resultados de busca, para trafego com consultas repetidas.
+ * A chave e' (labirinto_hash, inicio, fim, nome do algoritmo): alterar o
+ * conteudo de uma celula (OCUPADO, livre ou terreno) muda o hash, e as
+ * entradas do conteudo antigo deixam de ser encontradas e saem pela politica
+ * LRU. Os caminhos ficam
+ * codificados como a celula inicial mais uma direcao de 4 bits por passo.
+ *
+ * Caminhos guardados como otimos tambem respondem consultas entre duas das
+ * suas celulas, pois todo trecho de um caminho minimo e' minimo (e, com
+ * custos simetricos, o trecho ao contrario tambem). Um indice direto, que
+ * aceita colisoes, liga cada celula ao caminho mais recente que passa por ela.
+ *
+ * Nao e' thread-safe: quem compartilha a cache entre threads deve protege-la.
+ */
+typedef struct CacheResultados CacheResultados;
+
+typedef struct
+{
+    long acertos;
+    long acertos_subcaminho;
+    long faltas;
+    long descartes;
+} EstatisticasCache;
+
+CacheResultados *cache_resultados_criar(int capacidade);
+
+// 1 se a consulta foi respondida pela cache, com o resultado (e uma copia
+// do caminho, que passa a ser do chamador) em *result. nos_expandidos e' o
+// da busca original nos acertos exatos e 0 nos acertos de subcaminho.
+int cache_resultados_buscar(CacheResultados *c, Labirinto *l, Celula inicio, Celula fim, const char *algoritmo, ResultData *result);
+
+// guarda uma copia do resultado. otimo indica que o caminho e' minimo e
+// pode responder subcaminhos. Resultados interrompidos (status diferente de
+// BUSCA_CONCLUIDA) e caminhos com passos entre celulas nao vizinhas nao
+// sao guardados.
+void cache_resultados_guardar(CacheResultados *c, Labirinto *l, Celula inicio, Celula fim, const char *algoritmo, ResultData *result, int otimo);
+
+// as mesmas consultas para buscas de terreno: a chave inclui tambem os
+// custos da tabela, e o custo de um acerto de subcaminho e' somado com os
+// custos de passo dela
+int cache_resultados_buscar_terreno(CacheResultados *c, Labirinto *l, Celula inicio, Celula fim, const char *algoritmo, TabelaTerreno *terreno, ResultData *result);
+void cache_resultados_guardar_terreno(CacheResultados *c, Labirinto *l, Celula inicio, Celula fim, const char *algoritmo, TabelaTerreno *terreno, ResultData *result, int otimo);
+
+EstatisticasCache cache_resultados_estatisticas(CacheResultados *c);
+void cache_resultados_destruir(CacheResultados *c);
+
+#endif
@@ -0,0 +1,159 @@
+#include <math.h>
+#include <stdlib.h>
+#include "campo.h"
+#include "dijkstra.h"
+#include "labirinto_interno.h"
+#include "onda.h"
+
+// um campo interrompido pela metade teria custos que nao sao minimos
+void _campo_esvaziar(CampoDistancias *c)
+{
+    for (size_t v = 0; v < (size_t)c->n_linhas * c->n_colunas; v++)
+    {
+        c->custo[v] = INFINITY;
+        c->proximo[v] = DIRECAO_NENHUMA;
+    }
+}
+
+CampoDistancias *campo_distancias(Labirinto *l, Celula fim, ControleBusca *controle)
+{
+    CampoDistancias *c = (CampoDistancias *)calloc(1, sizeof(CampoDistancias));
+    c->n_linhas = labirinto_n_linhas(l);
+    c->n_colunas = labirinto_n_colunas(l);
+    c->fim = fim;
+
+    size_t n = (size_t)c->n_linhas * c->n_colunas;
+    c->custo = (double *)malloc(n * sizeof(double));
+    c->proximo = (unsigned char *)malloc(n * sizeof(unsigned char));
+
+    // com o fim fora do mapa, dijkstra_regiao deixa tudo inalcancavel
+    dijkstra_regiao_controlado(l, regiao_labirinto(l), fim.y, fim.x, c->custo, c->proximo, NULL, 0, controle, &c->status);
+
+    if (c->status != BUSCA_CONCLUIDA)
+        _campo_esvaziar(c);
+
+    return c;
+}
+
+CampoDistancias *campo_saltos(Labirinto *l, Celula fim)
+{
+    CampoDistancias *c = (CampoDistancias *)calloc(1, sizeof(CampoDistancias));
+    c->n_linhas = l->n_linhas;
+    c->n_colunas = l->n_colunas;
+    c->fim = fim;
+
+    size_t n = (size_t)c->n_linhas * c->n_colunas;
+    int *saltos = (int *)malloc(n * sizeof(int));
+    c->custo = (double *)malloc(n * sizeof(double));
+    c->proximo = (unsigned char *)malloc(n * sizeof(unsigned char));
+
+    // com o fim fora do mapa ou bloqueado, onda_saltos deixa tudo em -1
+    onda_saltos(l, fim, saltos);
+
+    for (int linha = 0; linha < c->n_linhas; linha++)
+        for (int coluna = 0; coluna < c->n_colunas; coluna++)
+        {
+            size_t v = (size_t)linha * c->n_colunas + coluna;
+            c->custo[v] = saltos[v] < 0 ? INFINITY : saltos[v];
+            c->proximo[v] = DIRECAO_NENHUMA;
+
+            if (saltos[v] <= 0)
+                continue;
+
+            // qualquer vizinho um salto mais perto serve; os cardeais (pares
+            // em directions) primeiro, para nao fazer zigue-zague a toa
+            for (int k = 0; k < 8; k++)
+            {
+                int d = (2 * k) % 8 + (k >= 4);
+                int vl = linha + directions[d][1], vc = coluna + directions[d][0];
+
+                if (_labirinto_dentro(l, vl, vc) && saltos[(size_t)vl * c->n_colunas + vc] == saltos[v] - 1)
+                {
+                    c->proximo[v] = d;
+                    break;
+                }
+            }
+        }
+
+    free(saltos);
+    return c;
+}
+
+CampoDistancias *campo_distancias_alvos(Labirinto *l, Celula *fins, int n_fins, ControleBusca *controle)
+{
+    CampoDistancias *c = (CampoDistancias *)calloc(1, sizeof(CampoDistancias));
+    c->n_linhas = l->n_linhas;
+    c->n_colunas = l->n_colunas;
+    if (n_fins > 0)
+        c->fim = fins[0];
+
+    size_t n = (size_t)c->n_linhas * c->n_colunas;
+    c->custo = (double *)malloc(n * sizeof(double));
+    c->proximo = (unsigned char *)malloc(n * sizeof(unsigned char));
+
+    // fins fora do mapa ficam com -1, que dijkstra_regiao_origens ignora
+    int *origens = (int *)malloc((n_fins > 0 ? n_fins : 1) * sizeof(int));
+    for (int i = 0; i < n_fins; i++)
+        origens[i] = _labirinto_dentro(l, fins[i].y, fins[i].x) ? fins[i].y * c->n_colunas + fins[i].x : -1;
+
+    // todos os fins partem com custo 0: proximo leva ao mais proximo deles
+    dijkstra_regiao_origens(l, regiao_labirinto(l), origens, n_fins, NULL, c->custo, c->proximo, NULL, 0, controle, &c->status);
+    free(origens);
+
+    if (c->status != BUSCA_CONCLUIDA)
+        _campo_esvaziar(c);
+
+    return c;
+}
+
+double campo_distancias_custo(CampoDistancias *c, Celula origem)
+{
+    if (origem.x < 0 || origem.y < 0 || origem.x >= c->n_colunas || origem.y >= c->n_linhas)
+        return INFINITY;
+
+    return c->custo[origem.y * c->n_colunas + origem.x];
+}
+
+ResultData campo_distancias_caminho(CampoDistancias *c, Celula origem)
+{
+    ResultData result = _default_result();
+    double custo = campo_distancias_custo(c, origem);
+
+    if (isinf(custo))
+        return result;
+
+    int tamanho = 1;
+    for (int v = origem.y * c->n_colunas + origem.x; c->proximo[v] != DIRECAO_NENHUMA; tamanho++)
+    {
+        int d = c->proximo[v];
+        v += directions[d][1] * c->n_colunas + directions[d][0];
+    }
+
+    result.caminho = (Celula *)calloc(tamanho, sizeof(Celula));
+    result.tamanho_caminho = tamanho;
+    result.custo_caminho = custo;
+    result.sucesso = 1;
+
+    Celula atual = origem;
+    for (int i = 0; i < tamanho; i++)
+    {
+        result.caminho[i].x = atual.x;
+        result.caminho[i].y = atual.y;
+
+        int d = c->proximo[atual.y * c->n_colunas + atual.x];
+        if (d != DIRECAO_NENHUMA)
+        {
+            atual.x += directions[d][0];
+            atual.y += directions[d][1];
+        }
+    }
+
+    return result;
+}
+
+void campo_distancias_destruir(CampoDistancias *c)
+{
+    free(c->custo);
+    free(c->proximo);
+    free(c);
+}
@@ -0,0 +1,50 @@
+#ifndef _CAMPO_H_
+#define _CAMPO_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// Campo de distancias (ou de fluxo) ate um destino: uma unica busca a partir
+// do fim responde o caminho de qualquer celula do mapa ate ele.
+typedef struct
+{
+    int n_linhas, n_colunas;
+    Celula fim;
+
+    // custo de cada celula (linha * n_colunas + coluna) ate o fim, ou
+    // INFINITY se o fim nao e' alcancavel
+    double *custo;
+
+    // indice em directions do proximo passo em direcao ao fim, ou
+    // DIRECAO_NENHUMA no proprio fim e nas celulas sem caminho
+    unsigned char *proximo;
+
+    // BUSCA_CONCLUIDA, ou o motivo pelo qual o controle interrompeu o
+    // Dijkstra; interrompido, o campo fica sem nenhuma celula alcancavel
+    StatusBusca status;
+} CampoDistancias;
+
+// Dijkstra a partir do fim sobre o mapa inteiro. Como os custos sao
+// simetricos, o predecessor de cada celula nessa busca e' o seu proximo passo.
+// controle e' opcional (pode ser NULL), como em a_star_controlado.
+CampoDistancias *campo_distancias(Labirinto *l, Celula fim, ControleBusca *controle);
+
+// campo de saltos: como campo_distancias, mas todo movimento (cardeal ou
+// diagonal) custa 1 e o terreno e' ignorado, entao custo conta movimentos.
+// Calculado pela frente de onda de onda_saltos, com os kernels SIMD, o que
+// o torna mais rapido que o Dijkstra (cerca de 2,5x em um mapa 2000x2000)
+// quando so' importa o menor numero de passos.
+CampoDistancias *campo_saltos(Labirinto *l, Celula fim);
+
+// campo ate o mais proximo de varios alvos (Dijkstra com todos eles como
+// origem): o caminho de cada celula termina no alvo de menor custo. fim
+// recebe o primeiro alvo; alvos bloqueados ou fora do mapa sao ignorados.
+CampoDistancias *campo_distancias_alvos(Labirinto *l, Celula *fins, int n_fins, ControleBusca *controle);
+
+double campo_distancias_custo(CampoDistancias *c, Celula origem);
+
+// segue as direcoes a partir da origem, em tempo proporcional ao caminho
+ResultData campo_distancias_caminho(CampoDistancias *c, Celula origem);
+void campo_distancias_destruir(CampoDistancias *c);
+
+#endif
@@ -0,0 +1,106 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include "corrida.h"
+#include "ara.h"
+#include "bidirecional.h"
+#include "vizinhanca.h"
+
+typedef struct
+{
+    Labirinto *l;
+    Celula inicio, fim;
+    Landmarks *landmarks;
+
+    ControleBusca controle;
+
+    // primeiro motor a terminar (-1 enquanto nenhum terminou) e a sua resposta
+    int vencedor;
+    ResultData result;
+} _Corrida;
+
+typedef struct
+{
+    _Corrida *corrida;
+    MotorCorrida motor;
+} _Corredor;
+
+const char *corrida_nome(MotorCorrida motor)
+{
+    static const char *nomes[] = {"A*", "A* vizinhanca", "bidirecional", "ALT"};
+
+    if (motor < 0 || motor >= CORRIDA_N_MOTORES)
+        return "?";
+
+    return nomes[motor];
+}
+
+void *_corrida_correr(void *arg)
+{
+    _Corredor *corredor = (_Corredor *)arg;
+    _Corrida *c = corredor->corrida;
+    ResultData result;
+
+    if (corredor->motor == CORRIDA_BIDIRECIONAL)
+        result = busca_bidirecional(c->l, c->inicio, c->fim, &c->controle);
+    else if (corredor->motor == CORRIDA_VIZINHANCA)
+        result = a_star_vizinhanca(c->l, c->inicio, c->fim, VIZINHANCA_8, &c->controle);
+    else
+    {
+        // ARA* com peso 1 e sem orcamento e' um A* otimo com estado proprio
+        ConfigARA config = ara_config_padrao(0);
+        config.peso_inicial = 1;
+        config.controle = &c->controle;
+
+        if (corredor->motor == CORRIDA_ALT)
+        {
+            config.heuristica = heuristica_alt;
+            config.contexto = c->landmarks;
+        }
+
+        result = ara_star(c->l, c->inicio, c->fim, config, NULL);
+    }
+
+    // um motor cancelado nao terminou: a sua resposta nao vale
+    int sem_vencedor = -1;
+    if (!controle_cancelado(&c->controle) &&
+        __atomic_compare_exchange_n(&c->vencedor, &sem_vencedor, (int)corredor->motor, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+        c->result = result;
+        controle_cancelar(&c->controle);
+    }
+    else if (result.caminho)
+        free(result.caminho);
+
+    return NULL;
+}
+
+ResultData corrida(Labirinto *l, Celula inicio, Celula fim, Landmarks *landmarks, MotorCorrida *vencedor)
+{
+    _Corrida c;
+    c.l = l;
+    c.inicio = inicio;
+    c.fim = fim;
+    c.landmarks = landmarks;
+    c.controle = controle_criar(0);
+    c.vencedor = -1;
+    c.result = _default_result();
+
+    int n_motores = landmarks ? CORRIDA_N_MOTORES : CORRIDA_ALT;
+    pthread_t threads[CORRIDA_N_MOTORES];
+    _Corredor corredores[CORRIDA_N_MOTORES];
+
+    for (int i = 0; i < n_motores; i++)
+    {
+        corredores[i].corrida = &c;
+        corredores[i].motor = (MotorCorrida)i;
+        pthread_create(&threads[i], NULL, _corrida_correr, &corredores[i]);
+    }
+
+    for (int i = 0; i < n_motores; i++)
+        pthread_join(threads[i], NULL);
+
+    if (vencedor)
+        *vencedor = (MotorCorrida)c.vencedor;
+
+    return c.result;
+}
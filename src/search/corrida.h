@@ -0,0 +1,37 @@
+#ifndef _CORRIDA_H_
+#define _CORRIDA_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+#include "landmarks.h"
+
+// motores que disputam a corrida. Todos sao otimos e completos e nenhum
+// marca celulas no labirinto, entao podem rodar juntos sobre o mesmo mapa.
+typedef enum
+{
+    CORRIDA_A_STAR = 0,
+
+    // o motor de vizinhanca com 8 movimentos: a mesma busca do A*, com o
+    // laco de vizinhos desenrolado e sem a heuristica por ponteiro, entao
+    // costuma ganhar quando o custo de cada expansao domina (consultas
+    // longas em mapas grandes)
+    CORRIDA_VIZINHANCA,
+    CORRIDA_BIDIRECIONAL,
+    CORRIDA_ALT,
+    CORRIDA_N_MOTORES
+} MotorCorrida;
+
+const char *corrida_nome(MotorCorrida motor);
+
+/**
+ * @brief Roda os motores ao mesmo tempo, um por thread, e devolve a resposta
+ * do primeiro que terminar (um caminho otimo, ou a prova de que nao ha
+ * caminho). Os outros sao cancelados e a funcao espera que eles parem.
+ * @param landmarks
+ * Opcional: se nao for NULL, o A* com a heuristica ALT tambem participa.
+ * @param vencedor
+ * Opcional: recebe o motor que respondeu.
+ */
+ResultData corrida(Labirinto *l, Celula inicio, Celula fim, Landmarks *landmarks, MotorCorrida *vencedor);
+
+#endif
@@ -0,0 +1,400 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpd.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+// Formato do arquivo: numero magico, versao, n_linhas, n_colunas,
+// labirinto_hash, n_livres e n_sequencias, seguidos dos n_livres + 1 inicios
+// de linha e das sequencias (uint32_t cada).
+#define CPD_MAGICO "LCPD"
+#define CPD_VERSAO 1
+
+// movimento da propria celula ou de alvos inalcancaveis
+#define CPD_NENHUM 8
+
+// diferenca abaixo da qual dois custos sao considerados iguais
+#define CPD_FOLGA 1e-9
+
+struct BaseCaminhos
+{
+    int n_linhas, n_colunas;
+    uint64_t hash;
+
+    // celulas livres numeradas na ordem de Morton: indice de cada celula do
+    // mapa (-1 se bloqueada) e celula de cada indice
+    int n_livres;
+    int *indice;
+    int *celulas;
+
+    // a linha da origem s ocupa sequencias[inicio_linha[s] .. inicio_linha[s + 1]);
+    // cada sequencia e' (primeiro alvo << 4) | movimento
+    uint32_t *inicio_linha;
+    uint32_t *sequencias;
+    uint32_t n_sequencias;
+};
+
+// intercala os bits de linha e coluna (16 bits de cada)
+uint64_t _base_caminhos_morton(int linha, int coluna)
+{
+    uint64_t m = 0;
+
+    for (int i = 0; i < 16; i++)
+        m |= (uint64_t)((coluna >> i) & 1) << (2 * i) | (uint64_t)((linha >> i) & 1) << (2 * i + 1);
+
+    return m;
+}
+
+int _base_caminhos_comparar(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+BaseCaminhos *_base_caminhos_alocar(Labirinto *l)
+{
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+    int n_livres = 0;
+
+    for (int i = 0; i < l->n_linhas; i++)
+        for (int j = 0; j < l->n_colunas; j++)
+            n_livres += !_labirinto_bloqueado(l, i, j);
+
+    if (n_livres > CPD_MAX_LIVRES)
+        return NULL;
+
+    BaseCaminhos *b = (BaseCaminhos *)calloc(1, sizeof(BaseCaminhos));
+    b->n_linhas = l->n_linhas;
+    b->n_colunas = l->n_colunas;
+    b->hash = labirinto_hash(l);
+    b->n_livres = n_livres;
+    b->indice = (int *)malloc(n * sizeof(int));
+    b->celulas = (int *)malloc((n_livres > 0 ? n_livres : 1) * sizeof(int));
+    b->inicio_linha = (uint32_t *)calloc(n_livres + 1, sizeof(uint32_t));
+
+    // alvos na ordem de Morton (Z): celulas proximas no mapa ficam proximas
+    // na linha, o que forma sequencias bem mais longas que linha a linha
+    uint64_t *chaves = (uint64_t *)malloc((n_livres > 0 ? n_livres : 1) * sizeof(uint64_t));
+
+    for (int v = 0, k = 0; (size_t)v < n; v++)
+    {
+        b->indice[v] = -1;
+
+        if (!_labirinto_bloqueado(l, v / l->n_colunas, v % l->n_colunas))
+            chaves[k++] = _base_caminhos_morton(v / l->n_colunas, v % l->n_colunas) << 32 | (uint32_t)v;
+    }
+
+    qsort(chaves, n_livres, sizeof(uint64_t), _base_caminhos_comparar);
+
+    for (int k = 0; k < n_livres; k++)
+    {
+        b->celulas[k] = (int)(uint32_t)chaves[k];
+        b->indice[b->celulas[k]] = k;
+    }
+
+    free(chaves);
+    return b;
+}
+
+BaseCaminhos *base_caminhos_construir(Labirinto *l)
+{
+    BaseCaminhos *b = _base_caminhos_alocar(l);
+
+    if (!b)
+        return NULL;
+
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+    double *dist = (double *)malloc(n * sizeof(double));
+    unsigned short *primeiros = (unsigned short *)malloc(n * sizeof(unsigned short));
+    int *marca = (int *)calloc(n, sizeof(int));
+    IndexHeap *heap = index_heap_construct(n);
+
+    uint32_t capacidade = 1024;
+    b->sequencias = (uint32_t *)malloc(capacidade * sizeof(uint32_t));
+
+    for (int s = 0; s < b->n_livres; s++)
+    {
+        // Dijkstra a partir da origem, propagando o conjunto (mascara) dos
+        // primeiros movimentos de todos os caminhos minimos de cada celula;
+        // marca evita reiniciar os vetores
+        int origem = b->celulas[s];
+        marca[origem] = s + 1;
+        dist[origem] = 0;
+        primeiros[origem] = 0;
+        index_heap_push(heap, origem, 0);
+
+        while (!index_heap_empty(heap))
+        {
+            int u = index_heap_pop(heap);
+            int y = u / l->n_colunas, x = u % l->n_colunas;
+
+            for (int d = 0; d < 8; d++)
+            {
+                int ny = y + directions[d][1], nx = x + directions[d][0];
+
+                if (_labirinto_bloqueado(l, ny, nx))
+                    continue;
+
+                int v = ny * l->n_colunas + nx;
+                double custo = dist[u] + ((directions[d][0] && directions[d][1]) ? M_SQRT2 : 1.0);
+                unsigned short mascara = u == origem ? 1 << d : primeiros[u];
+
+                if (marca[v] != s + 1 || custo < dist[v] - CPD_FOLGA)
+                {
+                    marca[v] = s + 1;
+                    dist[v] = custo;
+                    primeiros[v] = mascara;
+                    index_heap_push(heap, v, custo);
+                }
+                else if (custo < dist[v] + CPD_FOLGA)
+                    primeiros[v] |= mascara;
+            }
+        }
+
+        // comprime a linha da origem: cada sequencia se estende enquanto
+        // algum movimento for otimo para todos os seus alvos. A propria
+        // origem aceita qualquer movimento; os inalcancaveis, so' CPD_NENHUM.
+        b->inicio_linha[s] = b->n_sequencias;
+        unsigned short comum = 0;
+        int comeco = 0;
+
+        for (int t = 0; t <= b->n_livres; t++)
+        {
+            unsigned short mascara = 0;
+
+            if (t < b->n_livres)
+            {
+                int v = b->celulas[t];
+                mascara = t == s ? 0x1ff : (marca[v] == s + 1 ? primeiros[v] : 1 << CPD_NENHUM);
+
+                if (t == 0 || (comum & mascara))
+                {
+                    comum = t == 0 ? mascara : comum & mascara;
+                    continue;
+                }
+            }
+
+            if (b->n_sequencias == capacidade)
+            {
+                capacidade *= 2;
+                b->sequencias = (uint32_t *)realloc(b->sequencias, capacidade * sizeof(uint32_t));
+            }
+
+            b->sequencias[b->n_sequencias++] = (uint32_t)comeco << 4 | __builtin_ctz(comum);
+            comum = mascara;
+            comeco = t;
+        }
+    }
+
+    b->inicio_linha[b->n_livres] = b->n_sequencias;
+
+    free(dist);
+    free(primeiros);
+    free(marca);
+    index_heap_destroy(heap);
+
+    return b;
+}
+
+void base_caminhos_arquivo(char *labirinto, char *saida, int tamanho)
+{
+    snprintf(saida, tamanho, "%s", labirinto);
+
+    char *barra = strrchr(saida, '/');
+    char *ponto = strrchr(saida, '.');
+
+    if (ponto && (!barra || ponto > barra))
+        *ponto = '\0';
+
+    int usado = strlen(saida);
+    snprintf(saida + usado, tamanho - usado, "%s", CPD_EXTENSAO);
+}
+
+void base_caminhos_salvar(BaseCaminhos *b, char *arquivo)
+{
+    FILE *file = fopen(arquivo, "wb");
+
+    if (file == NULL)
+        exit(printf("Nao foi possivel criar o arquivo %s.\n", arquivo));
+
+    int versao = CPD_VERSAO;
+    fwrite(CPD_MAGICO, sizeof(char), 4, file);
+    fwrite(&versao, sizeof(int), 1, file);
+    fwrite(&b->n_linhas, sizeof(int), 1, file);
+    fwrite(&b->n_colunas, sizeof(int), 1, file);
+    fwrite(&b->hash, sizeof(uint64_t), 1, file);
+    fwrite(&b->n_livres, sizeof(int), 1, file);
+    fwrite(&b->n_sequencias, sizeof(uint32_t), 1, file);
+    fwrite(b->inicio_linha, sizeof(uint32_t), b->n_livres + 1, file);
+    fwrite(b->sequencias, sizeof(uint32_t), b->n_sequencias, file);
+
+    fclose(file);
+}
+
+// confere a estrutura lida do arquivo antes de qualquer consulta: cada linha
+// e' um trecho nao vazio de sequencias, em ordem e dentro do vetor, que
+// comeca no alvo 0 e segue com alvos crescentes e movimentos validos
+int _base_caminhos_valida(BaseCaminhos *b)
+{
+    if (b->inicio_linha[0] != 0 || b->inicio_linha[b->n_livres] != b->n_sequencias)
+        return 0;
+
+    for (int s = 0; s < b->n_livres; s++)
+    {
+        uint32_t ini = b->inicio_linha[s], fim = b->inicio_linha[s + 1];
+
+        if (fim <= ini || fim > b->n_sequencias || (b->sequencias[ini] >> 4) != 0)
+            return 0;
+
+        for (uint32_t k = ini; k < fim; k++)
+        {
+            if ((b->sequencias[k] & 15) > CPD_NENHUM || (b->sequencias[k] >> 4) >= (uint32_t)b->n_livres)
+                return 0;
+
+            if (k > ini && (b->sequencias[k] >> 4) <= (b->sequencias[k - 1] >> 4))
+                return 0;
+        }
+    }
+
+    return 1;
+}
+
+BaseCaminhos *base_caminhos_carregar(char *arquivo, Labirinto *l)
+{
+    FILE *file = fopen(arquivo, "rb");
+
+    if (file == NULL)
+        return NULL;
+
+    char magico[4] = {0};
+    int versao = 0, n_linhas = 0, n_colunas = 0, n_livres = 0;
+    uint64_t hash = 0;
+    uint32_t n_sequencias = 0;
+
+    fread(magico, sizeof(char), 4, file);
+    if (memcmp(magico, CPD_MAGICO, 4) != 0)
+        exit(printf("Arquivo %s nao e' uma base de caminhos.\n", arquivo));
+
+    fread(&versao, sizeof(int), 1, file);
+    if (versao != CPD_VERSAO)
+        exit(printf("Arquivo %s: versao %d da base de caminhos nao suportada.\n", arquivo, versao));
+
+    fread(&n_linhas, sizeof(int), 1, file);
+    fread(&n_colunas, sizeof(int), 1, file);
+    fread(&hash, sizeof(uint64_t), 1, file);
+    fread(&n_livres, sizeof(int), 1, file);
+    fread(&n_sequencias, sizeof(uint32_t), 1, file);
+
+    // base de outro labirinto ou de uma versao antiga deste
+    if (n_linhas != l->n_linhas || n_colunas != l->n_colunas || hash != labirinto_hash(l))
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    BaseCaminhos *b = _base_caminhos_alocar(l);
+
+    if (!b || b->n_livres != n_livres)
+        exit(printf("Arquivo %s: base de caminhos corrompida.\n", arquivo));
+
+    b->n_sequencias = n_sequencias;
+    b->sequencias = (uint32_t *)malloc((n_sequencias > 0 ? n_sequencias : 1) * sizeof(uint32_t));
+
+    if (fread(b->inicio_linha, sizeof(uint32_t), n_livres + 1, file) != (size_t)n_livres + 1 ||
+        fread(b->sequencias, sizeof(uint32_t), n_sequencias, file) != n_sequencias ||
+        !_base_caminhos_valida(b))
+        exit(printf("Arquivo %s: base de caminhos corrompida.\n", arquivo));
+
+    fclose(file);
+    return b;
+}
+
+// primeiro movimento de s para t: a ultima sequencia da linha de s que
+// comeca em um alvo <= t
+int _base_caminhos_movimento(BaseCaminhos *b, int s, int t)
+{
+    uint32_t ini = b->inicio_linha[s], fim = b->inicio_linha[s + 1];
+
+    while (fim - ini > 1)
+    {
+        uint32_t meio = ini + (fim - ini) / 2;
+
+        if ((int)(b->sequencias[meio] >> 4) <= t)
+            ini = meio;
+        else
+            fim = meio;
+    }
+
+    return b->sequencias[ini] & 15;
+}
+
+ResultData base_caminhos_caminho(BaseCaminhos *b, Celula inicio, Celula fim, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+
+    if (inicio.x < 0 || inicio.y < 0 || inicio.x >= b->n_colunas || inicio.y >= b->n_linhas ||
+        fim.x < 0 || fim.y < 0 || fim.x >= b->n_colunas || fim.y >= b->n_linhas)
+        return result;
+
+    int s = b->indice[inicio.y * b->n_colunas + inicio.x];
+    int t = b->indice[fim.y * b->n_colunas + fim.x];
+
+    if (s < 0 || t < 0 || (s != t && _base_caminhos_movimento(b, s, t) == CPD_NENHUM))
+        return result;
+
+    // primeira passada conta os passos, a segunda grava as celulas. Nao ha
+    // expansoes: o controle e' consultado a cada BUSCA_INTERVALO_CONTROLE passos
+    int tamanho = 1;
+    for (int v = s; v != t; tamanho++)
+    {
+        if (tamanho % BUSCA_INTERVALO_CONTROLE == 0 && (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            return result;
+
+        int d = _base_caminhos_movimento(b, v, t);
+        int celula = b->celulas[v];
+        v = b->indice[celula + directions[d][1] * b->n_colunas + directions[d][0]];
+    }
+
+    result.caminho = (Celula *)calloc(tamanho, sizeof(Celula));
+    result.tamanho_caminho = tamanho;
+    result.sucesso = 1;
+
+    for (int i = 0, v = s; i < tamanho; i++)
+    {
+        int celula = b->celulas[v];
+        result.caminho[i].x = celula % b->n_colunas;
+        result.caminho[i].y = celula / b->n_colunas;
+
+        if (i > 0)
+            result.custo_caminho += _cell_distance(&result.caminho[i - 1], &result.caminho[i]);
+
+        if (v != t)
+        {
+            int d = _base_caminhos_movimento(b, v, t);
+            v = b->indice[celula + directions[d][1] * b->n_colunas + directions[d][0]];
+        }
+    }
+
+    return result;
+}
+
+long base_caminhos_sequencias(BaseCaminhos *b)
+{
+    return b->n_sequencias;
+}
+
+long base_caminhos_bytes(BaseCaminhos *b)
+{
+    return (long)(b->n_livres + 1 + b->n_sequencias) * sizeof(uint32_t);
+}
+
+void base_caminhos_destruir(BaseCaminhos *b)
+{
+    free(b->indice);
+    free(b->celulas);
+    free(b->inicio_linha);
+    free(b->sequencias);
+    free(b);
+}
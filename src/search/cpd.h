@@ -0,0 +1,47 @@
+#ifndef _CPD_H_
+#define _CPD_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// maior numero de celulas livres aceito: a tabela e' quadratica nele
+#define CPD_MAX_LIVRES 10000
+
+// extensao do arquivo salvo ao lado do labirinto
+#define CPD_EXTENSAO ".cpd"
+
+/**
+ * Base de caminhos comprimida (CPD): para cada par de celulas livres, o
+ * primeiro movimento de um caminho minimo entre elas. A linha de cada origem
+ * (alvos na ordem de Morton, que agrupa celulas vizinhas) e' comprimida em
+ * sequencias do mesmo movimento, guardadas como (primeiro alvo, movimento)
+ * para busca binaria. Quando ha varios movimentos otimos para um alvo, a
+ * sequencia usa o que a deixa mais longa. Uma consulta segue os primeiros
+ * movimentos ate o fim, em tempo proporcional ao caminho vezes o log do
+ * numero de sequencias, sem nenhuma busca no labirinto.
+ */
+typedef struct BaseCaminhos BaseCaminhos;
+
+// um Dijkstra por celula livre. NULL se o mapa tem mais de CPD_MAX_LIVRES
+// celulas livres.
+BaseCaminhos *base_caminhos_construir(Labirinto *l);
+
+// nome do arquivo da base de um labirinto: a extensao do labirinto (se
+// houver) trocada por CPD_EXTENSAO
+void base_caminhos_arquivo(char *labirinto, char *saida, int tamanho);
+void base_caminhos_salvar(BaseCaminhos *b, char *arquivo);
+
+// NULL se o arquivo nao existe ou foi construido para outro conteudo de
+// labirinto (labirinto_hash diferente), casos em que a base deve ser refeita
+BaseCaminhos *base_caminhos_carregar(char *arquivo, Labirinto *l);
+
+// caminho minimo de inicio a fim; nos_expandidos fica 0. O controle
+// (opcional) e' consultado a cada BUSCA_INTERVALO_CONTROLE passos do caminho.
+ResultData base_caminhos_caminho(BaseCaminhos *b, Celula inicio, Celula fim, ControleBusca *controle);
+
+// numero de sequencias e bytes ocupados pela tabela comprimida
+long base_caminhos_sequencias(BaseCaminhos *b);
+long base_caminhos_bytes(BaseCaminhos *b);
+void base_caminhos_destruir(BaseCaminhos *b);
+
+#endif
@@ -0,0 +1,330 @@
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "delta.h"
+#include "labirinto_interno.h"
+
+// celulas de uma lista que uma thread pega de cada vez
+#define DELTA_BLOCO 1024
+
+#define DELTA_LEVE 0
+#define DELTA_PESADA 1
+#define DELTA_FIM 2
+
+typedef struct
+{
+    int *celulas;
+    int n, capacidade;
+} _ListaDelta;
+
+typedef struct
+{
+    Labirinto *l;
+    int n_threads;
+    double delta;
+
+    // as distancias ficam como os bits dos doubles: para valores nao
+    // negativos a ordem dos inteiros e' a mesma, e o minimo atomico vira uma
+    // troca atomica de 64 bits
+    uint64_t *bits;
+
+    // celula ja incluida nos removidos do balde atual
+    unsigned char *removida;
+
+    // baldes[t * n_baldes + k]: celulas que a thread t colocou no balde de
+    // numero congruente a k. Como uma aresta custa no maximo sqrt(2), os
+    // baldes vivos sempre cabem em n_baldes posicoes circulares.
+    int n_baldes;
+    _ListaDelta *baldes;
+
+    // por thread: lista em processamento e removidos do balde atual
+    _ListaDelta *atual;
+    _ListaDelta *removidos;
+
+    // listas distribuidas na fase atual, com a posicao global de cada uma
+    _ListaDelta *fonte;
+    long *inicio;
+    long tamanho;
+    long proximo_bloco;
+
+    long balde;
+    int fase;
+    long processadas;
+
+    pthread_barrier_t barreira;
+} _BuscaDelta;
+
+typedef struct
+{
+    _BuscaDelta *b;
+    int id;
+} _TarefaDelta;
+
+void _delta_adicionar(_ListaDelta *lista, int celula)
+{
+    if (lista->n == lista->capacidade)
+    {
+        lista->capacidade = lista->capacidade ? 2 * lista->capacidade : DELTA_BLOCO;
+        lista->celulas = (int *)realloc(lista->celulas, lista->capacidade * sizeof(int));
+    }
+
+    lista->celulas[lista->n++] = celula;
+}
+
+static inline double _delta_distancia(_BuscaDelta *b, int celula)
+{
+    uint64_t bits = __atomic_load_n(&b->bits[celula], __ATOMIC_RELAXED);
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+// minimo atomico: grava d se for menor que a distancia atual
+static inline int _delta_minimo(_BuscaDelta *b, int celula, double d)
+{
+    uint64_t novo;
+    memcpy(&novo, &d, sizeof(novo));
+
+    uint64_t atual = __atomic_load_n(&b->bits[celula], __ATOMIC_RELAXED);
+    while (novo < atual)
+    {
+        if (__atomic_compare_exchange_n(&b->bits[celula], &atual, novo, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            return 1;
+    }
+
+    return 0;
+}
+
+void _delta_relaxar(_BuscaDelta *b, int id, int u, double d, int leves)
+{
+    int n_colunas = b->l->n_colunas;
+    int y = u / n_colunas, x = u % n_colunas;
+
+    for (int i = 0; i < 8; i++)
+    {
+        double custo = (directions[i][0] && directions[i][1]) ? M_SQRT2 : 1.0;
+
+        if ((custo <= b->delta) != leves)
+            continue;
+
+        int ny = y + directions[i][1], nx = x + directions[i][0];
+
+        if (_labirinto_bloqueado(b->l, ny, nx))
+            continue;
+
+        int v = ny * n_colunas + nx;
+        double novo = d + custo;
+
+        if (_delta_minimo(b, v, novo))
+            _delta_adicionar(&b->baldes[id * b->n_baldes + (long)(novo / b->delta) % b->n_baldes], v);
+    }
+}
+
+void _delta_processar(_BuscaDelta *b, int id)
+{
+    long processadas = 0;
+
+    while (1)
+    {
+        long i = __atomic_fetch_add(&b->proximo_bloco, DELTA_BLOCO, __ATOMIC_RELAXED);
+        if (i >= b->tamanho)
+            break;
+
+        long fim_bloco = i + DELTA_BLOCO < b->tamanho ? i + DELTA_BLOCO : b->tamanho;
+
+        int t = 0;
+        while (t + 1 < b->n_threads && b->inicio[t + 1] <= i)
+            t++;
+
+        for (; i < fim_bloco; i++)
+        {
+            while (i >= b->inicio[t] + b->fonte[t].n)
+                t++;
+
+            int u = b->fonte[t].celulas[i - b->inicio[t]];
+            double d = _delta_distancia(b, u);
+
+            if (b->fase == DELTA_PESADA)
+            {
+                b->removida[u] = 0;
+                _delta_relaxar(b, id, u, d, 0);
+                continue;
+            }
+
+            // copia antiga: a celula ja melhorou para um balde anterior
+            if ((long)(d / b->delta) != b->balde)
+                continue;
+
+            if (!__atomic_exchange_n(&b->removida[u], 1, __ATOMIC_RELAXED))
+                _delta_adicionar(&b->removidos[id], u);
+
+            _delta_relaxar(b, id, u, d, 1);
+            processadas++;
+        }
+    }
+
+    __atomic_fetch_add(&b->processadas, processadas, __ATOMIC_RELAXED);
+}
+
+void *_delta_trabalhar(void *arg)
+{
+    _TarefaDelta *tarefa = (_TarefaDelta *)arg;
+    _BuscaDelta *b = tarefa->b;
+
+    while (1)
+    {
+        pthread_barrier_wait(&b->barreira);
+        if (b->fase == DELTA_FIM)
+            break;
+
+        _delta_processar(b, tarefa->id);
+        pthread_barrier_wait(&b->barreira);
+    }
+
+    return NULL;
+}
+
+// distribui as listas entre as threads e processa a fase (thread principal)
+void _delta_fase(_BuscaDelta *b, _ListaDelta *fonte, int fase)
+{
+    b->fonte = fonte;
+    b->fase = fase;
+    b->proximo_bloco = 0;
+    b->tamanho = 0;
+
+    for (int t = 0; t < b->n_threads; t++)
+    {
+        b->inicio[t] = b->tamanho;
+        b->tamanho += fonte[t].n;
+    }
+    b->inicio[b->n_threads] = b->tamanho;
+
+    pthread_barrier_wait(&b->barreira);
+    _delta_processar(b, 0);
+    pthread_barrier_wait(&b->barreira);
+}
+
+int _delta_balde_vazio(_BuscaDelta *b, int k)
+{
+    for (int t = 0; t < b->n_threads; t++)
+        if (b->baldes[t * b->n_baldes + k].n > 0)
+            return 0;
+    return 1;
+}
+
+long delta_stepping(Labirinto *l, Celula origem, double *dist, double delta, int n_threads)
+{
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+
+    for (size_t i = 0; i < n; i++)
+        dist[i] = INFINITY;
+
+    if (!_labirinto_livre(l, origem.y, origem.x))
+        return 0;
+
+    if (delta <= 0)
+        delta = DELTA_PADRAO;
+    if (n_threads <= 0)
+        n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n_threads < 1)
+        n_threads = 1;
+
+    _BuscaDelta b;
+    memset(&b, 0, sizeof(b));
+    b.l = l;
+    b.n_threads = n_threads;
+    b.delta = delta;
+    b.n_baldes = (int)(M_SQRT2 / delta) + 2;
+
+    b.bits = (uint64_t *)malloc(n * sizeof(uint64_t));
+    memcpy(b.bits, dist, n * sizeof(uint64_t));
+    b.removida = (unsigned char *)calloc(n, sizeof(unsigned char));
+    b.baldes = (_ListaDelta *)calloc((size_t)n_threads * b.n_baldes, sizeof(_ListaDelta));
+    b.atual = (_ListaDelta *)calloc(n_threads, sizeof(_ListaDelta));
+    b.removidos = (_ListaDelta *)calloc(n_threads, sizeof(_ListaDelta));
+    b.inicio = (long *)calloc(n_threads + 1, sizeof(long));
+
+    int u = origem.y * l->n_colunas + origem.x;
+    b.bits[u] = 0;
+    _delta_adicionar(&b.baldes[0], u);
+
+    pthread_barrier_init(&b.barreira, NULL, n_threads);
+    pthread_t *threads = (pthread_t *)malloc(n_threads * sizeof(pthread_t));
+    _TarefaDelta *tarefas = (_TarefaDelta *)malloc(n_threads * sizeof(_TarefaDelta));
+
+    for (int t = 0; t < n_threads; t++)
+    {
+        tarefas[t].b = &b;
+        tarefas[t].id = t;
+
+        if (t > 0)
+            pthread_create(&threads[t], NULL, _delta_trabalhar, &tarefas[t]);
+    }
+
+    while (1)
+    {
+        // proximo balde nao vazio, dentro da janela circular
+        int k = 0;
+        while (k < b.n_baldes && _delta_balde_vazio(&b, (b.balde + k) % b.n_baldes))
+            k++;
+
+        if (k == b.n_baldes)
+            break;
+
+        b.balde += k;
+        int posicao = b.balde % b.n_baldes;
+
+        // arestas leves podem devolver celulas ao mesmo balde: repete ate
+        // ele ficar vazio
+        while (!_delta_balde_vazio(&b, posicao))
+        {
+            for (int t = 0; t < n_threads; t++)
+            {
+                _ListaDelta aux = b.atual[t];
+                b.atual[t] = b.baldes[t * b.n_baldes + posicao];
+                b.baldes[t * b.n_baldes + posicao] = aux;
+                b.baldes[t * b.n_baldes + posicao].n = 0;
+            }
+
+            _delta_fase(&b, b.atual, DELTA_LEVE);
+        }
+
+        // com o balde fechado, as arestas pesadas saem de distancias finais
+        _delta_fase(&b, b.removidos, DELTA_PESADA);
+
+        for (int t = 0; t < n_threads; t++)
+            b.removidos[t].n = 0;
+    }
+
+    b.fase = DELTA_FIM;
+    pthread_barrier_wait(&b.barreira);
+
+    for (int t = 1; t < n_threads; t++)
+        pthread_join(threads[t], NULL);
+
+    memcpy(dist, b.bits, n * sizeof(double));
+
+    pthread_barrier_destroy(&b.barreira);
+
+    for (int t = 0; t < n_threads; t++)
+    {
+        for (int k = 0; k < b.n_baldes; k++)
+            free(b.baldes[t * b.n_baldes + k].celulas);
+        free(b.atual[t].celulas);
+        free(b.removidos[t].celulas);
+    }
+
+    free(b.baldes);
+    free(b.atual);
+    free(b.removidos);
+    free(b.inicio);
+    free(b.removida);
+    free(b.bits);
+    free(threads);
+    free(tarefas);
+
+    return b.processadas;
+}
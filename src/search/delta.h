@@ -0,0 +1,28 @@
+#ifndef _DELTA_H_
+#define _DELTA_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// largura padrao dos baldes: os passos cardeais (custo 1) sao leves e os
+// diagonais (sqrt(2)) pesados
+#define DELTA_PADRAO 1.0
+
+/**
+ * @brief Caminhos minimos de uma origem para o mapa inteiro por Delta-stepping,
+ * com o mesmo custo de _cell_distance. As celulas ficam em baldes de largura
+ * delta (<= 0 usa DELTA_PADRAO); cada balde e' esvaziado relaxando as arestas
+ * leves (custo <= delta) em paralelo, repetindo enquanto ele receber celulas,
+ * e depois as pesadas das celulas que passaram por ele. As distancias sao
+ * atualizadas com um minimo atomico. n_threads <= 0 usa o numero de
+ * processadores.
+ * @param dist
+ * Vetor de n_linhas x n_colunas (linha * n_colunas + coluna) que recebe o
+ * custo a partir da origem, ou INFINITY para celulas nao alcancadas.
+ * @return long
+ * Numero de celulas processadas (uma celula pode ser processada mais de uma
+ * vez dentro do seu balde).
+ */
+long delta_stepping(Labirinto *l, Celula origem, double *dist, double delta, int n_threads);
+
+#endif
@@ -0,0 +1,149 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dijkstra.h"
+#include "algorithms.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+Regiao regiao_labirinto(Labirinto *l)
+{
+    Regiao r = {0, 0, l->n_linhas, l->n_colunas};
+    return r;
+}
+
+int regiao_indice(Regiao *r, int linha, int coluna)
+{
+    return (linha - r->linha_min) * r->n_colunas + (coluna - r->coluna_min);
+}
+
+int regiao_contem(Regiao *r, int linha, int coluna)
+{
+    return linha >= r->linha_min && linha < r->linha_min + r->n_linhas &&
+           coluna >= r->coluna_min && coluna < r->coluna_min + r->n_colunas;
+}
+
+int dijkstra_regiao(Labirinto *l, Regiao regiao, int linha, int coluna, double *dist, unsigned char *dir, int *alvos, int n_alvos)
+{
+    return dijkstra_regiao_terreno(l, regiao, linha, coluna, NULL, dist, dir, alvos, n_alvos);
+}
+
+int dijkstra_regiao_controlado(Labirinto *l, Regiao regiao, int linha, int coluna, double *dist, unsigned char *dir, int *alvos, int n_alvos, ControleBusca *controle, StatusBusca *status)
+{
+    // uma origem fora da regiao e' descartada por dijkstra_regiao_origens
+    int origem = regiao_contem(&regiao, linha, coluna) ? regiao_indice(&regiao, linha, coluna) : -1;
+    return dijkstra_regiao_origens(l, regiao, &origem, 1, NULL, dist, dir, alvos, n_alvos, controle, status);
+}
+
+int dijkstra_regiao_terreno(Labirinto *l, Regiao regiao, int linha, int coluna, TabelaTerreno *terreno, double *dist, unsigned char *dir, int *alvos, int n_alvos)
+{
+    int origem = regiao_contem(&regiao, linha, coluna) ? regiao_indice(&regiao, linha, coluna) : -1;
+    return dijkstra_regiao_origens(l, regiao, &origem, 1, terreno, dist, dir, alvos, n_alvos, NULL, NULL);
+}
+
+int dijkstra_regiao_origens(Labirinto *l, Regiao regiao, int *origens, int n_origens, TabelaTerreno *terreno, double *dist, unsigned char *dir, int *alvos, int n_alvos, ControleBusca *controle, StatusBusca *status)
+{
+    size_t n = (size_t)regiao.n_linhas * regiao.n_colunas;
+    int expandidos = 0;
+    StatusBusca motivo = BUSCA_CONCLUIDA;
+
+    for (size_t i = 0; i < n; i++)
+        dist[i] = INFINITY;
+
+    if (dir)
+        memset(dir, DIRECAO_NENHUMA, n);
+
+    IndexHeap *heap = index_heap_construct(n);
+
+    for (int i = 0; i < n_origens; i++)
+    {
+        if (origens[i] < 0 || (size_t)origens[i] >= n ||
+            _labirinto_bloqueado(l, regiao.linha_min + origens[i] / regiao.n_colunas, regiao.coluna_min + origens[i] % regiao.n_colunas))
+            continue;
+
+        dist[origens[i]] = 0;
+        index_heap_push(heap, origens[i], 0);
+    }
+
+    if (status)
+        *status = BUSCA_CONCLUIDA;
+
+    if (index_heap_empty(heap))
+    {
+        index_heap_destroy(heap);
+        return 0;
+    }
+
+    // marca os alvos e conta quantos ainda nao foram fechados
+    unsigned char *eh_alvo = NULL;
+    int faltam = 0;
+
+    if (alvos)
+    {
+        eh_alvo = (unsigned char *)calloc(n, sizeof(unsigned char));
+
+        for (int i = 0; i < n_alvos; i++)
+        {
+            if (alvos[i] >= 0 && (size_t)alvos[i] < n && !eh_alvo[alvos[i]])
+            {
+                eh_alvo[alvos[i]] = 1;
+                faltam++;
+            }
+        }
+    }
+
+    unsigned char *fechado = (unsigned char *)calloc(n, sizeof(unsigned char));
+    while (!index_heap_empty(heap) && (!alvos || faltam > 0))
+    {
+        if (expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (motivo = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        int atual = index_heap_pop(heap);
+        fechado[atual] = 1;
+        expandidos++;
+
+        if (eh_alvo && eh_alvo[atual])
+            faltam--;
+
+        int y = regiao.linha_min + atual / regiao.n_colunas;
+        int x = regiao.coluna_min + atual % regiao.n_colunas;
+
+        for (int d = 0; d < 8; d++)
+        {
+            int nx = x + directions[d][0];
+            int ny = y + directions[d][1];
+
+            if (!regiao_contem(&regiao, ny, nx) || _labirinto_bloqueado(l, ny, nx))
+                continue;
+
+            int viz = regiao_indice(&regiao, ny, nx);
+
+            if (fechado[viz])
+                continue;
+
+            int diagonal = directions[d][0] && directions[d][1];
+            double custo = dist[atual] + (terreno ? terreno_custo_passo(terreno, _labirinto_terreno(l, y, x), _labirinto_terreno(l, ny, nx), diagonal)
+                                                  : (diagonal ? M_SQRT2 : 1.0));
+
+            if (custo < dist[viz])
+            {
+                dist[viz] = custo;
+
+                // o predecessor fica na direcao oposta a d
+                if (dir)
+                    dir[viz] = (d + 4) % 8;
+
+                index_heap_push(heap, viz, custo);
+            }
+        }
+    }
+
+    if (status)
+        *status = motivo;
+
+    free(fechado);
+    free(eh_alvo);
+    index_heap_destroy(heap);
+
+    return expandidos;
+}
@@ -0,0 +1,63 @@
+
+#ifndef _DIJKSTRA_H_
+#define _DIJKSTRA_H_
+
+#include "labirinto.h"
+#include "terreno.h"
+
+// indica celula sem predecessor (a origem ou celulas nao alcancadas)
+#define DIRECAO_NENHUMA 255
+
+// retangulo do labirinto ao qual uma busca fica restrita
+typedef struct
+{
+    int linha_min;
+    int coluna_min;
+    int n_linhas;
+    int n_colunas;
+} Regiao;
+
+// regiao que cobre o labirinto inteiro
+Regiao regiao_labirinto(Labirinto *l);
+
+// indice local da celula (linha, coluna) nos vetores de uma regiao
+int regiao_indice(Regiao *r, int linha, int coluna);
+int regiao_contem(Regiao *r, int linha, int coluna);
+
+/**
+ * @brief Dijkstra de 8 vizinhos restrito a uma regiao, com o mesmo custo de
+ * _cell_distance (1 nas direcoes cardeais e sqrt(2) nas diagonais).
+ * @param dist
+ * Vetor com uma posicao por celula da regiao (ver regiao_indice). Recebe o
+ * custo a partir da origem, ou INFINITY para celulas nao alcancadas.
+ * @param dir
+ * Opcional (pode ser NULL). Recebe, para cada celula alcancada, o indice d em
+ * directions tal que celula + directions[d] e' o seu predecessor, ou
+ * DIRECAO_NENHUMA.
+ * @param alvos
+ * Opcional. Indices locais de celulas alvo: a busca para assim que todas
+ * forem fechadas. Com alvos == NULL a regiao inteira e' explorada.
+ * @return int
+ * Numero de nos expandidos.
+ */
+int dijkstra_regiao(Labirinto *l, Regiao regiao, int linha, int coluna, double *dist, unsigned char *dir, int *alvos, int n_alvos);
+
+// dijkstra_regiao que consulta o controle (opcional) a cada
+// BUSCA_INTERVALO_CONTROLE expansoes. status (opcional) recebe
+// BUSCA_CONCLUIDA ou o motivo da interrupcao; interrompida, a busca deixa em
+// dist e dir so' o que ja' tinha calculado (custos de celulas abertas podem
+// nao ser os minimos).
+int dijkstra_regiao_controlado(Labirinto *l, Regiao regiao, int linha, int coluna, double *dist, unsigned char *dir, int *alvos, int n_alvos, ControleBusca *controle, StatusBusca *status);
+
+// dijkstra_regiao com os custos de uma tabela de terreno (NULL para os
+// custos de dijkstra_regiao)
+int dijkstra_regiao_terreno(Labirinto *l, Regiao regiao, int linha, int coluna, TabelaTerreno *terreno, double *dist, unsigned char *dir, int *alvos, int n_alvos);
+
+// dijkstra_regiao_terreno a partir de varias origens ao mesmo tempo (indices
+// locais da regiao, todas com custo 0): dist recebe o custo ate a origem
+// mais proxima e dir leva de volta a ela. Origens fora da regiao ou
+// bloqueadas sao ignoradas. controle e status como em
+// dijkstra_regiao_controlado (ambos podem ser NULL).
+int dijkstra_regiao_origens(Labirinto *l, Regiao regiao, int *origens, int n_origens, TabelaTerreno *terreno, double *dist, unsigned char *dir, int *alvos, int n_alvos, ControleBusca *controle, StatusBusca *status);
+
+#endif
@@ -0,0 +1,535 @@
+#include <math.h>
+#include <stdlib.h>
+#include "hpa.h"
+#include "dijkstra.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+// passagens com pelo menos este numero de celulas ganham duas entradas
+// (uma em cada extremo) em vez de uma so no meio
+#define HPA_PASSAGEM_LONGA 6
+
+typedef struct
+{
+    int destino;
+    double custo;
+} ArestaHPA;
+
+typedef struct
+{
+    int linha, coluna, cluster;
+    ArestaHPA *arestas;
+    int n_arestas, cap_arestas;
+} NoHPA;
+
+struct Hierarquia
+{
+    Labirinto *l;
+    int tamanho_cluster;
+    int clusters_por_linha;
+    int n_clusters;
+
+    NoHPA *nos;
+    int n_nos, cap_nos, n_arestas;
+
+    // ids dos nos de cada cluster
+    int **nos_cluster;
+    int *n_nos_cluster;
+    int *cap_nos_cluster;
+};
+
+int _hpa_cluster(Hierarquia *h, int linha, int coluna)
+{
+    return (linha / h->tamanho_cluster) * h->clusters_por_linha + coluna / h->tamanho_cluster;
+}
+
+Regiao _hpa_regiao(Hierarquia *h, int cluster)
+{
+    Regiao r;
+    r.linha_min = (cluster / h->clusters_por_linha) * h->tamanho_cluster;
+    r.coluna_min = (cluster % h->clusters_por_linha) * h->tamanho_cluster;
+    r.n_linhas = h->l->n_linhas - r.linha_min < h->tamanho_cluster ? h->l->n_linhas - r.linha_min : h->tamanho_cluster;
+    r.n_colunas = h->l->n_colunas - r.coluna_min < h->tamanho_cluster ? h->l->n_colunas - r.coluna_min : h->tamanho_cluster;
+    return r;
+}
+
+void _hpa_adicionar_aresta(Hierarquia *h, int origem, int destino, double custo)
+{
+    NoHPA *no = &h->nos[origem];
+
+    for (int i = 0; i < no->n_arestas; i++)
+    {
+        if (no->arestas[i].destino == destino)
+        {
+            if (custo < no->arestas[i].custo)
+                no->arestas[i].custo = custo;
+            return;
+        }
+    }
+
+    if (no->n_arestas >= no->cap_arestas)
+    {
+        no->cap_arestas = no->cap_arestas ? 2 * no->cap_arestas : 4;
+        no->arestas = (ArestaHPA *)realloc(no->arestas, no->cap_arestas * sizeof(ArestaHPA));
+    }
+
+    no->arestas[no->n_arestas++] = (ArestaHPA){destino, custo};
+    h->n_arestas++;
+}
+
+// devolve o no da celula, criando-o se ainda nao existir
+int _hpa_no(Hierarquia *h, int linha, int coluna)
+{
+    int cluster = _hpa_cluster(h, linha, coluna);
+
+    for (int i = 0; i < h->n_nos_cluster[cluster]; i++)
+    {
+        NoHPA *no = &h->nos[h->nos_cluster[cluster][i]];
+
+        if (no->linha == linha && no->coluna == coluna)
+            return h->nos_cluster[cluster][i];
+    }
+
+    if (h->n_nos >= h->cap_nos)
+    {
+        h->cap_nos = h->cap_nos ? 2 * h->cap_nos : 64;
+        h->nos = (NoHPA *)realloc(h->nos, h->cap_nos * sizeof(NoHPA));
+    }
+
+    int id = h->n_nos++;
+    h->nos[id] = (NoHPA){linha, coluna, cluster, NULL, 0, 0};
+
+    if (h->n_nos_cluster[cluster] >= h->cap_nos_cluster[cluster])
+    {
+        h->cap_nos_cluster[cluster] = h->cap_nos_cluster[cluster] ? 2 * h->cap_nos_cluster[cluster] : 8;
+        h->nos_cluster[cluster] = (int *)realloc(h->nos_cluster[cluster], h->cap_nos_cluster[cluster] * sizeof(int));
+    }
+
+    h->nos_cluster[cluster][h->n_nos_cluster[cluster]++] = id;
+    return id;
+}
+
+void _hpa_entrada(Hierarquia *h, int linha_a, int coluna_a, int linha_b, int coluna_b)
+{
+    int a = _hpa_no(h, linha_a, coluna_a);
+    int b = _hpa_no(h, linha_b, coluna_b);
+    double custo = (linha_a != linha_b && coluna_a != coluna_b) ? M_SQRT2 : 1.0;
+
+    _hpa_adicionar_aresta(h, a, b, custo);
+    _hpa_adicionar_aresta(h, b, a, custo);
+}
+
+// passagem diagonal a -> b que so existe se as duas celulas que a
+// contornariam (c1 e c2) estiverem bloqueadas; caso contrario a ligacao ja e'
+// coberta pelas entradas retas
+void _hpa_entrada_diagonal(Hierarquia *h, int linha_a, int coluna_a, int linha_b, int coluna_b)
+{
+    Labirinto *l = h->l;
+
+    if (!_labirinto_bloqueado(l, linha_a, coluna_a) && !_labirinto_bloqueado(l, linha_b, coluna_b) &&
+        _labirinto_bloqueado(l, linha_a, coluna_b) && _labirinto_bloqueado(l, linha_b, coluna_a))
+        _hpa_entrada(h, linha_a, coluna_a, linha_b, coluna_b);
+}
+
+// percorre a fronteira entre dois clusters vizinhos. (linha, coluna) e' a
+// primeira celula do lado de la, (dl, dc) o passo ao longo da fronteira e
+// (ol, oc) o deslocamento ate a celula correspondente do outro lado
+void _hpa_fronteira(Hierarquia *h, int linha, int coluna, int comprimento, int dl, int dc, int ol, int oc)
+{
+    int inicio = -1;
+
+    for (int i = 0; i <= comprimento; i++)
+    {
+        int y = linha + i * dl, x = coluna + i * dc;
+        int livre = i < comprimento && !_labirinto_bloqueado(h->l, y, x) && !_labirinto_bloqueado(h->l, y + ol, x + oc);
+
+        if (livre && inicio < 0)
+            inicio = i;
+
+        if (!livre && inicio >= 0)
+        {
+            int fim = i - 1;
+
+            if (fim - inicio + 1 >= HPA_PASSAGEM_LONGA)
+            {
+                _hpa_entrada(h, linha + inicio * dl, coluna + inicio * dc, linha + inicio * dl + ol, coluna + inicio * dc + oc);
+                _hpa_entrada(h, linha + fim * dl, coluna + fim * dc, linha + fim * dl + ol, coluna + fim * dc + oc);
+            }
+            else
+            {
+                int meio = (inicio + fim) / 2;
+                _hpa_entrada(h, linha + meio * dl, coluna + meio * dc, linha + meio * dl + ol, coluna + meio * dc + oc);
+            }
+
+            inicio = -1;
+        }
+    }
+
+    // passagens em diagonal atraves da fronteira
+    for (int i = 0; i + 1 < comprimento; i++)
+    {
+        int y = linha + i * dl, x = coluna + i * dc;
+        _hpa_entrada_diagonal(h, y, x, y + dl + ol, x + dc + oc);
+        _hpa_entrada_diagonal(h, y + dl, x + dc, y + ol, x + oc);
+    }
+}
+
+void _hpa_arestas_internas(Hierarquia *h, int cluster, double *dist)
+{
+    Regiao r = _hpa_regiao(h, cluster);
+    int n = h->n_nos_cluster[cluster];
+    int *ids = h->nos_cluster[cluster];
+    int *alvos = (int *)malloc(n * sizeof(int));
+
+    for (int i = 0; i < n; i++)
+        alvos[i] = regiao_indice(&r, h->nos[ids[i]].linha, h->nos[ids[i]].coluna);
+
+    for (int i = 0; i < n; i++)
+    {
+        dijkstra_regiao(h->l, r, h->nos[ids[i]].linha, h->nos[ids[i]].coluna, dist, NULL, alvos, n);
+
+        for (int j = 0; j < n; j++)
+            if (j != i && dist[alvos[j]] < INFINITY)
+                _hpa_adicionar_aresta(h, ids[i], ids[j], dist[alvos[j]]);
+    }
+
+    free(alvos);
+}
+
+Hierarquia *hpa_construir(Labirinto *l, int tamanho_cluster)
+{
+    if (tamanho_cluster <= 0)
+        tamanho_cluster = HPA_TAMANHO_CLUSTER;
+
+    Hierarquia *h = (Hierarquia *)calloc(1, sizeof(Hierarquia));
+    h->l = l;
+    h->tamanho_cluster = tamanho_cluster;
+    h->clusters_por_linha = (l->n_colunas + tamanho_cluster - 1) / tamanho_cluster;
+    int clusters_por_coluna = (l->n_linhas + tamanho_cluster - 1) / tamanho_cluster;
+    h->n_clusters = h->clusters_por_linha * clusters_por_coluna;
+
+    h->nos_cluster = (int **)calloc(h->n_clusters, sizeof(int *));
+    h->n_nos_cluster = (int *)calloc(h->n_clusters, sizeof(int));
+    h->cap_nos_cluster = (int *)calloc(h->n_clusters, sizeof(int));
+
+    for (int cy = 0; cy < clusters_por_coluna; cy++)
+    {
+        for (int cx = 0; cx < h->clusters_por_linha; cx++)
+        {
+            int linha = cy * tamanho_cluster, coluna = cx * tamanho_cluster;
+            int altura = l->n_linhas - linha < tamanho_cluster ? l->n_linhas - linha : tamanho_cluster;
+            int largura = l->n_colunas - coluna < tamanho_cluster ? l->n_colunas - coluna : tamanho_cluster;
+
+            // fronteira com o cluster da direita
+            if (cx + 1 < h->clusters_por_linha)
+                _hpa_fronteira(h, linha, coluna + largura - 1, altura, 1, 0, 0, 1);
+
+            // fronteira com o cluster de baixo
+            if (cy + 1 < clusters_por_coluna)
+                _hpa_fronteira(h, linha + altura - 1, coluna, largura, 0, 1, 1, 0);
+
+            // passagens pelos cantos, entre clusters em diagonal
+            if (cx + 1 < h->clusters_por_linha && cy + 1 < clusters_por_coluna)
+            {
+                int y = linha + altura - 1, x = coluna + largura - 1;
+                _hpa_entrada_diagonal(h, y, x, y + 1, x + 1);
+                _hpa_entrada_diagonal(h, y, x + 1, y + 1, x);
+            }
+        }
+    }
+
+    double *dist = (double *)malloc(tamanho_cluster * tamanho_cluster * sizeof(double));
+
+    for (int c = 0; c < h->n_clusters; c++)
+        _hpa_arestas_internas(h, c, dist);
+
+    free(dist);
+    return h;
+}
+
+int hpa_n_nos(Hierarquia *h)
+{
+    return h->n_nos;
+}
+
+int hpa_n_arestas(Hierarquia *h)
+{
+    return h->n_arestas;
+}
+
+int _hpa_vizinhos(Hierarquia *h, int cluster_a, int cluster_b)
+{
+    int dl = cluster_a / h->clusters_por_linha - cluster_b / h->clusters_por_linha;
+    int dc = cluster_a % h->clusters_por_linha - cluster_b % h->clusters_por_linha;
+    return abs(dl) <= 1 && abs(dc) <= 1;
+}
+
+// menor retangulo que cobre os dois clusters (iguais ou vizinhos)
+Regiao _hpa_regiao_par(Hierarquia *h, int cluster_a, int cluster_b)
+{
+    Regiao a = _hpa_regiao(h, cluster_a), b = _hpa_regiao(h, cluster_b), r;
+    r.linha_min = a.linha_min < b.linha_min ? a.linha_min : b.linha_min;
+    r.coluna_min = a.coluna_min < b.coluna_min ? a.coluna_min : b.coluna_min;
+    int linha_max = a.linha_min + a.n_linhas > b.linha_min + b.n_linhas ? a.linha_min + a.n_linhas : b.linha_min + b.n_linhas;
+    int coluna_max = a.coluna_min + a.n_colunas > b.coluna_min + b.n_colunas ? a.coluna_min + a.n_colunas : b.coluna_min + b.n_colunas;
+    r.n_linhas = linha_max - r.linha_min;
+    r.n_colunas = coluna_max - r.coluna_min;
+    return r;
+}
+
+// liga uma celula de consulta aos nos do seu cluster. custos[i] recebe o
+// custo ate o i-esimo no do cluster.
+int _hpa_conectar(Hierarquia *h, Celula c, double *custos)
+{
+    int cluster = _hpa_cluster(h, c.y, c.x);
+    Regiao r = _hpa_regiao(h, cluster);
+    int n = h->n_nos_cluster[cluster];
+    int *alvos = (int *)malloc((n + 1) * sizeof(int));
+    double *dist = (double *)malloc((size_t)r.n_linhas * r.n_colunas * sizeof(double));
+
+    for (int i = 0; i < n; i++)
+        alvos[i] = regiao_indice(&r, h->nos[h->nos_cluster[cluster][i]].linha, h->nos[h->nos_cluster[cluster][i]].coluna);
+
+    int expandidos = dijkstra_regiao(h->l, r, c.y, c.x, dist, NULL, alvos, n);
+
+    for (int i = 0; i < n; i++)
+        custos[i] = dist[alvos[i]];
+
+    free(alvos);
+    free(dist);
+    return expandidos;
+}
+
+// custo de inicio ate fim sem sair dos seus clusters, quando eles sao iguais
+// ou vizinhos. Os nos de entrada so' veem os caminhos que cruzam a fronteira
+// por eles, entao duas celulas perto da fronteira podiam receber um desvio
+// muito maior que o caminho direto.
+int _hpa_direto(Hierarquia *h, Celula inicio, Celula fim, double *custo)
+{
+    Regiao r = _hpa_regiao_par(h, _hpa_cluster(h, inicio.y, inicio.x), _hpa_cluster(h, fim.y, fim.x));
+    double *dist = (double *)malloc((size_t)r.n_linhas * r.n_colunas * sizeof(double));
+    int alvo = regiao_indice(&r, fim.y, fim.x);
+
+    int expandidos = dijkstra_regiao(h->l, r, inicio.y, inicio.x, dist, NULL, &alvo, 1);
+    *custo = dist[alvo];
+
+    free(dist);
+    return expandidos;
+}
+
+// acrescenta ao caminho as celulas de a ate b (excluindo a), buscando dentro
+// dos clusters de ambos (o mesmo ou dois vizinhos)
+int _hpa_refinar(Hierarquia *h, Celula a, Celula b, Celula *caminho, int *tamanho)
+{
+    if (abs(a.x - b.x) <= 1 && abs(a.y - b.y) <= 1)
+    {
+        // aresta entre clusters ou celulas vizinhas: um passo so'
+        caminho[(*tamanho)++] = b;
+        return 0;
+    }
+
+    Regiao r = _hpa_regiao_par(h, _hpa_cluster(h, a.y, a.x), _hpa_cluster(h, b.y, b.x));
+    size_t n = (size_t)r.n_linhas * r.n_colunas;
+    double *dist = (double *)malloc(n * sizeof(double));
+    unsigned char *dir = (unsigned char *)malloc(n * sizeof(unsigned char));
+    int alvo = regiao_indice(&r, b.y, b.x);
+
+    int expandidos = dijkstra_regiao(h->l, r, a.y, a.x, dist, dir, &alvo, 1);
+
+    // volta do destino ate a origem e inverte o trecho
+    int inicio = *tamanho;
+    Celula c = b;
+
+    while (c.x != a.x || c.y != a.y)
+    {
+        caminho[(*tamanho)++] = c;
+        int d = dir[regiao_indice(&r, c.y, c.x)];
+        c.x += directions[d][0];
+        c.y += directions[d][1];
+    }
+
+    for (int i = inicio, j = *tamanho - 1; i < j; i++, j--)
+    {
+        Celula aux = caminho[i];
+        caminho[i] = caminho[j];
+        caminho[j] = aux;
+    }
+
+    free(dist);
+    free(dir);
+    return expandidos;
+}
+
+ResultData hpa_buscar(Hierarquia *h, Celula inicio, Celula fim, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+    Labirinto *l = h->l;
+
+    if (!_labirinto_livre(l, inicio.y, inicio.x) || !_labirinto_livre(l, fim.y, fim.x))
+        return result;
+
+    // o grafo abstrato da consulta tem os nos da hierarquia mais a origem
+    // (id N) e o destino (id N + 1), ligados sem alterar a hierarquia
+    int N = h->n_nos, ORIGEM = N, DESTINO = N + 1;
+    int cluster_inicio = _hpa_cluster(h, inicio.y, inicio.x);
+    int cluster_fim = _hpa_cluster(h, fim.y, fim.x);
+
+    double *custos_inicio = (double *)malloc((h->n_nos_cluster[cluster_inicio] + 1) * sizeof(double));
+    double *custos_fim = (double *)malloc((h->n_nos_cluster[cluster_fim] + 1) * sizeof(double));
+    double custo_direto = INFINITY;
+
+    result.nos_expandidos += _hpa_conectar(h, inicio, custos_inicio);
+    result.nos_expandidos += _hpa_conectar(h, fim, custos_fim);
+
+    if (_hpa_vizinhos(h, cluster_inicio, cluster_fim))
+        result.nos_expandidos += _hpa_direto(h, inicio, fim, &custo_direto);
+
+    // custo de cada no ate o destino (so os do cluster do destino)
+    double *ate_fim = (double *)malloc(N * sizeof(double));
+    for (int i = 0; i < N; i++)
+        ate_fim[i] = INFINITY;
+    for (int i = 0; i < h->n_nos_cluster[cluster_fim]; i++)
+        ate_fim[h->nos_cluster[cluster_fim][i]] = custos_fim[i];
+
+    double *g = (double *)malloc((N + 2) * sizeof(double));
+    int *prev = (int *)malloc((N + 2) * sizeof(int));
+    unsigned char *fechado = (unsigned char *)calloc(N + 2, sizeof(unsigned char));
+    IndexHeap *heap = index_heap_construct(N + 2);
+
+    for (int i = 0; i < N + 2; i++)
+    {
+        g[i] = INFINITY;
+        prev[i] = -1;
+    }
+
+    g[ORIGEM] = 0;
+    index_heap_push(heap, ORIGEM, _cell_distance(&inicio, &fim));
+
+    // nos_expandidos ja' traz as buscas locais de _hpa_conectar e
+    // _hpa_direto, entao o controle conta so' os nos do grafo abstrato
+    int abstratos = 0;
+
+    while (!index_heap_empty(heap))
+    {
+        if (abstratos++ % BUSCA_INTERVALO_CONTROLE == 0 && (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        int u = index_heap_pop(heap);
+        fechado[u] = 1;
+        result.nos_expandidos++;
+
+        if (u == DESTINO)
+            break;
+
+        // vizinhos de u: (id, custo)
+        int n_viz = 0;
+        int cap_viz = (u == ORIGEM ? h->n_nos_cluster[cluster_inicio] : h->nos[u].n_arestas) + 1;
+        ArestaHPA *viz = (ArestaHPA *)malloc(cap_viz * sizeof(ArestaHPA));
+
+        if (u == ORIGEM)
+        {
+            for (int i = 0; i < h->n_nos_cluster[cluster_inicio]; i++)
+                viz[n_viz++] = (ArestaHPA){h->nos_cluster[cluster_inicio][i], custos_inicio[i]};
+
+            viz[n_viz++] = (ArestaHPA){DESTINO, custo_direto};
+        }
+        else
+        {
+            for (int i = 0; i < h->nos[u].n_arestas; i++)
+                viz[n_viz++] = h->nos[u].arestas[i];
+
+            viz[n_viz++] = (ArestaHPA){DESTINO, ate_fim[u]};
+        }
+
+        for (int i = 0; i < n_viz; i++)
+        {
+            int v = viz[i].destino;
+            double custo = g[u] + viz[i].custo;
+
+            if (fechado[v] || !(custo < g[v]))
+                continue;
+
+            g[v] = custo;
+            prev[v] = u;
+
+            Celula cv = v == DESTINO ? fim : (Celula){h->nos[v].coluna, h->nos[v].linha, 0, 0, NULL};
+            index_heap_push(heap, v, custo + _cell_distance(&cv, &fim));
+        }
+
+        free(viz);
+    }
+
+    if (fechado[DESTINO])
+    {
+        // caminho abstrato, do destino para a origem
+        int n_abstrato = 0;
+        for (int v = DESTINO; v >= 0; v = prev[v])
+            n_abstrato++;
+
+        Celula *abstrato = (Celula *)calloc(n_abstrato, sizeof(Celula));
+        int i = n_abstrato;
+        for (int v = DESTINO; v >= 0; v = prev[v])
+        {
+            i--;
+            if (v == ORIGEM)
+                abstrato[i] = inicio;
+            else if (v == DESTINO)
+                abstrato[i] = fim;
+            else
+            {
+                abstrato[i].x = h->nos[v].coluna;
+                abstrato[i].y = h->nos[v].linha;
+            }
+        }
+
+        // cada trecho tem no maximo o numero de celulas de quatro clusters
+        int max_tamanho = 1 + (n_abstrato - 1) * 4 * h->tamanho_cluster * h->tamanho_cluster;
+        Celula *caminho = (Celula *)calloc(max_tamanho, sizeof(Celula));
+        int tamanho = 0;
+        caminho[tamanho++] = inicio;
+
+        for (i = 1; i < n_abstrato; i++)
+            if (abstrato[i].x != abstrato[i - 1].x || abstrato[i].y != abstrato[i - 1].y)
+                result.nos_expandidos += _hpa_refinar(h, abstrato[i - 1], abstrato[i], caminho, &tamanho);
+
+        result.sucesso = 1;
+        result.caminho = (Celula *)realloc(caminho, tamanho * sizeof(Celula));
+        result.tamanho_caminho = tamanho;
+
+        for (i = 0; i < tamanho; i++)
+        {
+            result.caminho[i].g = result.caminho[i].h = 0;
+            result.caminho[i].prev = NULL;
+
+            if (i > 0)
+                result.custo_caminho += _cell_distance(&result.caminho[i - 1], &result.caminho[i]);
+        }
+
+        free(abstrato);
+    }
+
+    free(custos_inicio);
+    free(custos_fim);
+    free(ate_fim);
+    free(g);
+    free(prev);
+    free(fechado);
+    index_heap_destroy(heap);
+
+    return result;
+}
+
+void hpa_destruir(Hierarquia *h)
+{
+    for (int i = 0; i < h->n_nos; i++)
+        free(h->nos[i].arestas);
+
+    for (int c = 0; c < h->n_clusters; c++)
+        free(h->nos_cluster[c]);
+
+    free(h->nos);
+    free(h->nos_cluster);
+    free(h->n_nos_cluster);
+    free(h->cap_nos_cluster);
+    free(h);
+}
@@ -0,0 +1,34 @@
+
+#ifndef _HPA_H_
+#define _HPA_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// tamanho padrao (em celulas) do lado de cada cluster
+#define HPA_TAMANHO_CLUSTER 16
+
+// Hierarquia no estilo HPA*: o labirinto e' dividido em clusters quadrados,
+// as passagens livres entre clusters vizinhos viram nos de entrada e as
+// distancias entre as entradas de um mesmo cluster sao pre-calculadas. A
+// hierarquia e' construida uma vez e pode responder varias consultas (ela nao
+// e' alterada pelas buscas). Se o labirinto mudar, ela deve ser reconstruida.
+typedef struct Hierarquia Hierarquia;
+
+Hierarquia *hpa_construir(Labirinto *l, int tamanho_cluster);
+
+// busca no grafo abstrato e refina apenas os trechos do caminho encontrado,
+// devolvendo todas as celulas em caminho. O caminho e' valido mas pode ser
+// ligeiramente mais longo que o otimo; com inicio e fim no mesmo cluster ou
+// em clusters vizinhos, ele nunca e' mais longo que o melhor caminho que fica
+// dentro desses clusters. Nao marca celulas no labirinto. O controle
+// (opcional) e' consultado a cada BUSCA_INTERVALO_CONTROLE nos do grafo
+// abstrato, como em a_star_controlado.
+ResultData hpa_buscar(Hierarquia *h, Celula inicio, Celula fim, ControleBusca *controle);
+
+int hpa_n_nos(Hierarquia *h);
+int hpa_n_arestas(Hierarquia *h);
+
+void hpa_destruir(Hierarquia *h);
+
+#endif
@@ -1,116 +1,784 @@
-
-#include <stdio.h>
-#include <stdlib.h>
-
-#include "labirinto.h"
-
-struct Labirinto
-{
-    int n_linhas;
-    int n_colunas;
-    unsigned char **celulas;
-};
-
-Labirinto *labirinto_carregar(char *arquivo)
-{
-    FILE *file = fopen(arquivo, "rb");
-
-    if (file == NULL)
-        exit(printf("Arquivo %s nao encontrado.\n", arquivo));
-
-    int n_linhas, n_colunas;
-    fread(&n_linhas, sizeof(int), 1, file);
-    fread(&n_colunas, sizeof(int), 1, file);
-
-    Labirinto *lab = (Labirinto *)malloc(sizeof(Labirinto));
-    lab->celulas = (unsigned char **)malloc(n_linhas * sizeof(unsigned char *));
-    lab->n_linhas = n_linhas;
-    lab->n_colunas = n_colunas;
-
-    for (int i = 0; i < n_linhas; i++)
-    {
-        lab->celulas[i] = (unsigned char *)malloc(n_colunas * sizeof(unsigned char));
-        fread(lab->celulas[i], sizeof(unsigned char), n_colunas, file);
-    }
-
-    fclose(file);
-    return lab;
-}
-
-int labirinto_n_linhas(Labirinto *l)
-{
-    return l->n_linhas;
-}
-
-int labirinto_n_colunas(Labirinto *l)
-{
-    return l->n_colunas;
-}
-
-void labirinto_atribuir(Labirinto *l, int linha, int coluna, TipoCelula valor)
-{
-    if (linha < 0 || linha >= l->n_linhas || coluna < 0 || coluna >= l->n_colunas)
-        exit(printf("Posição (%d, %d) inválida no labirinto com tamanho (%d, %d).\n", linha, coluna, l->n_linhas, l->n_colunas));
-
-    l->celulas[linha][coluna] = valor;
-}
-
-unsigned char labirinto_obter(Labirinto *l, int linha, int coluna)
-{
-    if (linha < 0 || linha >= l->n_linhas || coluna < 0 || coluna >= l->n_colunas)
-        exit(printf("Posição (%d, %d) inválida no labirinto com tamanho (%d, %d).\n", linha, coluna, l->n_linhas, l->n_colunas));
-
-    return l->celulas[linha][coluna];
-}
-
-void labirinto_destruir(Labirinto *l)
-{
-    for (int i = 0; i < l->n_linhas; i++)
-        free(l->celulas[i]);
-
-    free(l->celulas);
-    free(l);
-}
-
-void _labirinto_print_celula(unsigned char val)
-{
-    printf("\x1B[0m");
-    switch (val)
-    {
-    case LIVRE:
-        printf(". ");
-        break;
-    case OCUPADO:
-        printf("# ");
-        break;
-    case FRONTEIRA:
-        printf("\x1B[34mF ");
-        break;
-    case EXPANDIDO:
-        printf("\x1B[32mX ");
-        break;
-    case CAMINHO:
-        printf("\x1B[33mO ");
-        break;
-    case INICIO:
-        printf("\x1B[31mI ");
-        break;
-    case FIM:
-        printf("\x1B[31m[]");
-        break;
-    default:
-        printf("Tipo invalido de celula.\n");
-    }
-    printf("\x1B[0m");
-}
-
-void labirinto_print(Labirinto *l)
-{
-    for (int i = 0; i < l->n_linhas; i++)
-    {
-        printf("| ");
-        for (int j = 0; j < l->n_colunas; j++)
-            _labirinto_print_celula(labirinto_obter(l, i, j));
-        printf("|\n");
-    }
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "labirinto.h"
+#include "labirinto_interno.h"
+
+// Formato compactado: cabecalho com numero magico e versao, seguido de uma
+// tabela de offsets e de blocos de linhas que podem ser decodificados de
+// forma independente (cada um em uma thread).
+#define LABIRINTO_MAGICO "LABZ"
+#define LABIRINTO_VERSAO 1
+
+typedef enum
+{
+    BLOCO_BRUTO = 0,
+    BLOCO_BITS = 1,
+    BLOCO_RLE = 2
+} CodificacaoBloco;
+
+typedef struct
+{
+    Labirinto *lab;
+    unsigned char *dados;
+    long long *offsets;
+    int linhas_por_bloco;
+    int n_blocos;
+    int primeiro_bloco;
+    int passo;
+    int erro;
+} _TarefaDecodificacao;
+
+int _labirinto_ler_varint(unsigned char **p, unsigned char *fim, long long *valor)
+{
+    int desloc = 0;
+    *valor = 0;
+
+    while (*p < fim && desloc < 63)
+    {
+        unsigned char b = *(*p)++;
+        *valor |= (long long)(b & 0x7F) << desloc;
+
+        if (!(b & 0x80))
+            return 1;
+
+        desloc += 7;
+    }
+
+    return 0;
+}
+
+// decodifica as linhas [linha_ini, linha_fim) a partir do bloco [p, fim).
+// Retorna 0 se o bloco estiver corrompido.
+int _labirinto_decodificar_bloco(Labirinto *lab, unsigned char *p, unsigned char *fim, int linha_ini, int linha_fim)
+{
+    if (p >= fim)
+        return 0;
+
+    int n_colunas = lab->n_colunas;
+    CodificacaoBloco codificacao = *p++;
+
+    if (codificacao == BLOCO_BRUTO)
+    {
+        if (fim - p < (long long)(linha_fim - linha_ini) * n_colunas)
+            return 0;
+
+        for (int i = linha_ini; i < linha_fim; i++, p += n_colunas)
+            memcpy(_labirinto_celula(lab, i, 0), p, n_colunas);
+    }
+    else if (codificacao == BLOCO_BITS)
+    {
+        int bytes_linha = (n_colunas + 7) / 8;
+
+        if (fim - p < (long long)(linha_fim - linha_ini) * bytes_linha)
+            return 0;
+
+        for (int i = linha_ini; i < linha_fim; i++, p += bytes_linha)
+        {
+            unsigned char *linha = _labirinto_celula(lab, i, 0);
+
+            for (int j = 0; j < n_colunas; j++)
+                linha[j] = (p[j >> 3] >> (j & 7)) & 1;
+        }
+    }
+    else if (codificacao == BLOCO_RLE)
+    {
+        // corridas alternadas de LIVRE e OCUPADO, comecando por LIVRE
+        long long restante = (long long)(linha_fim - linha_ini) * n_colunas;
+        int linha = linha_ini, coluna = 0;
+        unsigned char valor = LIVRE;
+
+        while (restante > 0)
+        {
+            long long corrida;
+
+            if (!_labirinto_ler_varint(&p, fim, &corrida) || corrida > restante)
+                return 0;
+
+            restante -= corrida;
+
+            while (corrida > 0)
+            {
+                int n = n_colunas - coluna < corrida ? n_colunas - coluna : corrida;
+                memset(_labirinto_celula(lab, linha, coluna), valor, n);
+                corrida -= n;
+                coluna += n;
+
+                if (coluna == n_colunas)
+                {
+                    coluna = 0;
+                    linha++;
+                }
+            }
+
+            valor = (valor == LIVRE) ? OCUPADO : LIVRE;
+        }
+    }
+    else
+        return 0;
+
+    return 1;
+}
+
+void *_labirinto_decodificar_blocos(void *arg)
+{
+    _TarefaDecodificacao *t = (_TarefaDecodificacao *)arg;
+
+    for (int b = t->primeiro_bloco; b < t->n_blocos; b += t->passo)
+    {
+        int linha_ini = b * t->linhas_por_bloco;
+        int linha_fim = linha_ini + t->linhas_por_bloco;
+
+        if (linha_fim > t->lab->n_linhas)
+            linha_fim = t->lab->n_linhas;
+
+        if (!_labirinto_decodificar_bloco(t->lab, t->dados + t->offsets[b], t->dados + t->offsets[b + 1], linha_ini, linha_fim))
+            t->erro = 1;
+    }
+
+    return NULL;
+}
+
+// preenche as tabelas de deslocamento de l para o layout pedido
+void _labirinto_deslocamentos(Labirinto *l, LayoutLabirinto layout)
+{
+    for (int i = -1; i <= l->n_linhas; i++)
+    {
+        size_t r = i + 1;
+
+        if (layout == LAYOUT_BLOCOS)
+            l->desloc_linha[i] = (((r >> _LABIRINTO_BLOCO_BITS) * l->blocos_por_linha) << (2 * _LABIRINTO_BLOCO_BITS)) |
+                                 ((r & (LABIRINTO_BLOCO - 1)) << _LABIRINTO_BLOCO_BITS);
+        else
+            l->desloc_linha[i] = r * l->largura;
+    }
+
+    for (int j = -1; j <= l->n_colunas; j++)
+    {
+        size_t c = j + 1;
+
+        if (layout == LAYOUT_BLOCOS)
+            l->desloc_coluna[j] = ((c >> _LABIRINTO_BLOCO_BITS) << (2 * _LABIRINTO_BLOCO_BITS)) | (c & (LABIRINTO_BLOCO - 1));
+        else
+            l->desloc_coluna[j] = c;
+    }
+}
+
+Labirinto *_labirinto_alocar(int n_linhas, int n_colunas)
+{
+    Labirinto *lab = (Labirinto *)malloc(sizeof(Labirinto));
+    lab->n_linhas = n_linhas;
+    lab->n_colunas = n_colunas;
+
+    // a borda comeca OCUPADO; o interior e' preenchido pela carga
+    lab->largura = n_colunas + 2;
+    lab->layout = LAYOUT_LINHAS;
+    lab->blocos_por_linha = (lab->largura + LABIRINTO_BLOCO - 1) / LABIRINTO_BLOCO;
+    lab->celulas = (unsigned char *)malloc((size_t)(n_linhas + 2) * lab->largura * sizeof(unsigned char));
+    memset(lab->celulas, OCUPADO, (size_t)(n_linhas + 2) * lab->largura);
+
+    lab->palavras_por_linha = (lab->largura + 63) / 64;
+    lab->obstaculos = (uint64_t *)calloc((size_t)(n_linhas + 2) * lab->palavras_por_linha + 1, sizeof(uint64_t));
+
+    // + 1 para aceitar o indice -1 da borda
+    lab->desloc_linha = (size_t *)malloc((n_linhas + 2) * sizeof(size_t)) + 1;
+    lab->desloc_coluna = (size_t *)malloc((n_colunas + 2) * sizeof(size_t)) + 1;
+    _labirinto_deslocamentos(lab, LAYOUT_LINHAS);
+
+    return lab;
+}
+
+// valor de Zobrist de uma celula (ou das dimensoes): splitmix64 do indice
+uint64_t _labirinto_zobrist(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t _labirinto_zobrist_celula(Labirinto *lab, int linha, int coluna)
+{
+    return _labirinto_zobrist(((uint64_t)linha * lab->n_colunas + coluna) * 2 + 1);
+}
+
+// contribuicao ao hash de uma celula com o conteudo dado: nada para LIVRE,
+// o valor da celula para OCUPADO e um valor derivado dele para cada terreno
+uint64_t _labirinto_zobrist_conteudo(Labirinto *lab, int linha, int coluna, unsigned char conteudo)
+{
+    if (conteudo == LIVRE)
+        return 0;
+
+    uint64_t z = _labirinto_zobrist_celula(lab, linha, coluna);
+    return conteudo == OCUPADO ? z : _labirinto_zobrist(z ^ conteudo);
+}
+
+// conteudo da celula sem as marcas das buscas: OCUPADO ou o terreno
+unsigned char _labirinto_conteudo(Labirinto *lab, int linha, int coluna)
+{
+    return _labirinto_bloqueado(lab, linha, coluna) ? OCUPADO : _labirinto_terreno(lab, linha, coluna);
+}
+
+void _labirinto_construir_obstaculos(Labirinto *lab)
+{
+    lab->hash = _labirinto_zobrist(((uint64_t)lab->n_linhas << 32 | (uint32_t)lab->n_colunas) * 2);
+    memset(lab->n_conteudo, 0, sizeof(lab->n_conteudo));
+
+    for (int i = -1; i <= lab->n_linhas; i++)
+    {
+        uint64_t *linha = (uint64_t *)_labirinto_obstaculos_linha(lab, i);
+        unsigned char *celulas = _labirinto_celula(lab, i, -1);
+
+        // bits alem da borda direita tambem ficam bloqueados
+        for (int w = 0; w < lab->palavras_por_linha; w++)
+            linha[w] = 0;
+        for (int b = lab->largura; b < lab->palavras_por_linha * 64; b++)
+            linha[b >> 6] |= 1ULL << (b & 63);
+
+        for (int b = 0; b < lab->largura; b++)
+        {
+            int interior = i >= 0 && i < lab->n_linhas && b >= 1 && b <= lab->n_colunas;
+
+            if (celulas[b] == OCUPADO)
+            {
+                linha[b >> 6] |= 1ULL << (b & 63);
+
+                if (interior)
+                    lab->hash ^= _labirinto_zobrist_celula(lab, i, b - 1);
+            }
+            else if (celulas[b] >= TERRENO_MIN && interior)
+                lab->hash ^= _labirinto_zobrist_conteudo(lab, i, b - 1, celulas[b]);
+
+            if (interior)
+                lab->n_conteudo[_labirinto_conteudo(lab, i, b - 1)]++;
+        }
+    }
+}
+
+Labirinto *labirinto_criar(int n_linhas, int n_colunas)
+{
+    if (n_linhas < 0 || n_colunas < 0)
+        exit(printf("Tamanho (%d, %d) inválido para o labirinto.\n", n_linhas, n_colunas));
+
+    Labirinto *lab = _labirinto_alocar(n_linhas, n_colunas);
+
+    for (int i = 0; i < n_linhas; i++)
+        memset(_labirinto_celula(lab, i, 0), LIVRE, n_colunas);
+
+    _labirinto_construir_obstaculos(lab);
+    return lab;
+}
+
+Labirinto *_labirinto_carregar_compactado(FILE *file, char *arquivo)
+{
+    // versao, n_linhas, n_colunas, linhas_por_bloco e n_blocos
+    int cabecalho[5];
+
+    if (fread(cabecalho, sizeof(int), 5, file) != 5)
+        exit(printf("Arquivo %s: cabecalho compactado truncado.\n", arquivo));
+
+    int versao = cabecalho[0], n_linhas = cabecalho[1], n_colunas = cabecalho[2];
+    int linhas_por_bloco = cabecalho[3], n_blocos = cabecalho[4];
+
+    if (versao != LABIRINTO_VERSAO)
+        exit(printf("Arquivo %s: versao %d do formato compactado nao suportada.\n", arquivo, versao));
+
+    if (n_linhas < 0 || n_colunas < 0 || linhas_por_bloco <= 0 || n_blocos != ((long long)n_linhas + linhas_por_bloco - 1) / linhas_por_bloco)
+        exit(printf("Arquivo %s: cabecalho compactado invalido.\n", arquivo));
+
+    // o que resta do arquivo limita a tabela de blocos e os dados, antes de
+    // qualquer alocacao guiada por eles
+    long posicao = ftell(file);
+    fseek(file, 0, SEEK_END);
+    long long restante = ftell(file) - posicao;
+    fseek(file, posicao, SEEK_SET);
+
+    if (((long long)n_blocos + 1) * (long long)sizeof(long long) > restante)
+        exit(printf("Arquivo %s: tabela de blocos truncada.\n", arquivo));
+
+    long long *offsets = (long long *)malloc((n_blocos + 1) * sizeof(long long));
+
+    if (fread(offsets, sizeof(long long), n_blocos + 1, file) != (size_t)n_blocos + 1)
+        exit(printf("Arquivo %s: tabela de blocos truncada.\n", arquivo));
+
+    restante -= (n_blocos + 1) * (long long)sizeof(long long);
+
+    if (offsets[0] != 0 || offsets[n_blocos] > restante)
+        exit(printf("Arquivo %s: tabela de blocos invalida.\n", arquivo));
+
+    for (int b = 0; b < n_blocos; b++)
+        if (offsets[b] > offsets[b + 1])
+            exit(printf("Arquivo %s: tabela de blocos invalida.\n", arquivo));
+
+    unsigned char *dados = (unsigned char *)malloc(offsets[n_blocos] + 1);
+
+    if (fread(dados, 1, offsets[n_blocos], file) != (size_t)offsets[n_blocos])
+        exit(printf("Arquivo %s: dados compactados truncados.\n", arquivo));
+
+    Labirinto *lab = _labirinto_alocar(n_linhas, n_colunas);
+
+    int n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n_threads > n_blocos)
+        n_threads = n_blocos;
+    if (n_threads < 1)
+        n_threads = 1;
+
+    pthread_t *threads = (pthread_t *)malloc(n_threads * sizeof(pthread_t));
+    _TarefaDecodificacao *tarefas = (_TarefaDecodificacao *)malloc(n_threads * sizeof(_TarefaDecodificacao));
+
+    for (int t = 0; t < n_threads; t++)
+    {
+        tarefas[t] = (_TarefaDecodificacao){lab, dados, offsets, linhas_por_bloco, n_blocos, t, n_threads, 0};
+
+        if (t > 0)
+            pthread_create(&threads[t], NULL, _labirinto_decodificar_blocos, &tarefas[t]);
+    }
+
+    // a thread principal tambem decodifica a sua parte
+    _labirinto_decodificar_blocos(&tarefas[0]);
+
+    int erro = tarefas[0].erro;
+    for (int t = 1; t < n_threads; t++)
+    {
+        pthread_join(threads[t], NULL);
+        erro |= tarefas[t].erro;
+    }
+
+    free(threads);
+    free(tarefas);
+    free(offsets);
+    free(dados);
+
+    if (erro)
+        exit(printf("Arquivo %s: bloco compactado corrompido.\n", arquivo));
+
+    _labirinto_construir_obstaculos(lab);
+    return lab;
+}
+
+Labirinto *labirinto_carregar(char *arquivo)
+{
+    FILE *file = fopen(arquivo, "rb");
+
+    if (file == NULL)
+        exit(printf("Arquivo %s nao encontrado.\n", arquivo));
+
+    char magico[4] = {0};
+    fread(magico, sizeof(char), 4, file);
+
+    if (memcmp(magico, LABIRINTO_MAGICO, 4) == 0)
+    {
+        Labirinto *lab = _labirinto_carregar_compactado(file, arquivo);
+        fclose(file);
+        return lab;
+    }
+
+    // formato bruto: sem numero magico, um byte por celula
+    rewind(file);
+
+    int n_linhas, n_colunas;
+
+    if (fread(&n_linhas, sizeof(int), 1, file) != 1 || fread(&n_colunas, sizeof(int), 1, file) != 1 || n_linhas < 0 || n_colunas < 0)
+        exit(printf("Arquivo %s: cabecalho invalido.\n", arquivo));
+
+    Labirinto *lab = _labirinto_alocar(n_linhas, n_colunas);
+
+    for (int i = 0; i < n_linhas; i++)
+        if (fread(_labirinto_celula(lab, i, 0), sizeof(unsigned char), n_colunas, file) != (size_t)n_colunas)
+            exit(printf("Arquivo %s: celulas truncadas na linha %d.\n", arquivo, i));
+
+    fclose(file);
+    _labirinto_construir_obstaculos(lab);
+    return lab;
+}
+
+void _labirinto_escrever_varint(FILE *file, long long valor)
+{
+    do
+    {
+        unsigned char b = valor & 0x7F;
+        valor >>= 7;
+
+        if (valor)
+            b |= 0x80;
+
+        fputc(b, file);
+    } while (valor);
+}
+
+int _labirinto_tamanho_varint(long long valor)
+{
+    int n = 1;
+
+    while (valor >>= 7)
+        n++;
+
+    return n;
+}
+
+// tamanho em bytes do bloco [linha_ini, linha_fim) em cada codificacao
+long long _labirinto_tamanho_bloco(Labirinto *l, int linha_ini, int linha_fim, CodificacaoBloco codificacao)
+{
+    long long n_celulas = (long long)(linha_fim - linha_ini) * l->n_colunas;
+
+    if (codificacao == BLOCO_BRUTO)
+        return 1 + n_celulas;
+
+    if (codificacao == BLOCO_BITS)
+        return 1 + (long long)(linha_fim - linha_ini) * ((l->n_colunas + 7) / 8);
+
+    long long tamanho = 1, corrida = 0;
+    unsigned char valor = LIVRE;
+
+    for (int i = linha_ini; i < linha_fim; i++)
+    {
+        for (int j = 0; j < l->n_colunas; j++)
+        {
+            if (_labirinto_obter(l, i, j) != valor)
+            {
+                tamanho += _labirinto_tamanho_varint(corrida);
+                corrida = 0;
+                valor = (valor == LIVRE) ? OCUPADO : LIVRE;
+            }
+            corrida++;
+        }
+    }
+
+    if (corrida > 0)
+        tamanho += _labirinto_tamanho_varint(corrida);
+
+    return tamanho;
+}
+
+void _labirinto_escrever_bloco(FILE *file, Labirinto *l, int linha_ini, int linha_fim, CodificacaoBloco codificacao)
+{
+    fputc(codificacao, file);
+
+    if (codificacao == BLOCO_BRUTO)
+    {
+        unsigned char *buffer = (unsigned char *)malloc(l->n_colunas);
+
+        for (int i = linha_ini; i < linha_fim; i++)
+        {
+            for (int j = 0; j < l->n_colunas; j++)
+                buffer[j] = _labirinto_obter(l, i, j);
+
+            fwrite(buffer, sizeof(unsigned char), l->n_colunas, file);
+        }
+
+        free(buffer);
+    }
+    else if (codificacao == BLOCO_BITS)
+    {
+        int bytes_linha = (l->n_colunas + 7) / 8;
+        unsigned char *buffer = (unsigned char *)malloc(bytes_linha);
+
+        for (int i = linha_ini; i < linha_fim; i++)
+        {
+            memset(buffer, 0, bytes_linha);
+
+            for (int j = 0; j < l->n_colunas; j++)
+                if (_labirinto_obter(l, i, j) == OCUPADO)
+                    buffer[j >> 3] |= 1 << (j & 7);
+
+            fwrite(buffer, 1, bytes_linha, file);
+        }
+
+        free(buffer);
+    }
+    else
+    {
+        long long corrida = 0;
+        unsigned char valor = LIVRE;
+
+        for (int i = linha_ini; i < linha_fim; i++)
+        {
+            for (int j = 0; j < l->n_colunas; j++)
+            {
+                if (_labirinto_obter(l, i, j) != valor)
+                {
+                    _labirinto_escrever_varint(file, corrida);
+                    corrida = 0;
+                    valor = (valor == LIVRE) ? OCUPADO : LIVRE;
+                }
+                corrida++;
+            }
+        }
+
+        if (corrida > 0)
+            _labirinto_escrever_varint(file, corrida);
+    }
+}
+
+void labirinto_salvar_compactado(Labirinto *l, char *arquivo, int linhas_por_bloco)
+{
+    FILE *file = fopen(arquivo, "wb");
+
+    if (file == NULL)
+        exit(printf("Nao foi possivel criar o arquivo %s.\n", arquivo));
+
+    if (linhas_por_bloco <= 0)
+        linhas_por_bloco = LABIRINTO_LINHAS_POR_BLOCO;
+
+    int versao = LABIRINTO_VERSAO;
+    int n_blocos = (l->n_linhas + linhas_por_bloco - 1) / linhas_por_bloco;
+
+    // os blocos so podem usar bits ou RLE se o labirinto for binario
+    int binario = 1;
+    for (int i = 0; i < l->n_linhas && binario; i++)
+        for (int j = 0; j < l->n_colunas && binario; j++)
+            if (_labirinto_obter(l, i, j) != LIVRE && _labirinto_obter(l, i, j) != OCUPADO)
+                binario = 0;
+
+    CodificacaoBloco *codificacoes = (CodificacaoBloco *)malloc(n_blocos * sizeof(CodificacaoBloco));
+    long long *offsets = (long long *)malloc((n_blocos + 1) * sizeof(long long));
+    offsets[0] = 0;
+
+    for (int b = 0; b < n_blocos; b++)
+    {
+        int linha_ini = b * linhas_por_bloco;
+        int linha_fim = linha_ini + linhas_por_bloco < l->n_linhas ? linha_ini + linhas_por_bloco : l->n_linhas;
+
+        codificacoes[b] = BLOCO_BRUTO;
+        long long tamanho = _labirinto_tamanho_bloco(l, linha_ini, linha_fim, BLOCO_BRUTO);
+
+        if (binario)
+        {
+            // escolhe a codificacao mais compacta para o bloco
+            for (CodificacaoBloco c = BLOCO_BITS; c <= BLOCO_RLE; c++)
+            {
+                long long t = _labirinto_tamanho_bloco(l, linha_ini, linha_fim, c);
+
+                if (t < tamanho)
+                {
+                    tamanho = t;
+                    codificacoes[b] = c;
+                }
+            }
+        }
+
+        offsets[b + 1] = offsets[b] + tamanho;
+    }
+
+    fwrite(LABIRINTO_MAGICO, sizeof(char), 4, file);
+    fwrite(&versao, sizeof(int), 1, file);
+    fwrite(&l->n_linhas, sizeof(int), 1, file);
+    fwrite(&l->n_colunas, sizeof(int), 1, file);
+    fwrite(&linhas_por_bloco, sizeof(int), 1, file);
+    fwrite(&n_blocos, sizeof(int), 1, file);
+    fwrite(offsets, sizeof(long long), n_blocos + 1, file);
+
+    for (int b = 0; b < n_blocos; b++)
+    {
+        int linha_ini = b * linhas_por_bloco;
+        int linha_fim = linha_ini + linhas_por_bloco < l->n_linhas ? linha_ini + linhas_por_bloco : l->n_linhas;
+        _labirinto_escrever_bloco(file, l, linha_ini, linha_fim, codificacoes[b]);
+    }
+
+    free(codificacoes);
+    free(offsets);
+    fclose(file);
+}
+
+int labirinto_n_linhas(Labirinto *l)
+{
+    return l->n_linhas;
+}
+
+int labirinto_n_colunas(Labirinto *l)
+{
+    return l->n_colunas;
+}
+
+void labirinto_definir_layout(Labirinto *l, LayoutLabirinto layout)
+{
+    if (layout == l->layout)
+        return;
+
+    size_t tamanho;
+    if (layout == LAYOUT_BLOCOS)
+    {
+        int blocos_por_coluna = (l->n_linhas + 2 + LABIRINTO_BLOCO - 1) / LABIRINTO_BLOCO;
+        tamanho = (size_t)blocos_por_coluna * l->blocos_por_linha * LABIRINTO_BLOCO * LABIRINTO_BLOCO;
+    }
+    else
+        tamanho = (size_t)(l->n_linhas + 2) * l->largura;
+
+    Labirinto novo = *l;
+    novo.layout = layout;
+    novo.celulas = (unsigned char *)malloc(tamanho * sizeof(unsigned char));
+    novo.desloc_linha = (size_t *)malloc((l->n_linhas + 2) * sizeof(size_t)) + 1;
+    novo.desloc_coluna = (size_t *)malloc((l->n_colunas + 2) * sizeof(size_t)) + 1;
+    _labirinto_deslocamentos(&novo, layout);
+
+    // a area dos blocos que sobra alem da borda tambem fica OCUPADO
+    memset(novo.celulas, OCUPADO, tamanho);
+
+    for (int i = -1; i <= l->n_linhas; i++)
+        for (int j = -1; j <= l->n_colunas; j++)
+            *_labirinto_celula(&novo, i, j) = _labirinto_obter(l, i, j);
+
+    free(l->celulas);
+    free(l->desloc_linha - 1);
+    free(l->desloc_coluna - 1);
+    l->celulas = novo.celulas;
+    l->desloc_linha = novo.desloc_linha;
+    l->desloc_coluna = novo.desloc_coluna;
+    l->layout = layout;
+}
+
+LayoutLabirinto labirinto_layout(Labirinto *l)
+{
+    return l->layout;
+}
+
+void labirinto_atribuir(Labirinto *l, int linha, int coluna, TipoCelula valor)
+{
+    if (linha < 0 || linha >= l->n_linhas || coluna < 0 || coluna >= l->n_colunas)
+        exit(printf("Posição (%d, %d) inválida no labirinto com tamanho (%d, %d).\n", linha, coluna, l->n_linhas, l->n_colunas));
+
+    unsigned char conteudo = _labirinto_conteudo(l, linha, coluna);
+    uint64_t anterior = _labirinto_zobrist_conteudo(l, linha, coluna, conteudo);
+    unsigned char *c = _labirinto_celula(l, linha, coluna);
+
+    // marcas de busca (FRONTEIRA a FIM) nao apagam um terreno: o byte e' o
+    // unico lugar onde ele fica
+    if (valor == LIVRE || valor == OCUPADO || valor >= TERRENO_MIN || *c < TERRENO_MIN)
+        *c = valor;
+
+    uint64_t *palavra = (uint64_t *)_labirinto_obstaculos_linha(l, linha) + ((coluna + 1) >> 6);
+    uint64_t bit = 1ULL << ((coluna + 1) & 63);
+
+    if (valor == OCUPADO)
+        *palavra |= bit;
+    else
+        *palavra &= ~bit;
+
+    l->n_conteudo[conteudo]--;
+    conteudo = _labirinto_conteudo(l, linha, coluna);
+    l->n_conteudo[conteudo]++;
+
+    l->hash ^= anterior ^ _labirinto_zobrist_conteudo(l, linha, coluna, conteudo);
+}
+
+unsigned char labirinto_obter(Labirinto *l, int linha, int coluna)
+{
+    if (linha < 0 || linha >= l->n_linhas || coluna < 0 || coluna >= l->n_colunas)
+        exit(printf("Posição (%d, %d) inválida no labirinto com tamanho (%d, %d).\n", linha, coluna, l->n_linhas, l->n_colunas));
+
+    return _labirinto_obter(l, linha, coluna);
+}
+
+int labirinto_bloqueado(Labirinto *l, int linha, int coluna)
+{
+    if (linha < 0 || linha >= l->n_linhas || coluna < 0 || coluna >= l->n_colunas)
+        exit(printf("Posição (%d, %d) inválida no labirinto com tamanho (%d, %d).\n", linha, coluna, l->n_linhas, l->n_colunas));
+
+    return _labirinto_bloqueado(l, linha, coluna);
+}
+
+uint64_t labirinto_livres(Labirinto *l, int linha, int coluna)
+{
+    if (linha < 0 || linha >= l->n_linhas || coluna < 0 || coluna >= l->n_colunas)
+        exit(printf("Posição (%d, %d) inválida no labirinto com tamanho (%d, %d).\n", linha, coluna, l->n_linhas, l->n_colunas));
+
+    const uint64_t *palavras = _labirinto_obstaculos_linha(l, linha);
+    int w = (coluna + 1) >> 6, desloc = (coluna + 1) & 63;
+
+    // junta os bits de duas palavras vizinhas (a palavra extra alocada no fim
+    // de obstaculos torna a leitura de w + 1 sempre valida)
+    uint64_t ocupadas = palavras[w] >> desloc;
+    if (desloc)
+        ocupadas |= palavras[w + 1] << (64 - desloc);
+
+    // celulas alem da ultima coluna contam como bloqueadas
+    int restantes = l->n_colunas - coluna;
+    if (restantes < 64)
+        ocupadas |= ~0ULL << restantes;
+
+    return ~ocupadas;
+}
+
+const uint64_t *labirinto_obstaculos_linha(Labirinto *l, int linha)
+{
+    if (linha < 0 || linha >= l->n_linhas)
+        exit(printf("Linha %d inválida no labirinto com %d linhas.\n", linha, l->n_linhas));
+
+    return _labirinto_obstaculos_linha(l, linha);
+}
+
+uint64_t labirinto_hash(Labirinto *l)
+{
+    return l->hash;
+}
+
+void labirinto_limpar(Labirinto *l)
+{
+    for (int i = 0; i < l->n_linhas; i++)
+        for (int j = 0; j < l->n_colunas; j++)
+        {
+            unsigned char *c = _labirinto_celula(l, i, j);
+            if (*c > OCUPADO && *c < TERRENO_MIN)
+                *c = LIVRE;
+        }
+}
+
+void labirinto_destruir(Labirinto *l)
+{
+    free(l->celulas);
+    free(l->desloc_linha - 1);
+    free(l->desloc_coluna - 1);
+    free(l->obstaculos);
+    free(l);
+}
+
+void _labirinto_print_celula(unsigned char val)
+{
+    printf("\x1B[0m");
+    switch (val)
+    {
+    case LIVRE:
+        printf(". ");
+        break;
+    case OCUPADO:
+        printf("# ");
+        break;
+    case FRONTEIRA:
+        printf("\x1B[34mF ");
+        break;
+    case EXPANDIDO:
+        printf("\x1B[32mX ");
+        break;
+    case CAMINHO:
+        printf("\x1B[33mO ");
+        break;
+    case INICIO:
+        printf("\x1B[31mI ");
+        break;
+    case FIM:
+        printf("\x1B[31m[]");
+        break;
+    default:
+        // terreno: o byte em hexadecimal, que cabe nas duas colunas da celula
+        if (val >= TERRENO_MIN)
+            printf("\x1B[36m%02x", val);
+        else
+            printf("Tipo invalido de celula.\n");
+    }
+    printf("\x1B[0m");
+}
+
+void labirinto_print(Labirinto *l)
+{
+    for (int i = 0; i < l->n_linhas; i++)
+    {
+        printf("| ");
+        for (int j = 0; j < l->n_colunas; j++)
+            _labirinto_print_celula(labirinto_obter(l, i, j));
+        printf("|\n");
+    }
 }
\ No newline at end of file
@@ -1,26 +1,88 @@
-
-#ifndef _LABIRINTO_H_
-#define _LABIRINTO_H_
-
-typedef enum
-{
-    LIVRE = 0,
-    OCUPADO = 1,
-    FRONTEIRA = 2,
-    EXPANDIDO = 3,
-    CAMINHO = 4,
-    INICIO = 5,
-    FIM = 6
-} TipoCelula;
-
-typedef struct Labirinto Labirinto;
-
-Labirinto *labirinto_carregar(char *arquivo);
-int labirinto_n_linhas(Labirinto *l);
-int labirinto_n_colunas(Labirinto *l);
-void labirinto_atribuir(Labirinto *l, int linha, int coluna, TipoCelula valor);
-unsigned char labirinto_obter(Labirinto *l, int linha, int coluna);
-void labirinto_print(Labirinto *l);
-void labirinto_destruir(Labirinto *l);
-
+
+#ifndef _LABIRINTO_H_
+#define _LABIRINTO_H_
+
+#include <stdint.h>
+
+typedef enum
+{
+    LIVRE = 0,
+    OCUPADO = 1,
+    FRONTEIRA = 2,
+    EXPANDIDO = 3,
+    CAMINHO = 4,
+    INICIO = 5,
+    FIM = 6
+} TipoCelula;
+
+// Bytes a partir de TERRENO_MIN sao celulas livres com um tipo de terreno
+// (lama, estrada, rampa...), que as buscas de terreno.h traduzem em custo de
+// travessia; as outras buscas os tratam como LIVRE. Os valores entre FIM e
+// TERRENO_MIN ficam reservados. Terrenos sao gravados com labirinto_atribuir
+// no proprio byte da celula; as marcas das buscas (FRONTEIRA a FIM) so' sao
+// gravadas em celulas sem terreno, que nao o perdem.
+#define TERRENO_MIN 16
+
+typedef struct Labirinto Labirinto;
+
+// organizacao das celulas na memoria: linha a linha (padrao) ou em blocos
+// contiguos de LABIRINTO_BLOCO x LABIRINTO_BLOCO celulas, que deixam os
+// vizinhos de cima e de baixo perto uns dos outros em mapas largos
+typedef enum
+{
+    LAYOUT_LINHAS = 0,
+    LAYOUT_BLOCOS = 1
+} LayoutLabirinto;
+
+#define LABIRINTO_BLOCO 64
+
+// numero padrao de linhas por bloco no formato compactado
+#define LABIRINTO_LINHAS_POR_BLOCO 256
+
+// cria um labirinto com todas as celulas LIVRE
+Labirinto *labirinto_criar(int n_linhas, int n_colunas);
+
+// carrega tanto o formato bruto (um byte por celula) quanto o compactado
+Labirinto *labirinto_carregar(char *arquivo);
+
+// salva no formato compactado ("LABZ"), com blocos independentes de
+// linhas_por_bloco linhas codificados como bytes, bits ou RLE (o menor).
+// Se linhas_por_bloco <= 0, usa LABIRINTO_LINHAS_POR_BLOCO.
+void labirinto_salvar_compactado(Labirinto *l, char *arquivo, int linhas_por_bloco);
+int labirinto_n_linhas(Labirinto *l);
+int labirinto_n_colunas(Labirinto *l);
+
+// reorganiza as celulas no layout pedido. Os labirintos sao criados e
+// carregados em LAYOUT_LINHAS; o mapa de bits de obstaculos e' sempre por linha.
+void labirinto_definir_layout(Labirinto *l, LayoutLabirinto layout);
+LayoutLabirinto labirinto_layout(Labirinto *l);
+void labirinto_atribuir(Labirinto *l, int linha, int coluna, TipoCelula valor);
+unsigned char labirinto_obter(Labirinto *l, int linha, int coluna);
+
+// consultas ao mapa de bits de obstaculos (1 bit por celula), construido na
+// carga e atualizado por labirinto_atribuir. As buscas usam estas funcoes
+// para decidir se um vizinho e' transitavel.
+int labirinto_bloqueado(Labirinto *l, int linha, int coluna);
+
+// mascara das 64 celulas a partir de (linha, coluna): o bit k vale 1 se a
+// celula (linha, coluna + k) esta livre. Colunas fora do mapa valem 0.
+uint64_t labirinto_livres(Labirinto *l, int linha, int coluna);
+
+// palavras de 64 bits da linha, incluindo a borda: o bit j da palavra w
+// corresponde a coluna 64 * w + j - 1 (o bit 0 e' a borda esquerda)
+const uint64_t *labirinto_obstaculos_linha(Labirinto *l, int linha);
+
+// hash do conteudo no estilo Zobrist: cada celula tem um valor pseudoaleatorio
+// fixo e o hash e' o XOR dos valores das celulas OCUPADO, dos valores
+// derivados (celula, terreno) das celulas com terreno e das dimensoes.
+// labirinto_atribuir o atualiza em O(1); as marcas das buscas nao o alteram.
+uint64_t labirinto_hash(Labirinto *l);
+
+// apaga as marcas deixadas pelas buscas (FRONTEIRA, EXPANDIDO, CAMINHO,
+// INICIO e FIM), para reutilizar o labirinto em outra consulta: cada celula
+// marcada volta a LIVRE. Obstaculos e terrenos ficam como estao.
+void labirinto_limpar(Labirinto *l);
+void labirinto_print(Labirinto *l);
+void labirinto_destruir(Labirinto *l);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,133 @@
+
+#ifndef _LABIRINTO_INTERNO_H_
+#define _LABIRINTO_INTERNO_H_
+
+// Representacao interna do Labirinto, compartilhada apenas entre os modulos
+// de busca. Codigo externo deve usar a API checada de labirinto.h.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "labirinto.h"
+
+// A grade guarda uma borda de uma celula OCUPADO em volta do mapa, tanto nos
+// bytes quanto no mapa de bits. Assim as coordenadas -1 e n_linhas/n_colunas
+// sao acessiveis e sempre bloqueadas, e os motores de busca podem olhar os 8
+// vizinhos de qualquer celula do mapa sem testar limites.
+struct Labirinto
+{
+    int n_linhas;
+    int n_colunas;
+
+    // (n_linhas + 2) x (n_colunas + 2) bytes; largura = n_colunas + 2. Em
+    // LAYOUT_LINHAS os bytes ficam linha a linha; em LAYOUT_BLOCOS ficam em
+    // blocos contiguos de LABIRINTO_BLOCO x LABIRINTO_BLOCO celulas
+    unsigned char *celulas;
+    int largura;
+    LayoutLabirinto layout;
+    int blocos_por_linha;
+
+    // o indice de (linha, coluna) em celulas, nos dois layouts, e'
+    // desloc_linha[linha] + desloc_coluna[coluna]: no de blocos os bits do
+    // bloco e da posicao dentro dele se separam em uma parte da linha e uma
+    // da coluna. Os vetores aceitam os indices -1 da borda.
+    size_t *desloc_linha;
+    size_t *desloc_coluna;
+
+    // mascara derivada de obstaculos (1 bit por celula, 1 = OCUPADO), com a
+    // mesma borda, mantida em sincronia por labirinto_atribuir
+    uint64_t *obstaculos;
+    int palavras_por_linha;
+
+    // hash do conteudo (ver labirinto_hash), mantido junto com obstaculos
+    uint64_t hash;
+
+    // numero de celulas do mapa com cada conteudo (OCUPADO, LIVRE ou um
+    // terreno; as marcas contam como LIVRE), mantido junto com o hash. As
+    // buscas de terreno escalam a heuristica pelo menor custo presente.
+    size_t n_conteudo[256];
+};
+
+// Acessores sem checagem de limites: validos para -1 <= linha <= n_linhas e
+// -1 <= coluna <= n_colunas.
+
+#define _LABIRINTO_BLOCO_BITS 6
+
+// sem desvio pelo layout: as tabelas de deslocamento ja' o codificam
+static inline size_t _labirinto_indice(Labirinto *l, int linha, int coluna)
+{
+    return l->desloc_linha[linha] + l->desloc_coluna[coluna];
+}
+
+static inline unsigned char *_labirinto_celula(Labirinto *l, int linha, int coluna)
+{
+    return l->celulas + _labirinto_indice(l, linha, coluna);
+}
+
+static inline unsigned char _labirinto_obter(Labirinto *l, int linha, int coluna)
+{
+    return *_labirinto_celula(l, linha, coluna);
+}
+
+// marca estados de busca (FRONTEIRA, EXPANDIDO, ...) em celulas livres, para
+// labirinto_print. Celulas com terreno ficam como estao: o byte e' o unico
+// lugar do terreno, e as buscas nao leem as marcas (o estado delas fica em
+// vetores proprios). Nao atualiza o mapa de bits, portanto nao deve ser
+// usado com OCUPADO.
+static inline void _labirinto_marcar(Labirinto *l, int linha, int coluna, TipoCelula valor)
+{
+    unsigned char *c = _labirinto_celula(l, linha, coluna);
+
+    if (*c < TERRENO_MIN)
+        *c = valor;
+}
+
+static inline const uint64_t *_labirinto_obstaculos_linha(Labirinto *l, int linha)
+{
+    return l->obstaculos + (size_t)(linha + 1) * l->palavras_por_linha;
+}
+
+static inline int _labirinto_bloqueado(Labirinto *l, int linha, int coluna)
+{
+    int bit = coluna + 1;
+    return (_labirinto_obstaculos_linha(l, linha)[bit >> 6] >> (bit & 63)) & 1;
+}
+
+// terreno de uma celula livre (LIVRE ou >= TERRENO_MIN); as marcas de busca
+// so' ocupam celulas LIVRE e contam como LIVRE
+static inline unsigned char _labirinto_terreno(Labirinto *l, int linha, int coluna)
+{
+    unsigned char c = _labirinto_obter(l, linha, coluna);
+    return c >= TERRENO_MIN ? c : LIVRE;
+}
+
+// conjunto de celulas de uma busca (1 bit por celula, linha a linha, sem
+// borda), para as buscas que antes usavam as marcas como estado
+static inline uint64_t *_labirinto_conjunto_criar(Labirinto *l)
+{
+    return (uint64_t *)calloc(((size_t)l->n_linhas * l->n_colunas + 63) / 64, sizeof(uint64_t));
+}
+
+static inline int _labirinto_conjunto_contem(Labirinto *l, uint64_t *conjunto, int linha, int coluna)
+{
+    size_t i = (size_t)linha * l->n_colunas + coluna;
+    return (conjunto[i >> 6] >> (i & 63)) & 1;
+}
+
+static inline void _labirinto_conjunto_inserir(Labirinto *l, uint64_t *conjunto, int linha, int coluna)
+{
+    size_t i = (size_t)linha * l->n_colunas + coluna;
+    conjunto[i >> 6] |= 1ULL << (i & 63);
+}
+
+// validacao dos pontos de entrada das buscas (fora dos lacos, com limites)
+static inline int _labirinto_dentro(Labirinto *l, int linha, int coluna)
+{
+    return linha >= 0 && coluna >= 0 && linha < l->n_linhas && coluna < l->n_colunas;
+}
+
+static inline int _labirinto_livre(Labirinto *l, int linha, int coluna)
+{
+    return _labirinto_dentro(l, linha, coluna) && !_labirinto_bloqueado(l, linha, coluna);
+}
+
+#endif
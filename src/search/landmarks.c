@@ -0,0 +1,251 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "landmarks.h"
+#include "dijkstra.h"
+#include "labirinto_interno.h"
+
+#define LANDMARKS_MAGICO "LALT"
+#define LANDMARKS_VERSAO 1
+
+// as tabelas guardam float para ocupar metade da memoria; ao comparar dois
+// valores arredondados, descontamos esta folga relativa para nao
+// superestimar a distancia (o erro de um float e' ~6e-8 do valor)
+#define LANDMARKS_FOLGA 1e-6
+
+struct Landmarks
+{
+    int k;
+    int n_linhas;
+    int n_colunas;
+
+    // coordenadas (x, y) de cada landmark
+    int *coordenadas;
+
+    // distancias celula a celula, com os k valores de cada celula juntos:
+    // tabelas[(linha * n_colunas + coluna) * k + i]
+    float *tabelas;
+
+    // regiao mapeada quando carregado de arquivo (NULL se construido)
+    void *mapa;
+    size_t tamanho_mapa;
+};
+
+typedef struct
+{
+    char magico[4];
+    int versao;
+    int n_linhas;
+    int n_colunas;
+    int k;
+} _CabecalhoLandmarks;
+
+Landmarks *landmarks_construir(Labirinto *l, int k)
+{
+    if (k <= 0)
+        k = LANDMARKS_PADRAO;
+
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+    Regiao regiao = regiao_labirinto(l);
+
+    Landmarks *lm = (Landmarks *)calloc(1, sizeof(Landmarks));
+    lm->n_linhas = l->n_linhas;
+    lm->n_colunas = l->n_colunas;
+    lm->coordenadas = (int *)malloc(2 * k * sizeof(int));
+    lm->tabelas = (float *)malloc(n * k * sizeof(float));
+
+    double *dist = (double *)malloc(n * sizeof(double));
+    double *menor = (double *)malloc(n * sizeof(double));
+
+    // ponto de partida: a primeira celula livre. O primeiro landmark e' a
+    // celula mais distante dela, e cada seguinte a mais distante dos anteriores
+    int atual = -1;
+    for (int i = 0; (size_t)i < n && atual < 0; i++)
+        if (!_labirinto_bloqueado(l, i / l->n_colunas, i % l->n_colunas))
+            atual = i;
+
+    if (atual < 0)
+    {
+        free(dist);
+        free(menor);
+        lm->k = 0;
+        return lm;
+    }
+
+    dijkstra_regiao(l, regiao, atual / l->n_colunas, atual % l->n_colunas, dist, NULL, NULL, 0);
+    for (size_t i = 0; i < n; i++)
+        menor[i] = dist[i];
+
+    while (lm->k < k)
+    {
+        int escolhida = -1;
+        for (size_t i = 0; i < n; i++)
+            if (menor[i] < INFINITY && (escolhida < 0 || menor[i] > menor[escolhida]))
+                escolhida = i;
+
+        // todas as celulas alcancaveis ja sao landmarks
+        if (escolhida < 0 || (lm->k > 0 && menor[escolhida] == 0))
+            break;
+
+        dijkstra_regiao(l, regiao, escolhida / l->n_colunas, escolhida % l->n_colunas, dist, NULL, NULL, 0);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            lm->tabelas[(size_t)i * k + lm->k] = dist[i];
+
+            // na primeira iteracao menor[] ainda guarda as distancias do ponto
+            // de partida, que nao e' um landmark
+            if (lm->k == 0 || dist[i] < menor[i])
+                menor[i] = dist[i];
+        }
+
+        lm->coordenadas[2 * lm->k] = escolhida % l->n_colunas;
+        lm->coordenadas[2 * lm->k + 1] = escolhida / l->n_colunas;
+        lm->k++;
+    }
+
+    // se sobraram menos landmarks que o pedido, compacta as tabelas
+    if (lm->k < k)
+    {
+        for (size_t i = 0; i < n; i++)
+            for (int j = 0; j < lm->k; j++)
+                lm->tabelas[(size_t)i * lm->k + j] = lm->tabelas[(size_t)i * k + j];
+    }
+
+    free(dist);
+    free(menor);
+    return lm;
+}
+
+void landmarks_salvar(Landmarks *lm, char *arquivo)
+{
+    FILE *file = fopen(arquivo, "wb");
+
+    if (file == NULL)
+        exit(printf("Nao foi possivel criar o arquivo %s.\n", arquivo));
+
+    _CabecalhoLandmarks cabecalho;
+    memcpy(cabecalho.magico, LANDMARKS_MAGICO, 4);
+    cabecalho.versao = LANDMARKS_VERSAO;
+    cabecalho.n_linhas = lm->n_linhas;
+    cabecalho.n_colunas = lm->n_colunas;
+    cabecalho.k = lm->k;
+
+    fwrite(&cabecalho, sizeof(_CabecalhoLandmarks), 1, file);
+    fwrite(lm->coordenadas, sizeof(int), 2 * lm->k, file);
+    fwrite(lm->tabelas, sizeof(float), (size_t)lm->n_linhas * lm->n_colunas * lm->k, file);
+    fclose(file);
+}
+
+Landmarks *landmarks_mapear(char *arquivo, Labirinto *l)
+{
+    int fd = open(arquivo, O_RDONLY);
+
+    if (fd < 0)
+        exit(printf("Arquivo %s nao encontrado.\n", arquivo));
+
+    struct stat info;
+    fstat(fd, &info);
+
+    if ((size_t)info.st_size < sizeof(_CabecalhoLandmarks))
+        exit(printf("Arquivo %s: landmarks truncados.\n", arquivo));
+
+    void *mapa = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (mapa == MAP_FAILED)
+        exit(printf("Nao foi possivel mapear o arquivo %s.\n", arquivo));
+
+    _CabecalhoLandmarks *cabecalho = (_CabecalhoLandmarks *)mapa;
+
+    if (memcmp(cabecalho->magico, LANDMARKS_MAGICO, 4) != 0 || cabecalho->versao != LANDMARKS_VERSAO)
+        exit(printf("Arquivo %s: formato de landmarks invalido.\n", arquivo));
+
+    if (cabecalho->n_linhas != l->n_linhas || cabecalho->n_colunas != l->n_colunas)
+        exit(printf("Arquivo %s: landmarks de um labirinto (%d, %d), esperado (%d, %d).\n", arquivo,
+                    cabecalho->n_linhas, cabecalho->n_colunas, l->n_linhas, l->n_colunas));
+
+    size_t esperado = sizeof(_CabecalhoLandmarks) + 2 * cabecalho->k * sizeof(int) +
+                      (size_t)cabecalho->n_linhas * cabecalho->n_colunas * cabecalho->k * sizeof(float);
+
+    if ((size_t)info.st_size < esperado)
+        exit(printf("Arquivo %s: landmarks truncados.\n", arquivo));
+
+    Landmarks *lm = (Landmarks *)calloc(1, sizeof(Landmarks));
+    lm->k = cabecalho->k;
+    lm->n_linhas = cabecalho->n_linhas;
+    lm->n_colunas = cabecalho->n_colunas;
+    lm->coordenadas = (int *)(cabecalho + 1);
+    lm->tabelas = (float *)(lm->coordenadas + 2 * lm->k);
+    lm->mapa = mapa;
+    lm->tamanho_mapa = info.st_size;
+
+    return lm;
+}
+
+int landmarks_n(Landmarks *lm)
+{
+    return lm->k;
+}
+
+Celula landmarks_obter(Landmarks *lm, int i)
+{
+    Celula c = {0};
+    c.x = lm->coordenadas[2 * i];
+    c.y = lm->coordenadas[2 * i + 1];
+    return c;
+}
+
+double heuristica_alt(Celula *c, Celula *fim, void *contexto)
+{
+    Landmarks *lm = (Landmarks *)contexto;
+    double h = _cell_distance(c, fim);
+
+    if (c->x < 0 || c->y < 0 || c->x >= lm->n_colunas || c->y >= lm->n_linhas ||
+        fim->x < 0 || fim->y < 0 || fim->x >= lm->n_colunas || fim->y >= lm->n_linhas)
+        return h;
+
+    float *dc = lm->tabelas + ((size_t)c->y * lm->n_colunas + c->x) * lm->k;
+    float *df = lm->tabelas + ((size_t)fim->y * lm->n_colunas + fim->x) * lm->k;
+
+    for (int i = 0; i < lm->k; i++)
+    {
+        // celula e destino em componentes diferentes: fim e' inalcancavel
+        if ((dc[i] < INFINITY) != (df[i] < INFINITY))
+            return INFINITY;
+
+        if (dc[i] == INFINITY)
+            continue;
+
+        double maior = dc[i] > df[i] ? dc[i] : df[i];
+        double limite = fabs((double)df[i] - dc[i]) - LANDMARKS_FOLGA * maior;
+
+        if (limite > h)
+            h = limite;
+    }
+
+    return h;
+}
+
+ResultData a_star_alt(Labirinto *l, Celula inicio, Celula fim, Landmarks *lm, ControleBusca *controle)
+{
+    return a_star_heuristica(l, inicio, fim, heuristica_alt, lm, controle);
+}
+
+void landmarks_destruir(Landmarks *lm)
+{
+    if (lm->mapa)
+        munmap(lm->mapa, lm->tamanho_mapa);
+    else
+    {
+        free(lm->coordenadas);
+        free(lm->tabelas);
+    }
+
+    free(lm);
+}
@@ -0,0 +1,38 @@
+
+#ifndef _LANDMARKS_H_
+#define _LANDMARKS_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+#define LANDMARKS_PADRAO 8
+
+// Tabelas de distancias exatas a partir de K celulas de referencia
+// (landmarks), usadas pela heuristica ALT: pela desigualdade triangular,
+// |d(L, fim) - d(L, c)| <= d(c, fim) para qualquer landmark L.
+typedef struct Landmarks Landmarks;
+
+// escolhe k landmarks por "ponto mais distante" (cada novo landmark e' a
+// celula alcancavel mais longe dos ja escolhidos) e calcula as tabelas
+Landmarks *landmarks_construir(Labirinto *l, int k);
+
+// salva as tabelas em disco para serem mapeadas com landmarks_mapear
+void landmarks_salvar(Landmarks *lm, char *arquivo);
+
+// mapeia em memoria (somente leitura) um arquivo de landmarks_salvar. O
+// arquivo deve ter sido gerado para um labirinto do mesmo tamanho de l.
+Landmarks *landmarks_mapear(char *arquivo, Labirinto *l);
+
+int landmarks_n(Landmarks *lm);
+Celula landmarks_obter(Landmarks *lm, int i);
+
+// heuristica ALT (o maximo entre a distancia euclidiana e os limites dos
+// landmarks); o contexto e' o Landmarks*
+double heuristica_alt(Celula *c, Celula *fim, void *contexto);
+
+// A* com a heuristica ALT; controle e' opcional, como em a_star_controlado
+ResultData a_star_alt(Labirinto *l, Celula inicio, Celula fim, Landmarks *lm, ControleBusca *controle);
+
+void landmarks_destruir(Landmarks *lm);
+
+#endif
@@ -0,0 +1,555 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "memoria.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+// tolerancia para comparar somas de custos em ponto flutuante
+#define MEMORIA_FOLGA 1e-9
+
+// fracao minima de aumento do limite de f entre iteracoes do IDA*. Com custos
+// reais quase todo f e' distinto, e subir apenas ate o proximo f exigiria uma
+// iteracao por valor; a otimalidade e' mantida podando pelo melhor caminho
+#define MEMORIA_IDA_CRESCIMENTO 0.1
+
+double _memoria_h(int celula, int n_colunas, Celula *fim)
+{
+    double dx = celula % n_colunas - fim->x;
+    double dy = celula / n_colunas - fim->y;
+    return sqrt(dx * dx + dy * dy);
+}
+
+unsigned int _memoria_hash(int celula)
+{
+    return (unsigned int)celula * 2654435761u;
+}
+
+int _memoria_potencia_2(int n)
+{
+    int p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+ResultData _memoria_caminho(Labirinto *l, int *celulas, int tamanho, int expandidos)
+{
+    ResultData result = _default_result();
+    result.caminho = (Celula *)calloc(tamanho, sizeof(Celula));
+    result.tamanho_caminho = tamanho;
+    result.nos_expandidos = expandidos;
+    result.sucesso = 1;
+
+    for (int i = 0; i < tamanho; i++)
+    {
+        result.caminho[i].x = celulas[i] % l->n_colunas;
+        result.caminho[i].y = celulas[i] / l->n_colunas;
+
+        if (i > 0)
+            result.custo_caminho += _cell_distance(&result.caminho[i - 1], &result.caminho[i]);
+    }
+
+    return result;
+}
+
+int _memoria_validos(Labirinto *l, Celula inicio, Celula fim)
+{
+    return _labirinto_livre(l, inicio.y, inicio.x) && _labirinto_livre(l, fim.y, fim.x);
+}
+
+// ---------------------------------------------------------------- IDA*
+
+typedef struct
+{
+    int celula;
+    int iteracao;
+    double g;
+} _EntradaCache;
+
+// um nivel da busca em profundidade: a celula, o seu g e o proximo vizinho
+typedef struct
+{
+    int celula;
+    double g;
+    int direcao;
+} _QuadroIDA;
+
+ResultData ida_star(Labirinto *l, Celula inicio, Celula fim, int tamanho_cache, long max_expansoes, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+
+    if (!_memoria_validos(l, inicio, fim))
+        return result;
+
+    int n_colunas = l->n_colunas;
+    int origem = inicio.y * n_colunas + inicio.x;
+    int alvo = fim.y * n_colunas + fim.x;
+
+    if (origem == alvo)
+        return _memoria_caminho(l, &origem, 1, 0);
+
+    // cache de transposicao com mapeamento direto: guarda o menor g com que
+    // a celula foi visitada na iteracao. Colisoes apenas sobrescrevem.
+    int n_cache = _memoria_potencia_2(tamanho_cache > 0 ? tamanho_cache : MEMORIA_NOS_PADRAO);
+    _EntradaCache *cache = (_EntradaCache *)calloc(n_cache, sizeof(_EntradaCache));
+
+    int cap_pilha = 64, n_pilha = 0;
+    _QuadroIDA *pilha = (_QuadroIDA *)malloc(cap_pilha * sizeof(_QuadroIDA));
+
+    // melhor caminho encontrado na iteracao atual
+    int *melhor_caminho = NULL, tamanho_melhor = 0;
+    double melhor = INFINITY;
+
+    double limite = _memoria_h(origem, n_colunas, &fim);
+    long expandidos = 0;
+    int esgotado = 0;
+    StatusBusca status = BUSCA_CONCLUIDA;
+
+    for (int iteracao = 1; !esgotado; iteracao++)
+    {
+        double proximo = INFINITY;
+
+        n_pilha = 1;
+        pilha[0].celula = origem;
+        pilha[0].g = 0;
+        pilha[0].direcao = 0;
+
+        _EntradaCache *e = &cache[_memoria_hash(origem) & (n_cache - 1)];
+        e->celula = origem;
+        e->iteracao = iteracao;
+        e->g = 0;
+
+        while (n_pilha > 0)
+        {
+            _QuadroIDA *q = &pilha[n_pilha - 1];
+
+            if (q->direcao == 8)
+            {
+                n_pilha--;
+                continue;
+            }
+
+            int d = q->direcao++;
+            int ny = q->celula / n_colunas + directions[d][1];
+            int nx = q->celula % n_colunas + directions[d][0];
+
+            if (_labirinto_bloqueado(l, ny, nx))
+                continue;
+
+            int v = ny * n_colunas + nx;
+
+            // voltar para o pai nunca melhora o caminho
+            if (n_pilha > 1 && v == pilha[n_pilha - 2].celula)
+                continue;
+
+            double g = q->g + ((directions[d][0] && directions[d][1]) ? M_SQRT2 : 1.0);
+            double f = g + _memoria_h(v, n_colunas, &fim);
+
+            if (f >= melhor - MEMORIA_FOLGA)
+                continue;
+
+            if (f > limite + MEMORIA_FOLGA)
+            {
+                if (f < proximo)
+                    proximo = f;
+                continue;
+            }
+
+            if (v == alvo)
+            {
+                // como o limite cresce em saltos, o primeiro caminho pode nao
+                // ser o otimo: guarda e continua a iteracao podando por ele
+                melhor = g;
+                tamanho_melhor = n_pilha + 1;
+                melhor_caminho = (int *)realloc(melhor_caminho, tamanho_melhor * sizeof(int));
+                for (int i = 0; i < n_pilha; i++)
+                    melhor_caminho[i] = pilha[i].celula;
+                melhor_caminho[n_pilha] = v;
+                continue;
+            }
+
+            e = &cache[_memoria_hash(v) & (n_cache - 1)];
+            if (e->iteracao == iteracao && e->celula == v && e->g <= g + MEMORIA_FOLGA)
+                continue;
+
+            e->celula = v;
+            e->iteracao = iteracao;
+            e->g = g;
+
+            if ((max_expansoes > 0 && expandidos >= max_expansoes) ||
+                (expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (status = controle_verificar(controle)) != BUSCA_CONCLUIDA))
+            {
+                esgotado = 1;
+                break;
+            }
+
+            if (n_pilha >= cap_pilha)
+            {
+                cap_pilha *= 2;
+                pilha = (_QuadroIDA *)realloc(pilha, cap_pilha * sizeof(_QuadroIDA));
+            }
+
+            pilha[n_pilha].celula = v;
+            pilha[n_pilha].g = g;
+            pilha[n_pilha].direcao = 0;
+            n_pilha++;
+            expandidos++;
+        }
+
+        // com a iteracao completa, nenhum caminho mais barato cabia no limite;
+        // se nenhum caminho excedeu o limite, o fim nao e' alcancavel
+        if (melhor_caminho || isinf(proximo))
+            break;
+
+        limite = proximo > limite * (1 + MEMORIA_IDA_CRESCIMENTO) ? proximo : limite * (1 + MEMORIA_IDA_CRESCIMENTO);
+    }
+
+    // se as expansoes acabarem, devolve o caminho da iteracao interrompida
+    if (melhor_caminho)
+        result = _memoria_caminho(l, melhor_caminho, tamanho_melhor, 0);
+    else
+        result.status = status;
+
+    result.nos_expandidos = expandidos;
+
+    free(melhor_caminho);
+    free(pilha);
+    free(cache);
+
+    return result;
+}
+
+// ---------------------------------------------------------------- SMA*
+
+typedef struct
+{
+    int celula;
+    int pai;
+    int profundidade;
+
+    // direcao do pai ate este no (bit correspondente em pai->filhos)
+    int direcao;
+
+    double g, f;
+
+    // menor f entre os filhos esquecidos, INFINITY se nenhum
+    double esquecido;
+
+    // direcoes cujos filhos estao na memoria
+    unsigned char filhos;
+} _NoSMA;
+
+typedef struct
+{
+    Labirinto *l;
+    Celula fim;
+
+    _NoSMA *nos;
+    int *livres;
+    int n_livres;
+
+    // abertos: menor f e, no empate, o mais profundo. folhas: candidatos a
+    // serem esquecidos, maior f e, no empate, o mais raso
+    IndexHeap *abertos;
+    IndexHeap *folhas;
+
+    // celula -> no de menor g na memoria (enderecamento aberto)
+    int *chaves;
+    int *valores;
+    int mascara;
+
+    // no em expansao, que nao pode ser esquecido
+    int expandindo;
+} _BuscaSMA;
+
+int _sma_mapa_posicao(_BuscaSMA *b, int celula)
+{
+    int i = _memoria_hash(celula) & b->mascara;
+    while (b->chaves[i] != -1 && b->chaves[i] != celula)
+        i = (i + 1) & b->mascara;
+    return i;
+}
+
+int _sma_mapa_buscar(_BuscaSMA *b, int celula)
+{
+    int i = _sma_mapa_posicao(b, celula);
+    return b->chaves[i] == -1 ? -1 : b->valores[i];
+}
+
+void _sma_mapa_definir(_BuscaSMA *b, int celula, int no)
+{
+    int i = _sma_mapa_posicao(b, celula);
+    b->chaves[i] = celula;
+    b->valores[i] = no;
+}
+
+void _sma_mapa_remover(_BuscaSMA *b, int celula)
+{
+    int i = _sma_mapa_posicao(b, celula);
+    if (b->chaves[i] == -1)
+        return;
+
+    // remocao com deslocamento para tras, sem lapides
+    int j = i;
+    while (1)
+    {
+        j = (j + 1) & b->mascara;
+        if (b->chaves[j] == -1)
+            break;
+
+        int k = _memoria_hash(b->chaves[j]) & b->mascara;
+        if ((j > i && (k <= i || k > j)) || (j < i && k <= i && k > j))
+        {
+            b->chaves[i] = b->chaves[j];
+            b->valores[i] = b->valores[j];
+            i = j;
+        }
+    }
+
+    b->chaves[i] = -1;
+}
+
+// f com que o no esta nos abertos, ou INFINITY se nao esta
+double _sma_valor(_BuscaSMA *b, int no)
+{
+    return index_heap_contains(b->abertos, no) ? index_heap_priority(b->abertos, no) : INFINITY;
+}
+
+void _sma_abrir(_BuscaSMA *b, int no, double f)
+{
+    index_heap_push_tiebreak(b->abertos, no, f, -b->nos[no].profundidade);
+
+    if (b->nos[no].filhos == 0 && no != b->expandindo)
+        index_heap_push_tiebreak(b->folhas, no, -f, b->nos[no].profundidade);
+}
+
+// esquece a folha, guardando o seu f no pai. Pais que ficam sem filhos e
+// sem nada a regerar tambem sao esquecidos.
+void _sma_esquecer(_BuscaSMA *b, int no)
+{
+    while (no >= 0)
+    {
+        _NoSMA *x = &b->nos[no];
+        double valor = _sma_valor(b, no);
+
+        if (index_heap_contains(b->abertos, no))
+            index_heap_remove(b->abertos, no);
+        if (index_heap_contains(b->folhas, no))
+            index_heap_remove(b->folhas, no);
+        if (_sma_mapa_buscar(b, x->celula) == no)
+            _sma_mapa_remover(b, x->celula);
+
+        b->livres[b->n_livres++] = no;
+
+        int pai = x->pai;
+        if (pai < 0)
+            break;
+
+        _NoSMA *p = &b->nos[pai];
+        p->filhos &= ~(1 << x->direcao);
+        if (valor < p->esquecido)
+            p->esquecido = valor;
+
+        if (pai == b->expandindo)
+            break;
+
+        if (p->esquecido < INFINITY)
+        {
+            _sma_abrir(b, pai, p->esquecido > p->f ? p->esquecido : p->f);
+            break;
+        }
+
+        no = p->filhos == 0 ? pai : -1;
+    }
+}
+
+// obtem um no livre, esquecendo a pior folha se a memoria estiver cheia
+int _sma_alocar(_BuscaSMA *b)
+{
+    if (b->n_livres == 0)
+    {
+        if (index_heap_empty(b->folhas))
+            return -1;
+
+        _sma_esquecer(b, index_heap_min(b->folhas));
+    }
+
+    return b->livres[--b->n_livres];
+}
+
+void _sma_expandir(_BuscaSMA *b, int no, double f_no)
+{
+    int n_colunas = b->l->n_colunas;
+    _NoSMA *x = &b->nos[no];
+    int y = x->celula / n_colunas, cx = x->celula % n_colunas;
+    int celula_pai = x->pai >= 0 ? b->nos[x->pai].celula : -1;
+
+    b->expandindo = no;
+    if (index_heap_contains(b->folhas, no))
+        index_heap_remove(b->folhas, no);
+
+    // regera todos os filhos ausentes, inclusive os esquecidos
+    x->esquecido = INFINITY;
+
+    for (int d = 0; d < 8; d++)
+    {
+        x = &b->nos[no];
+        if (x->filhos & (1 << d))
+            continue;
+
+        int ny = y + directions[d][1], nx = cx + directions[d][0];
+
+        if (_labirinto_bloqueado(b->l, ny, nx))
+            continue;
+
+        int v = ny * n_colunas + nx;
+        if (v == celula_pai)
+            continue;
+
+        double g = x->g + ((directions[d][0] && directions[d][1]) ? M_SQRT2 : 1.0);
+
+        // uma copia da celula com g menor ou igual ja esta na memoria
+        int copia = _sma_mapa_buscar(b, v);
+        if (copia >= 0 && b->nos[copia].g <= g + MEMORIA_FOLGA)
+            continue;
+
+        int filho = _sma_alocar(b);
+        if (filho < 0)
+            continue;
+
+        x = &b->nos[no];
+        _NoSMA *c = &b->nos[filho];
+        c->celula = v;
+        c->pai = no;
+        c->profundidade = x->profundidade + 1;
+        c->direcao = d;
+        c->g = g;
+        c->f = g + _memoria_h(v, n_colunas, &b->fim);
+        if (c->f < f_no)
+            c->f = f_no;
+        c->esquecido = INFINITY;
+        c->filhos = 0;
+
+        x->filhos |= 1 << d;
+        _sma_mapa_definir(b, v, filho);
+        _sma_abrir(b, filho, c->f);
+    }
+
+    b->expandindo = -1;
+    x = &b->nos[no];
+
+    if (x->esquecido < INFINITY)
+        _sma_abrir(b, no, x->esquecido > x->f ? x->esquecido : x->f);
+    else if (x->filhos == 0)
+        _sma_esquecer(b, no);
+}
+
+ResultData sma_star(Labirinto *l, Celula inicio, Celula fim, int max_nos, long max_expansoes, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+
+    if (!_memoria_validos(l, inicio, fim))
+        return result;
+
+    if (max_nos <= 0)
+        max_nos = MEMORIA_NOS_PADRAO;
+    if (max_nos < 2)
+        max_nos = 2;
+
+    _BuscaSMA b = {0};
+    b.l = l;
+    b.fim = fim;
+    b.nos = (_NoSMA *)malloc(max_nos * sizeof(_NoSMA));
+    b.livres = (int *)malloc(max_nos * sizeof(int));
+    b.abertos = index_heap_construct(max_nos);
+    b.folhas = index_heap_construct(max_nos);
+    b.mascara = _memoria_potencia_2(2 * max_nos) - 1;
+    b.chaves = (int *)malloc((b.mascara + 1) * sizeof(int));
+    b.valores = (int *)malloc((b.mascara + 1) * sizeof(int));
+    b.expandindo = -1;
+
+    for (int i = 0; i <= b.mascara; i++)
+        b.chaves[i] = -1;
+    for (int i = 0; i < max_nos; i++)
+        b.livres[i] = max_nos - 1 - i;
+    b.n_livres = max_nos;
+
+    int alvo = fim.y * l->n_colunas + fim.x;
+    int raiz = b.livres[--b.n_livres];
+    _NoSMA *r = &b.nos[raiz];
+    r->celula = inicio.y * l->n_colunas + inicio.x;
+    r->pai = -1;
+    r->profundidade = 0;
+    r->direcao = 0;
+    r->g = 0;
+    r->f = _memoria_h(r->celula, l->n_colunas, &fim);
+    r->esquecido = INFINITY;
+    r->filhos = 0;
+    _sma_mapa_definir(&b, r->celula, raiz);
+    index_heap_push_tiebreak(b.abertos, raiz, r->f, 0);
+
+    while (!index_heap_empty(b.abertos))
+    {
+        double f = index_heap_min_priority(b.abertos);
+        if (result.nos_expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        int no = index_heap_pop(b.abertos);
+        result.nos_expandidos++;
+
+        // caminho infinito: o que sobrou ficou sem memoria ou e' inalcancavel
+        if (isinf(f) || (max_expansoes > 0 && result.nos_expandidos > max_expansoes))
+            break;
+
+        // copia superada por outra de g menor: nao vale a pena expandir
+        if (_sma_mapa_buscar(&b, b.nos[no].celula) != no)
+        {
+            if (b.nos[no].filhos == 0 && no != raiz)
+                _sma_esquecer(&b, no);
+            continue;
+        }
+
+        if (b.nos[no].celula == alvo)
+        {
+            int tamanho = b.nos[no].profundidade + 1;
+            int *celulas = (int *)malloc(tamanho * sizeof(int));
+            for (int v = no, i = tamanho - 1; v >= 0; v = b.nos[v].pai, i--)
+                celulas[i] = b.nos[v].celula;
+
+            int expandidos = result.nos_expandidos;
+            result = _memoria_caminho(l, celulas, tamanho, expandidos);
+            free(celulas);
+            break;
+        }
+
+        _sma_expandir(&b, no, f);
+    }
+
+    free(b.nos);
+    free(b.livres);
+    free(b.chaves);
+    free(b.valores);
+    index_heap_destroy(b.abertos);
+    index_heap_destroy(b.folhas);
+
+    return result;
+}
+
+ConfigMemoria memoria_config_padrao(ModoMemoria modo)
+{
+    ConfigMemoria config;
+    config.modo = modo;
+    config.max_nos = MEMORIA_NOS_PADRAO;
+    config.max_expansoes = 0;
+    config.controle = NULL;
+    return config;
+}
+
+ResultData busca_memoria_limitada(Labirinto *l, Celula inicio, Celula fim, ConfigMemoria config)
+{
+    if (config.modo == MEMORIA_IDA_STAR)
+        return ida_star(l, inicio, fim, config.max_nos, config.max_expansoes, config.controle);
+
+    return sma_star(l, inicio, fim, config.max_nos, config.max_expansoes, config.controle);
+}
@@ -0,0 +1,46 @@
+#ifndef _MEMORIA_H_
+#define _MEMORIA_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+#define MEMORIA_NOS_PADRAO 65536
+
+// Buscas com memoria limitada por um numero maximo de nos, para processos
+// que nao podem manter todos os nos gerados como o a_star. Nenhuma delas
+// marca celulas no labirinto nem aloca memoria proporcional ao mapa.
+typedef enum
+{
+    // IDA*: aprofundamento iterativo no limite de f com uma cache de
+    // transposicao de max_nos entradas. Memoria fixa, mas reexpande celulas.
+    MEMORIA_IDA_STAR,
+
+    // SMA*: A* que, com a memoria cheia, esquece a pior folha e guarda o seu
+    // f no pai para regera-la depois. Otimo se o caminho otimo cabe na memoria.
+    MEMORIA_SMA_STAR
+} ModoMemoria;
+
+typedef struct
+{
+    ModoMemoria modo;
+
+    // nos guardados (SMA*) ou entradas da cache de transposicao (IDA*)
+    int max_nos;
+
+    // desiste depois de tantas expansoes (<= 0 para nao limitar). Com pouca
+    // memoria as duas buscas reexpandem muito: o IDA* devolve o melhor caminho
+    // ja visto, mesmo sem provar que e' otimo, e o SMA* falha.
+    long max_expansoes;
+
+    // opcional: cancelamento e prazo. Interrompido, o IDA* tambem devolve o
+    // melhor caminho ja visto, se houver.
+    ControleBusca *controle;
+} ConfigMemoria;
+
+ConfigMemoria memoria_config_padrao(ModoMemoria modo);
+
+ResultData ida_star(Labirinto *l, Celula inicio, Celula fim, int tamanho_cache, long max_expansoes, ControleBusca *controle);
+ResultData sma_star(Labirinto *l, Celula inicio, Celula fim, int max_nos, long max_expansoes, ControleBusca *controle);
+ResultData busca_memoria_limitada(Labirinto *l, Celula inicio, Celula fim, ConfigMemoria config);
+
+#endif
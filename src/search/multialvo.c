@@ -0,0 +1,215 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "multialvo.h"
+#include "dijkstra.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+typedef struct
+{
+    Labirinto *l;
+    Celula *fins;
+    int n_fins;
+    CampoDistancias *campo;
+
+    // retangulo que envolve os alvos validos
+    int x_min, x_max, y_min, y_max;
+
+    // heuristica de cada celula, calculada na primeira vez (-1 antes disso)
+    double *h;
+} _BuscaMultialvo;
+
+int _multialvo_valido(Labirinto *l, Celula c)
+{
+    return _labirinto_livre(l, c.y, c.x);
+}
+
+double _multialvo_h(_BuscaMultialvo *b, int u)
+{
+    if (b->h[u] >= 0)
+        return b->h[u];
+
+    int x = u % b->l->n_colunas, y = u / b->l->n_colunas;
+    double h;
+
+    if (b->campo)
+        h = b->campo->custo[u];
+    else if (b->n_fins > MULTIALVO_MAX_HEURISTICA)
+    {
+        // nenhum alvo esta mais perto do que o retangulo que os contem
+        double dx = x < b->x_min ? b->x_min - x : (x > b->x_max ? x - b->x_max : 0);
+        double dy = y < b->y_min ? b->y_min - y : (y > b->y_max ? y - b->y_max : 0);
+        h = sqrt(dx * dx + dy * dy);
+    }
+    else
+    {
+        h = INFINITY;
+        for (int i = 0; i < b->n_fins; i++)
+        {
+            double dx = b->fins[i].x - x, dy = b->fins[i].y - y;
+            double d = sqrt(dx * dx + dy * dy);
+            if (d < h)
+                h = d;
+        }
+    }
+
+    b->h[u] = h;
+    return h;
+}
+
+ResultData a_star_multialvo(Labirinto *l, Celula inicio, Celula *fins, int n_fins, CampoDistancias *campo, ControleBusca *controle, int *alcancado)
+{
+    ResultData result = _default_result();
+
+    if (alcancado)
+        *alcancado = -1;
+
+    if (!_multialvo_valido(l, inicio))
+        return result;
+
+    if (campo && (campo->n_linhas != l->n_linhas || campo->n_colunas != l->n_colunas))
+        exit(printf("Erro: campo de distancias de %dx%d para um labirinto de %dx%d.\n", campo->n_linhas, campo->n_colunas, l->n_linhas, l->n_colunas));
+
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+
+    // indice + 1 do alvo em cada celula (0 se nao for alvo); repetidos
+    // ficam com o primeiro indice
+    int *alvo = (int *)calloc(n, sizeof(int));
+
+    _BuscaMultialvo b = {0};
+    b.l = l;
+    b.campo = campo;
+    b.x_min = l->n_colunas;
+    b.y_min = l->n_linhas;
+    b.x_max = b.y_max = -1;
+
+    // a heuristica so' considera os alvos validos
+    b.fins = (Celula *)malloc((n_fins > 0 ? n_fins : 1) * sizeof(Celula));
+    for (int i = 0; i < n_fins; i++)
+    {
+        if (!_multialvo_valido(l, fins[i]))
+            continue;
+
+        int v = fins[i].y * l->n_colunas + fins[i].x;
+        if (alvo[v])
+            continue;
+
+        alvo[v] = i + 1;
+        b.fins[b.n_fins++] = fins[i];
+
+        if (fins[i].x < b.x_min) b.x_min = fins[i].x;
+        if (fins[i].x > b.x_max) b.x_max = fins[i].x;
+        if (fins[i].y < b.y_min) b.y_min = fins[i].y;
+        if (fins[i].y > b.y_max) b.y_max = fins[i].y;
+    }
+
+    if (b.n_fins == 0)
+    {
+        free(alvo);
+        free(b.fins);
+        return result;
+    }
+
+    double *g = (double *)malloc(n * sizeof(double));
+    unsigned char *dir = (unsigned char *)malloc(n * sizeof(unsigned char));
+    unsigned char *fechado = (unsigned char *)calloc(n, sizeof(unsigned char));
+    IndexHeap *abertos = index_heap_construct(n);
+    b.h = (double *)malloc(n * sizeof(double));
+
+    for (size_t i = 0; i < n; i++)
+    {
+        g[i] = INFINITY;
+        b.h[i] = -1;
+    }
+    memset(dir, DIRECAO_NENHUMA, n);
+
+    int origem = inicio.y * l->n_colunas + inicio.x;
+    int encontrado = -1;
+
+    g[origem] = 0;
+    if (!isinf(_multialvo_h(&b, origem)))
+        index_heap_push_tiebreak(abertos, origem, _multialvo_h(&b, origem), 0);
+
+    while (!index_heap_empty(abertos))
+    {
+        if (result.nos_expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        int u = index_heap_pop(abertos);
+        fechado[u] = 1;
+        result.nos_expandidos++;
+
+        if (alvo[u])
+        {
+            encontrado = u;
+            break;
+        }
+
+        int y = u / l->n_colunas, x = u % l->n_colunas;
+
+        for (int d = 0; d < 8; d++)
+        {
+            int ny = y + directions[d][1], nx = x + directions[d][0];
+
+            if (_labirinto_bloqueado(l, ny, nx))
+                continue;
+
+            int v = ny * l->n_colunas + nx;
+
+            if (fechado[v])
+                continue;
+
+            double custo = g[u] + ((directions[d][0] && directions[d][1]) ? M_SQRT2 : 1.0);
+            double h = _multialvo_h(&b, v);
+
+            // heuristica infinita: nenhum alvo e' alcancavel a partir daqui
+            if (custo < g[v] && !isinf(h))
+            {
+                g[v] = custo;
+                dir[v] = (d + 4) % 8;
+
+                // empates em f favorecem o maior g, mais perto dos alvos
+                index_heap_push_tiebreak(abertos, v, custo + h, -custo);
+            }
+        }
+    }
+
+    if (encontrado >= 0)
+    {
+        int tamanho = 1;
+        for (int v = encontrado; dir[v] != DIRECAO_NENHUMA; tamanho++)
+            v += directions[dir[v]][1] * l->n_colunas + directions[dir[v]][0];
+
+        result.caminho = (Celula *)calloc(tamanho, sizeof(Celula));
+        result.tamanho_caminho = tamanho;
+        result.sucesso = 1;
+
+        int v = encontrado;
+        for (int i = tamanho - 1; i >= 0; i--)
+        {
+            result.caminho[i].x = v % l->n_colunas;
+            result.caminho[i].y = v / l->n_colunas;
+
+            if (i > 0)
+                v += directions[dir[v]][1] * l->n_colunas + directions[dir[v]][0];
+        }
+
+        for (int i = 1; i < tamanho; i++)
+            result.custo_caminho += _cell_distance(&result.caminho[i - 1], &result.caminho[i]);
+
+        if (alcancado)
+            *alcancado = alvo[encontrado] - 1;
+    }
+
+    free(alvo);
+    free(b.fins);
+    free(b.h);
+    free(g);
+    free(dir);
+    free(fechado);
+    index_heap_destroy(abertos);
+
+    return result;
+}
@@ -0,0 +1,30 @@
+#ifndef _MULTIALVO_H_
+#define _MULTIALVO_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+#include "campo.h"
+
+// acima de tantos alvos a heuristica deixa de percorrer todos eles e usa a
+// distancia ao retangulo que os envolve
+#define MULTIALVO_MAX_HEURISTICA 64
+
+/**
+ * @brief A* ate o mais proximo de varios alvos aceitaveis (saidas, pontos de
+ * coleta...): para no primeiro alvo fechado, que e' o de menor custo.
+ * A heuristica e' o minimo das distancias euclidianas ate os alvos (ou a
+ * distancia ao retangulo que os envolve, com muitos alvos). Com um campo de
+ * campo_distancias_alvos para o mesmo conjunto, a heuristica e' exata e a
+ * busca so' expande as celulas do caminho.
+ * @param campo
+ * Opcional (pode ser NULL).
+ * @param controle
+ * Opcional (pode ser NULL), como em a_star_controlado.
+ * @param alcancado
+ * Opcional. Recebe o indice em fins do alvo alcancado, ou -1.
+ * Alvos bloqueados ou fora do mapa sao ignorados. Nao marca celulas no
+ * labirinto.
+ */
+ResultData a_star_multialvo(Labirinto *l, Celula inicio, Celula *fins, int n_fins, CampoDistancias *campo, ControleBusca *controle, int *alcancado);
+
+#endif
@@ -0,0 +1,432 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "onda.h"
+#include "labirinto_interno.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ONDA_X86
+#include <immintrin.h>
+#endif
+
+// colunas extras antes da coluna 0 de cada linha: mantem a coluna 0 alinhada
+// para os kernels e torna validas as leituras das colunas -1 e n_colunas
+#define ONDA_MARGEM 32
+
+// colunas por trecho: a unidade em que a fronteira e' rastreada e entregue
+// aos kernels (duas instrucoes SSE2 ou uma AVX2)
+#define ONDA_TRECHO 32
+
+// Processa uma linha: proxima = vizinhos(fronteira) & livre & ~visitado e
+// visitado |= proxima. As linhas apontam para a coluna 0 e podem ser lidas
+// em [-1, n + 32]. Em cada celula nova escreve valor em saida (se nao for
+// NULL). Retorna o numero de celulas novas.
+typedef long (*_KernelLinha)(const uint8_t *cima, const uint8_t *meio, const uint8_t *baixo, const uint8_t *livre,
+                             uint8_t *visitado, uint8_t *proxima, int n, int *saida, int valor);
+
+long _onda_linha_escalar(const uint8_t *cima, const uint8_t *meio, const uint8_t *baixo, const uint8_t *livre,
+                         uint8_t *visitado, uint8_t *proxima, int n, int *saida, int valor)
+{
+    long novos = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        uint8_t vizinhos = cima[i - 1] | cima[i] | cima[i + 1] |
+                           meio[i - 1] | meio[i] | meio[i + 1] |
+                           baixo[i - 1] | baixo[i] | baixo[i + 1];
+        uint8_t nova = vizinhos & livre[i] & ~visitado[i];
+
+        proxima[i] = nova;
+
+        if (nova)
+        {
+            visitado[i] = 0xFF;
+            novos++;
+
+            if (saida)
+                saida[i] = valor;
+        }
+    }
+
+    return novos;
+}
+
+#ifdef ONDA_X86
+
+__attribute__((target("sse2"))) long _onda_linha_sse2(const uint8_t *cima, const uint8_t *meio, const uint8_t *baixo, const uint8_t *livre,
+                                                      uint8_t *visitado, uint8_t *proxima, int n, int *saida, int valor)
+{
+    long novos = 0;
+
+    for (int i = 0; i < n; i += 16)
+    {
+        __m128i v = _mm_or_si128(_mm_or_si128(_mm_loadu_si128((const __m128i *)(cima + i - 1)),
+                                              _mm_loadu_si128((const __m128i *)(meio + i - 1))),
+                                 _mm_loadu_si128((const __m128i *)(baixo + i - 1)));
+        v = _mm_or_si128(v, _mm_or_si128(_mm_or_si128(_mm_load_si128((const __m128i *)(cima + i)),
+                                                      _mm_load_si128((const __m128i *)(meio + i))),
+                                         _mm_load_si128((const __m128i *)(baixo + i))));
+        v = _mm_or_si128(v, _mm_or_si128(_mm_or_si128(_mm_loadu_si128((const __m128i *)(cima + i + 1)),
+                                                      _mm_loadu_si128((const __m128i *)(meio + i + 1))),
+                                         _mm_loadu_si128((const __m128i *)(baixo + i + 1))));
+
+        __m128i vis = _mm_load_si128((const __m128i *)(visitado + i));
+        __m128i nova = _mm_andnot_si128(vis, _mm_and_si128(v, _mm_load_si128((const __m128i *)(livre + i))));
+        _mm_store_si128((__m128i *)(proxima + i), nova);
+
+        unsigned int mascara = _mm_movemask_epi8(nova);
+        if (mascara)
+        {
+            _mm_store_si128((__m128i *)(visitado + i), _mm_or_si128(vis, nova));
+            novos += __builtin_popcount(mascara);
+
+            for (; saida && mascara; mascara &= mascara - 1)
+                saida[i + __builtin_ctz(mascara)] = valor;
+        }
+    }
+
+    return novos;
+}
+
+__attribute__((target("avx2"))) long _onda_linha_avx2(const uint8_t *cima, const uint8_t *meio, const uint8_t *baixo, const uint8_t *livre,
+                                                      uint8_t *visitado, uint8_t *proxima, int n, int *saida, int valor)
+{
+    long novos = 0;
+
+    for (int i = 0; i < n; i += 32)
+    {
+        __m256i v = _mm256_or_si256(_mm256_or_si256(_mm256_loadu_si256((const __m256i *)(cima + i - 1)),
+                                                    _mm256_loadu_si256((const __m256i *)(meio + i - 1))),
+                                    _mm256_loadu_si256((const __m256i *)(baixo + i - 1)));
+        v = _mm256_or_si256(v, _mm256_or_si256(_mm256_or_si256(_mm256_load_si256((const __m256i *)(cima + i)),
+                                                               _mm256_load_si256((const __m256i *)(meio + i))),
+                                               _mm256_load_si256((const __m256i *)(baixo + i))));
+        v = _mm256_or_si256(v, _mm256_or_si256(_mm256_or_si256(_mm256_loadu_si256((const __m256i *)(cima + i + 1)),
+                                                               _mm256_loadu_si256((const __m256i *)(meio + i + 1))),
+                                               _mm256_loadu_si256((const __m256i *)(baixo + i + 1))));
+
+        __m256i vis = _mm256_load_si256((const __m256i *)(visitado + i));
+        __m256i nova = _mm256_andnot_si256(vis, _mm256_and_si256(v, _mm256_load_si256((const __m256i *)(livre + i))));
+        _mm256_store_si256((__m256i *)(proxima + i), nova);
+
+        unsigned int mascara = _mm256_movemask_epi8(nova);
+        if (mascara)
+        {
+            _mm256_store_si256((__m256i *)(visitado + i), _mm256_or_si256(vis, nova));
+            novos += __builtin_popcount(mascara);
+
+            for (; saida && mascara; mascara &= mascara - 1)
+                saida[i + __builtin_ctz(mascara)] = valor;
+        }
+    }
+
+    return novos;
+}
+
+#endif
+
+static int _onda_kernel_escolhido = -1;
+
+int _onda_suportado(KernelOnda kernel)
+{
+    if (kernel == ONDA_ESCALAR)
+        return 1;
+
+#ifdef ONDA_X86
+    __builtin_cpu_init();
+
+    if (kernel == ONDA_SSE2)
+        return __builtin_cpu_supports("sse2");
+    if (kernel == ONDA_AVX2)
+        return __builtin_cpu_supports("avx2");
+#endif
+
+    return 0;
+}
+
+KernelOnda onda_kernel()
+{
+    if (_onda_kernel_escolhido < 0)
+    {
+        if (_onda_suportado(ONDA_AVX2))
+            _onda_kernel_escolhido = ONDA_AVX2;
+        else if (_onda_suportado(ONDA_SSE2))
+            _onda_kernel_escolhido = ONDA_SSE2;
+        else
+            _onda_kernel_escolhido = ONDA_ESCALAR;
+    }
+
+    return (KernelOnda)_onda_kernel_escolhido;
+}
+
+int onda_definir_kernel(KernelOnda kernel)
+{
+    if (!_onda_suportado(kernel))
+        return 0;
+
+    _onda_kernel_escolhido = kernel;
+    return 1;
+}
+
+_KernelLinha _onda_funcao(KernelOnda kernel)
+{
+#ifdef ONDA_X86
+    if (kernel == ONDA_AVX2)
+        return _onda_linha_avx2;
+    if (kernel == ONDA_SSE2)
+        return _onda_linha_sse2;
+#endif
+
+    return _onda_linha_escalar;
+}
+
+typedef struct
+{
+    int n_linhas, n_colunas;
+
+    // bytes por linha, multiplo de 32; a linha r da grade e' a linha r - 1
+    // do mapa (as linhas 0 e n_linhas + 1 sao a borda, sempre zeradas)
+    int passo;
+
+    uint8_t *livre;
+    uint8_t *visitado;
+    uint8_t *fronteira;
+    uint8_t *proxima;
+
+    // a linha e' dividida em trechos de ONDA_TRECHO colunas; por linha,
+    // palavras_trechos palavras marcam os trechos com fronteira nao vazia
+    int n_trechos;
+    int palavras_trechos;
+    uint64_t *trechos;
+    uint64_t *trechos_proxima;
+
+    // linhas da grade com fronteira nao vazia, e a proxima lista
+    int *ativas;
+    int n_ativas;
+    int *ativas_proxima;
+
+    // ultima onda em que a linha foi processada, para nao repeti-la
+    int *marca;
+    int onda;
+
+    _KernelLinha kernel;
+} _GradeOnda;
+
+uint8_t *_onda_linha(_GradeOnda *g, uint8_t *base, int r)
+{
+    return base + (size_t)r * g->passo + ONDA_MARGEM;
+}
+
+uint64_t *_onda_trechos(_GradeOnda *g, uint64_t *base, int r)
+{
+    return base + (size_t)r * g->palavras_trechos;
+}
+
+_GradeOnda *_onda_grade(Labirinto *l)
+{
+    _GradeOnda *g = (_GradeOnda *)calloc(1, sizeof(_GradeOnda));
+    g->n_linhas = l->n_linhas;
+    g->n_colunas = l->n_colunas;
+    g->n_trechos = (l->n_colunas + ONDA_TRECHO - 1) / ONDA_TRECHO;
+    g->passo = ONDA_MARGEM + g->n_trechos * ONDA_TRECHO + ONDA_MARGEM;
+    g->palavras_trechos = (g->n_trechos + 63) / 64;
+
+    size_t tamanho = (size_t)(l->n_linhas + 2) * g->passo;
+    g->livre = (uint8_t *)aligned_alloc(32, tamanho);
+    g->visitado = (uint8_t *)aligned_alloc(32, tamanho);
+    g->fronteira = (uint8_t *)aligned_alloc(32, tamanho);
+    g->proxima = (uint8_t *)aligned_alloc(32, tamanho);
+    memset(g->livre, 0, tamanho);
+    memset(g->visitado, 0, tamanho);
+    memset(g->fronteira, 0, tamanho);
+    memset(g->proxima, 0, tamanho);
+
+    for (int linha = 0; linha < l->n_linhas; linha++)
+    {
+        uint8_t *livre = _onda_linha(g, g->livre, linha + 1);
+
+        for (int coluna = 0; coluna < l->n_colunas; coluna++)
+            livre[coluna] = _labirinto_bloqueado(l, linha, coluna) ? 0 : 0xFF;
+    }
+
+    size_t n_palavras = (size_t)(l->n_linhas + 2) * g->palavras_trechos;
+    g->trechos = (uint64_t *)calloc(n_palavras, sizeof(uint64_t));
+    g->trechos_proxima = (uint64_t *)calloc(n_palavras, sizeof(uint64_t));
+
+    g->ativas = (int *)malloc((l->n_linhas + 2) * sizeof(int));
+    g->ativas_proxima = (int *)malloc((l->n_linhas + 2) * sizeof(int));
+    g->marca = (int *)calloc(l->n_linhas + 2, sizeof(int));
+    g->kernel = _onda_funcao(onda_kernel());
+
+    return g;
+}
+
+void _onda_grade_destruir(_GradeOnda *g)
+{
+    free(g->livre);
+    free(g->visitado);
+    free(g->fronteira);
+    free(g->proxima);
+    free(g->trechos);
+    free(g->trechos_proxima);
+    free(g->ativas);
+    free(g->ativas_proxima);
+    free(g->marca);
+    free(g);
+}
+
+// processa os trechos da linha r vizinhos de algum trecho ativo nas linhas
+// r - 1, r e r + 1. Retorna o numero de celulas novas.
+long _onda_processar_linha(_GradeOnda *g, int r, int *saida, int valor)
+{
+    const uint64_t *cima = _onda_trechos(g, g->trechos, r - 1);
+    const uint64_t *meio = _onda_trechos(g, g->trechos, r);
+    const uint64_t *baixo = _onda_trechos(g, g->trechos, r + 1);
+    uint64_t *proximos = _onda_trechos(g, g->trechos_proxima, r);
+    long novos = 0;
+
+    for (int k = 0; k < g->palavras_trechos; k++)
+    {
+        uint64_t m = cima[k] | meio[k] | baixo[k];
+        uint64_t anterior = k > 0 ? cima[k - 1] | meio[k - 1] | baixo[k - 1] : 0;
+        uint64_t seguinte = k + 1 < g->palavras_trechos ? cima[k + 1] | meio[k + 1] | baixo[k + 1] : 0;
+
+        // uma celula na ponta de um trecho alcanca o trecho vizinho
+        m |= (m << 1) | (m >> 1) | (anterior >> 63) | (seguinte << 63);
+
+        for (; m; m &= m - 1)
+        {
+            int t = 64 * k + __builtin_ctzll(m);
+            if (t >= g->n_trechos)
+                break;
+
+            size_t c = (size_t)t * ONDA_TRECHO;
+            long n = g->kernel(_onda_linha(g, g->fronteira, r - 1) + c, _onda_linha(g, g->fronteira, r) + c,
+                               _onda_linha(g, g->fronteira, r + 1) + c, _onda_linha(g, g->livre, r) + c,
+                               _onda_linha(g, g->visitado, r) + c, _onda_linha(g, g->proxima, r) + c,
+                               ONDA_TRECHO, saida ? saida + c : NULL, valor);
+
+            if (n)
+            {
+                proximos[k] |= 1ULL << (t & 63);
+                novos += n;
+            }
+        }
+    }
+
+    return novos;
+}
+
+// propaga a onda a partir de uma celula livre nao visitada. Escreve em
+// saida o nivel de cada celula, ou valor_fixo se ele for >= 0.
+long _onda_inundar(_GradeOnda *g, int linha, int coluna, int *saida, int valor_fixo)
+{
+    int r0 = linha + 1;
+    _onda_linha(g, g->fronteira, r0)[coluna] = 0xFF;
+    _onda_linha(g, g->visitado, r0)[coluna] = 0xFF;
+    _onda_trechos(g, g->trechos, r0)[coluna / ONDA_TRECHO / 64] |= 1ULL << ((coluna / ONDA_TRECHO) & 63);
+
+    if (saida)
+        saida[(size_t)linha * g->n_colunas + coluna] = valor_fixo >= 0 ? valor_fixo : 0;
+
+    g->ativas[0] = r0;
+    g->n_ativas = 1;
+    long alcancadas = 1;
+
+    for (int nivel = 1; g->n_ativas > 0; nivel++)
+    {
+        int n_proxima = 0;
+        g->onda++;
+
+        // cada linha da fronteira alcanca a linha de cima e a de baixo
+        for (int i = 0; i < g->n_ativas; i++)
+        {
+            for (int r = g->ativas[i] - 1; r <= g->ativas[i] + 1; r++)
+            {
+                if (r < 1 || r > g->n_linhas || g->marca[r] == g->onda)
+                    continue;
+
+                g->marca[r] = g->onda;
+
+                int *saida_linha = saida ? saida + (size_t)(r - 1) * g->n_colunas : NULL;
+                long novos = _onda_processar_linha(g, r, saida_linha, valor_fixo >= 0 ? valor_fixo : nivel);
+
+                if (novos)
+                {
+                    g->ativas_proxima[n_proxima++] = r;
+                    alcancadas += novos;
+                }
+            }
+        }
+
+        // trechos processados sem celulas novas ficaram zerados em proxima;
+        // a fronteira antiga e' zerada para virar a proxima do nivel seguinte
+        for (int i = 0; i < g->n_ativas; i++)
+        {
+            int r = g->ativas[i];
+            uint64_t *trechos = _onda_trechos(g, g->trechos, r);
+            uint8_t *fronteira = _onda_linha(g, g->fronteira, r);
+
+            for (int k = 0; k < g->palavras_trechos; k++)
+            {
+                for (uint64_t m = trechos[k]; m; m &= m - 1)
+                    memset(fronteira + (size_t)(64 * k + __builtin_ctzll(m)) * ONDA_TRECHO, 0, ONDA_TRECHO);
+                trechos[k] = 0;
+            }
+        }
+
+        uint8_t *aux = g->fronteira;
+        g->fronteira = g->proxima;
+        g->proxima = aux;
+
+        uint64_t *aux_trechos = g->trechos;
+        g->trechos = g->trechos_proxima;
+        g->trechos_proxima = aux_trechos;
+
+        int *aux_ativas = g->ativas;
+        g->ativas = g->ativas_proxima;
+        g->ativas_proxima = aux_ativas;
+        g->n_ativas = n_proxima;
+    }
+
+    return alcancadas;
+}
+
+long onda_saltos(Labirinto *l, Celula inicio, int *saltos)
+{
+    for (size_t i = 0; i < (size_t)l->n_linhas * l->n_colunas; i++)
+        saltos[i] = -1;
+
+    if (!_labirinto_livre(l, inicio.y, inicio.x))
+        return 0;
+
+    _GradeOnda *g = _onda_grade(l);
+    long alcancadas = _onda_inundar(g, inicio.y, inicio.x, saltos, -1);
+    _onda_grade_destruir(g);
+
+    return alcancadas;
+}
+
+int onda_componentes(Labirinto *l, int *rotulos)
+{
+    for (size_t i = 0; i < (size_t)l->n_linhas * l->n_colunas; i++)
+        rotulos[i] = -1;
+
+    _GradeOnda *g = _onda_grade(l);
+    int n_componentes = 0;
+
+    // o vetor visitado e' compartilhado: cada inundacao pula as anteriores
+    for (int linha = 0; linha < l->n_linhas; linha++)
+    {
+        const uint8_t *livre = _onda_linha(g, g->livre, linha + 1);
+        const uint8_t *visitado = _onda_linha(g, g->visitado, linha + 1);
+
+        for (int coluna = 0; coluna < l->n_colunas; coluna++)
+            if (livre[coluna] && !visitado[coluna])
+                _onda_inundar(g, linha, coluna, rotulos, n_componentes++);
+    }
+
+    _onda_grade_destruir(g);
+
+    return n_componentes;
+}
@@ -0,0 +1,34 @@
+#ifndef _ONDA_H_
+#define _ONDA_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// Propagacao de frente de onda (BFS de 8 vizinhos, nivel a nivel) sobre
+// grades de bytes, uma linha por vez. Cada byte vale 0x00 ou 0xFF, de modo
+// que um nivel e' um estencil de OR/AND sobre as tres linhas vizinhas, que os
+// kernels SIMD processam 16 (SSE2) ou 32 (AVX2) celulas por instrucao.
+typedef enum
+{
+    ONDA_ESCALAR = 0,
+    ONDA_SSE2 = 1,
+    ONDA_AVX2 = 2
+} KernelOnda;
+
+// kernel em uso. Na primeira chamada escolhe o melhor suportado pela CPU.
+KernelOnda onda_kernel();
+
+// forca um kernel (util para comparar). Retorna 0 se a CPU nao o suporta.
+int onda_definir_kernel(KernelOnda kernel);
+
+// campo de saltos a partir do inicio: saltos[linha * n_colunas + coluna]
+// recebe o numero de movimentos ate a celula, ou -1 se ela nao e' alcancavel.
+// Retorna o numero de celulas alcancadas.
+long onda_saltos(Labirinto *l, Celula inicio, int *saltos);
+
+// componentes conexas das celulas livres: rotulos recebe 0, 1, ... por
+// componente (na ordem da primeira celula em varredura por linhas) e -1 nos
+// obstaculos. Retorna o numero de componentes.
+int onda_componentes(Labirinto *l, int *rotulos);
+
+#endif
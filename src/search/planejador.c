@@ -0,0 +1,323 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "planejador.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+// tolerancia relativa na comparacao das chaves da fila
+#define PLANEJADOR_TOLERANCIA 1e-9
+
+struct Planejador
+{
+    Labirinto *l;
+    Celula inicio, fim;
+
+    // g e rhs do D* Lite, uma posicao por celula (linha * n_colunas + coluna)
+    double *g;
+    double *rhs;
+
+    // fila de prioridade com as chaves [k1; k2] do D* Lite
+    IndexHeap *fila;
+
+    // soma das distancias percorridas pelo agente (km), que mantem as chaves
+    // antigas da fila como limites inferiores validos
+    double km;
+    Celula ultimo;
+};
+
+int _planejador_indice(Planejador *p, int linha, int coluna)
+{
+    return linha * p->l->n_colunas + coluna;
+}
+
+int _planejador_dentro(Planejador *p, int linha, int coluna)
+{
+    return linha >= 0 && coluna >= 0 && linha < p->l->n_linhas && coluna < p->l->n_colunas;
+}
+
+// distancia euclidiana ate o inicio (a busca vai do fim para o inicio)
+double _planejador_h(Planejador *p, int linha, int coluna)
+{
+    Celula c = {0};
+    c.x = coluna;
+    c.y = linha;
+    return _cell_distance(&c, &p->inicio);
+}
+
+// custo de ir de uma celula para a vizinha na direcao d
+double _planejador_custo(Planejador *p, int linha, int coluna, int d)
+{
+    if (_labirinto_bloqueado(p->l, linha, coluna) || _labirinto_bloqueado(p->l, linha + directions[d][1], coluna + directions[d][0]))
+        return INFINITY;
+
+    return (directions[d][0] && directions[d][1]) ? M_SQRT2 : 1.0;
+}
+
+void _planejador_atualizar(Planejador *p, int linha, int coluna)
+{
+    int u = _planejador_indice(p, linha, coluna);
+
+    if (p->g[u] != p->rhs[u])
+    {
+        double m = p->g[u] < p->rhs[u] ? p->g[u] : p->rhs[u];
+        index_heap_push_tiebreak(p->fila, u, m + _planejador_h(p, linha, coluna) + p->km, m);
+    }
+    else
+        index_heap_remove(p->fila, u);
+}
+
+// recalcula rhs(u) = min sobre os vizinhos s de c(u, s) + g(s)
+void _planejador_recalcular(Planejador *p, int linha, int coluna)
+{
+    if (linha == p->fim.y && coluna == p->fim.x)
+        return;
+
+    double melhor = INFINITY;
+
+    for (int d = 0; d < 8; d++)
+    {
+        int y = linha + directions[d][1], x = coluna + directions[d][0];
+
+        if (!_planejador_dentro(p, y, x))
+            continue;
+
+        double custo = _planejador_custo(p, linha, coluna, d) + p->g[_planejador_indice(p, y, x)];
+
+        if (custo < melhor)
+            melhor = custo;
+    }
+
+    p->rhs[_planejador_indice(p, linha, coluna)] = melhor;
+    _planejador_atualizar(p, linha, coluna);
+}
+
+// as chaves sao somas de double feitas em ordens diferentes (g + h + km), e
+// a mesma chave pode sair com alguns ulps de diferenca
+int _planejador_iguais(double a, double b)
+{
+    if (isinf(a) || isinf(b))
+        return a == b;
+
+    return fabs(a - b) <= PLANEJADOR_TOLERANCIA * (1 + fabs(b));
+}
+
+// compara chaves [a1; a2] < [b1; b2], com tolerancia nos empates
+int _planejador_menor(double a1, double a2, double b1, double b2)
+{
+    if (!_planejador_iguais(a1, b1))
+        return a1 < b1;
+
+    return a2 < b2 && !_planejador_iguais(a2, b2);
+}
+
+// devolve o numero de nos processados; status recebe BUSCA_CONCLUIDA ou o
+// motivo pelo qual o controle parou o reparo
+int _planejador_computar(Planejador *p, ControleBusca *controle, StatusBusca *status)
+{
+    int expandidos = 0;
+    *status = BUSCA_CONCLUIDA;
+    int inicio = _planejador_indice(p, p->inicio.y, p->inicio.x);
+
+    while (!index_heap_empty(p->fila))
+    {
+        double m = p->g[inicio] < p->rhs[inicio] ? p->g[inicio] : p->rhs[inicio];
+        double k1 = m + p->km, topo = index_heap_min_priority(p->fila);
+
+        // so' para com o inicio consistente (com rhs(inicio) != g(inicio) a
+        // descida do caminho, que segue g, pode ficar presa entre duas
+        // celulas) e com o k1 do topo acima do k1 do inicio. Os empates de k1
+        // sao processados sem olhar k2: a fila ordena os valores exatos, e um
+        // empate dentro da tolerancia pode estar atras do topo
+        if (topo > k1 && !_planejador_iguais(topo, k1) && p->rhs[inicio] == p->g[inicio])
+            break;
+
+        // a fila continua valida: o proximo reparo retoma daqui
+        if (expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (*status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        int u = index_heap_min(p->fila);
+        int linha = u / p->l->n_colunas, coluna = u % p->l->n_colunas;
+        double antigo1 = index_heap_min_priority(p->fila), antigo2 = index_heap_min_tiebreak(p->fila);
+
+        double mu = p->g[u] < p->rhs[u] ? p->g[u] : p->rhs[u];
+        double novo1 = mu + _planejador_h(p, linha, coluna) + p->km, novo2 = mu;
+        expandidos++;
+
+        if (_planejador_menor(antigo1, antigo2, novo1, novo2))
+        {
+            // chave desatualizada pelo movimento do agente
+            index_heap_push_tiebreak(p->fila, u, novo1, novo2);
+        }
+        else if (p->g[u] > p->rhs[u])
+        {
+            // localmente sobreconsistente: fixa g e propaga aos vizinhos
+            p->g[u] = p->rhs[u];
+            index_heap_remove(p->fila, u);
+
+            for (int d = 0; d < 8; d++)
+            {
+                int y = linha + directions[d][1], x = coluna + directions[d][0];
+
+                if (!_planejador_dentro(p, y, x) || (y == p->fim.y && x == p->fim.x))
+                    continue;
+
+                int s = _planejador_indice(p, y, x);
+                double custo = _planejador_custo(p, y, x, (d + 4) % 8) + p->g[u];
+
+                if (custo < p->rhs[s])
+                {
+                    p->rhs[s] = custo;
+                    _planejador_atualizar(p, y, x);
+                }
+            }
+        }
+        else
+        {
+            // localmente subconsistente: invalida g e recalcula u e vizinhos
+            p->g[u] = INFINITY;
+            _planejador_recalcular(p, linha, coluna);
+
+            for (int d = 0; d < 8; d++)
+            {
+                int y = linha + directions[d][1], x = coluna + directions[d][0];
+
+                if (_planejador_dentro(p, y, x))
+                    _planejador_recalcular(p, y, x);
+            }
+        }
+    }
+
+    return expandidos;
+}
+
+Planejador *planejador_criar(Labirinto *l, Celula inicio, Celula fim)
+{
+    if (!_labirinto_dentro(l, fim.y, fim.x) || !_labirinto_dentro(l, inicio.y, inicio.x))
+        exit(printf("Inicio (%d, %d) ou fim (%d, %d) fora do labirinto.\n", inicio.x, inicio.y, fim.x, fim.y));
+
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+    Planejador *p = (Planejador *)calloc(1, sizeof(Planejador));
+
+    p->l = l;
+    p->inicio = p->ultimo = inicio;
+    p->fim = fim;
+    p->g = (double *)malloc(n * sizeof(double));
+    p->rhs = (double *)malloc(n * sizeof(double));
+    p->fila = index_heap_construct(n);
+
+    for (size_t i = 0; i < n; i++)
+        p->g[i] = p->rhs[i] = INFINITY;
+
+    int f = _planejador_indice(p, fim.y, fim.x);
+    p->rhs[f] = 0;
+    _planejador_atualizar(p, fim.y, fim.x);
+
+    return p;
+}
+
+void planejador_notificar(Planejador *p, int linha, int coluna)
+{
+    if (!_planejador_dentro(p, linha, coluna))
+        return;
+
+    // todas as arestas da celula mudaram de custo
+    _planejador_recalcular(p, linha, coluna);
+
+    for (int d = 0; d < 8; d++)
+    {
+        int y = linha + directions[d][1], x = coluna + directions[d][0];
+
+        if (_planejador_dentro(p, y, x))
+            _planejador_recalcular(p, y, x);
+    }
+}
+
+void planejador_mover(Planejador *p, Celula inicio)
+{
+    if (!_labirinto_dentro(p->l, inicio.y, inicio.x))
+        exit(printf("Inicio (%d, %d) fora do labirinto.\n", inicio.x, inicio.y));
+
+    p->km += _cell_distance(&p->ultimo, &inicio);
+    p->ultimo = p->inicio = inicio;
+}
+
+ResultData planejador_caminho(Planejador *p, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+    result.nos_expandidos = _planejador_computar(p, controle, &result.status);
+
+    if (result.status != BUSCA_CONCLUIDA)
+        return result;
+
+    int atual = _planejador_indice(p, p->inicio.y, p->inicio.x);
+
+    // ao fim do reparo rhs(inicio) ja e' o custo otimo, mesmo que g(inicio)
+    // nao tenha sido atualizado
+    if (p->rhs[atual] == INFINITY || _labirinto_bloqueado(p->l, p->inicio.y, p->inicio.x))
+        return result;
+
+    int max_tamanho = p->l->n_linhas * p->l->n_colunas;
+    int cap = 64;
+    result.caminho = (Celula *)calloc(cap, sizeof(Celula));
+
+    Celula c = p->inicio;
+    result.caminho[result.tamanho_caminho++] = c;
+
+    // desce o gradiente de g ate o fim
+    while ((c.x != p->fim.x || c.y != p->fim.y) && result.tamanho_caminho <= max_tamanho)
+    {
+        int melhor_d = -1;
+        double melhor = INFINITY;
+
+        for (int d = 0; d < 8; d++)
+        {
+            int y = c.y + directions[d][1], x = c.x + directions[d][0];
+
+            if (!_planejador_dentro(p, y, x))
+                continue;
+
+            double custo = _planejador_custo(p, c.y, c.x, d) + p->g[_planejador_indice(p, y, x)];
+
+            if (custo < melhor)
+            {
+                melhor = custo;
+                melhor_d = d;
+            }
+        }
+
+        if (melhor_d < 0)
+            break;
+
+        Celula prox = {0};
+        prox.x = c.x + directions[melhor_d][0];
+        prox.y = c.y + directions[melhor_d][1];
+        result.custo_caminho += _cell_distance(&c, &prox);
+
+        if (result.tamanho_caminho >= cap)
+        {
+            cap *= 2;
+            result.caminho = (Celula *)realloc(result.caminho, cap * sizeof(Celula));
+        }
+
+        result.caminho[result.tamanho_caminho++] = prox;
+        c = prox;
+    }
+
+    if (c.x != p->fim.x || c.y != p->fim.y)
+    {
+        free(result.caminho);
+        return _default_result();
+    }
+
+    result.sucesso = 1;
+    return result;
+}
+
+void planejador_destruir(Planejador *p)
+{
+    free(p->g);
+    free(p->rhs);
+    index_heap_destroy(p->fila);
+    free(p);
+}
@@ -0,0 +1,32 @@
+
+#ifndef _PLANEJADOR_H_
+#define _PLANEJADOR_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// Planejador incremental (D* Lite). Mantem o estado da busca entre chamadas:
+// quando celulas mudam entre LIVRE e OCUPADO, so a regiao afetada e'
+// recalculada em vez de refazer a busca inteira. A busca parte do fim em
+// direcao ao inicio, o que permite tambem mover o inicio (o agente).
+typedef struct Planejador Planejador;
+
+Planejador *planejador_criar(Labirinto *l, Celula inicio, Celula fim);
+
+// avisa que a celula (linha, coluna) foi alterada com labirinto_atribuir
+// (passou a ser OCUPADO ou deixou de ser)
+void planejador_notificar(Planejador *p, int linha, int coluna);
+
+// atualiza a posicao do agente (o inicio do caminho)
+void planejador_mover(Planejador *p, Celula inicio);
+
+// repara a busca e devolve o caminho atual do inicio ao fim. Em
+// nos_expandidos vem o numero de nos processados neste reparo. O controle
+// (opcional) e' consultado a cada BUSCA_INTERVALO_CONTROLE nos, como em
+// a_star_controlado; um reparo interrompido nao perde o que ja' fez, e a
+// proxima chamada continua de onde ele parou.
+ResultData planejador_caminho(Planejador *p, ControleBusca *controle);
+
+void planejador_destruir(Planejador *p);
+
+#endif
@@ -0,0 +1,214 @@
+#include <math.h>
+#include <stdlib.h>
+#include "qualquer_angulo.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+int linha_de_visao(Labirinto *l, Celula a, Celula b)
+{
+    int nx = abs(b.x - a.x), ny = abs(b.y - a.y);
+    int sx = b.x > a.x ? 1 : -1, sy = b.y > a.y ? 1 : -1;
+    int x = a.x, y = a.y;
+
+    // percorre as celulas cortadas pelo segmento: o sinal de decisao diz se
+    // a proxima borda cruzada e' vertical, horizontal ou um vertice (zero,
+    // passo diagonal sem tocar o interior das duas celulas do lado)
+    for (int ix = 0, iy = 0; ix < nx || iy < ny;)
+    {
+        long decisao = (long)(1 + 2 * ix) * ny - (long)(1 + 2 * iy) * nx;
+
+        if (decisao == 0)
+        {
+            x += sx;
+            y += sy;
+            ix++;
+            iy++;
+        }
+        else if (decisao < 0)
+        {
+            x += sx;
+            ix++;
+        }
+        else
+        {
+            y += sy;
+            iy++;
+        }
+
+        // x e y ficam no retangulo entre a e b; a borda OCUPADO cobre o resto
+        if (_labirinto_bloqueado(l, y, x))
+            return 0;
+    }
+
+    return 1;
+}
+
+double _qualquer_angulo_distancia(int a, int b, int n_colunas)
+{
+    double dx = a % n_colunas - b % n_colunas, dy = a / n_colunas - b / n_colunas;
+    return sqrt(dx * dx + dy * dy);
+}
+
+Celula _qualquer_angulo_celula(int v, int n_colunas)
+{
+    Celula c;
+    c.x = v % n_colunas;
+    c.y = v / n_colunas;
+    c.prev = NULL;
+    c.g = c.h = 0;
+    return c;
+}
+
+ResultData theta_star(Labirinto *l, Celula inicio, Celula fim, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+
+    if (!_labirinto_livre(l, inicio.y, inicio.x) || !_labirinto_livre(l, fim.y, fim.x))
+        return result;
+
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+    int c = l->n_colunas;
+    int origem = inicio.y * c + inicio.x;
+    int alvo = fim.y * c + fim.x;
+
+    double *g = (double *)malloc(n * sizeof(double));
+    int *pai = (int *)malloc(n * sizeof(int));
+    unsigned char *fechado = (unsigned char *)calloc(n, sizeof(unsigned char));
+    IndexHeap *abertos = index_heap_construct(n);
+
+    for (size_t v = 0; v < n; v++)
+    {
+        g[v] = INFINITY;
+        pai[v] = -1;
+    }
+
+    g[origem] = 0;
+    index_heap_push(abertos, origem, _qualquer_angulo_distancia(origem, alvo, c));
+
+    while (!index_heap_empty(abertos))
+    {
+        if (result.nos_expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        int u = index_heap_pop(abertos);
+        int x = u % c, y = u / c;
+
+        fechado[u] = 1;
+        _labirinto_marcar(l, y, x, EXPANDIDO);
+        result.nos_expandidos++;
+
+        if (u == alvo)
+        {
+            result.sucesso = 1;
+            break;
+        }
+
+        for (int i = 0; i < 8; i++)
+        {
+            int nx = x + directions[i][0], ny = y + directions[i][1];
+
+            if (_labirinto_bloqueado(l, ny, nx))
+                continue;
+
+            int v = ny * c + nx;
+            if (fechado[v])
+                continue;
+
+            _labirinto_marcar(l, ny, nx, FRONTEIRA);
+
+            // caminho 2 do Theta*: direto do pai de u, se ele enxerga v
+            int p = pai[u] >= 0 && linha_de_visao(l, _qualquer_angulo_celula(pai[u], c), _qualquer_angulo_celula(v, c)) ? pai[u] : u;
+            double custo = g[p] + _qualquer_angulo_distancia(p, v, c);
+
+            if (custo < g[v])
+            {
+                g[v] = custo;
+                pai[v] = p;
+                index_heap_push(abertos, v, custo + _qualquer_angulo_distancia(v, alvo, c));
+            }
+        }
+    }
+
+    if (result.sucesso)
+    {
+        for (int v = alvo; v >= 0; v = pai[v])
+            result.tamanho_caminho++;
+
+        result.caminho = (Celula *)calloc(result.tamanho_caminho, sizeof(Celula));
+
+        int i = result.tamanho_caminho - 1;
+        for (int v = alvo; v >= 0; v = pai[v])
+            result.caminho[i--] = _qualquer_angulo_celula(v, c);
+
+        result.custo_caminho = g[alvo];
+    }
+
+    free(g);
+    free(pai);
+    free(fechado);
+    index_heap_destroy(abertos);
+
+    return result;
+}
+
+void caminho_suavizar(Labirinto *l, ResultData *result)
+{
+    if (!result->sucesso || result->tamanho_caminho < 3)
+        return;
+
+    Celula *caminho = result->caminho;
+    int n = result->tamanho_caminho;
+    int mantidos = 1;
+
+    result->custo_caminho = 0;
+
+    for (int i = 0; i < n - 1;)
+    {
+        // a visibilidade ao longo do caminho nao e' monotona: o passo dobra
+        // enquanto o ponto ainda e' visivel, a busca binaria entre o ultimo
+        // visivel e o primeiro que nao e' devolve um ponto visivel (nao
+        // necessariamente o mais distante), o que evita testar um a um os
+        // pontos de uma reta longa
+        int visivel = i + 1, passo = 1;
+        int invisivel = n;
+
+        while (visivel + passo < n)
+        {
+            if (!linha_de_visao(l, caminho[i], caminho[visivel + passo]))
+            {
+                invisivel = visivel + passo;
+                break;
+            }
+
+            visivel += passo;
+            passo *= 2;
+        }
+
+        if (invisivel == n && visivel < n - 1)
+        {
+            if (linha_de_visao(l, caminho[i], caminho[n - 1]))
+                visivel = n - 1;
+            else
+                invisivel = n - 1;
+        }
+
+        while (invisivel - visivel > 1)
+        {
+            int meio = (visivel + invisivel) / 2;
+
+            if (linha_de_visao(l, caminho[i], caminho[meio]))
+                visivel = meio;
+            else
+                invisivel = meio;
+        }
+
+        result->custo_caminho += _cell_distance(&caminho[i], &caminho[visivel]);
+
+        // mantidos <= visivel: a compactacao nao sobrescreve o que falta ler
+        caminho[mantidos++] = caminho[visivel];
+        i = visivel;
+    }
+
+    result->tamanho_caminho = mantidos;
+    result->caminho = (Celula *)realloc(caminho, mantidos * sizeof(Celula));
+}
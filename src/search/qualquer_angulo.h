@@ -0,0 +1,34 @@
+#ifndef _QUALQUER_ANGULO_H_
+#define _QUALQUER_ANGULO_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// Caminhos em qualquer angulo: em vez de uma celula por passo, o caminho
+// traz so' os pontos de virada, ligados por segmentos retos entre os centros
+// das celulas, e o custo e' a soma dos comprimentos euclidianos dos
+// segmentos. Um segmento e' valido quando nao atravessa o interior de
+// nenhuma celula OCUPADO; passar exatamente pelo vertice entre duas celulas
+// bloqueadas e' permitido, como o movimento diagonal das outras buscas.
+
+// 1 se o segmento entre os centros de a e b so' atravessa celulas livres
+int linha_de_visao(Labirinto *l, Celula a, Celula b);
+
+/**
+ * @brief Theta*: A* em que cada celula aberta pode ter como pai o pai de
+ * quem a abriu, quando ha linha de visao entre os dois. O caminho tem so' os
+ * pontos de virada e e' em geral bem mais curto que o da grade (nao e'
+ * garantidamente o menor em qualquer angulo). Marca as celulas expandidas e
+ * a fronteira no labirinto, como a_star.
+ * @param controle
+ * Opcional (pode ser NULL), como em a_star_controlado.
+ */
+ResultData theta_star(Labirinto *l, Celula inicio, Celula fim, ControleBusca *controle);
+
+// suavizacao de um caminho ja encontrado (de qualquer busca): a partir de
+// cada ponto mantido, pula para o ponto mais distante do caminho que ainda
+// esta na linha de visao. Substitui result->caminho pelos pontos mantidos e
+// recalcula custo_caminho; nos_expandidos nao muda.
+void caminho_suavizar(Labirinto *l, ResultData *result);
+
+#endif
@@ -0,0 +1,444 @@
+#include <math.h>
+#include <stdlib.h>
+#include "subobjetivos.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+typedef struct
+{
+    int celula;
+    int *vizinhos;
+    int n_vizinhos, cap_vizinhos;
+} NoSubobjetivo;
+
+// estado de uma inundacao: as celulas marcadas sao lembradas em tocados
+// para que o mapa de bits seja limpo sem percorrer o labirinto inteiro
+typedef struct
+{
+    uint64_t *visitado;
+    int *pilha;
+    int *tocados;
+    int n_tocados;
+} _Inundacao;
+
+struct GrafoSubobjetivos
+{
+    Labirinto *l;
+
+    NoSubobjetivo *nos;
+    int n_nos, n_arestas;
+
+    // id do subobjetivo de cada celula (linha * n_colunas + coluna), ou -1
+    int *no_celula;
+
+    // buffers das inundacoes, da construcao e das consultas; cada inundacao
+    // deixa o mapa de bits limpo ao terminar
+    _Inundacao inundacao;
+};
+
+// lista de ids sem repeticoes
+typedef struct
+{
+    int *ids;
+    int n, cap;
+} _ListaIds;
+
+void _subobjetivos_lista_adicionar(_ListaIds *lista, int id)
+{
+    for (int i = 0; i < lista->n; i++)
+        if (lista->ids[i] == id)
+            return;
+
+    if (lista->n == lista->cap)
+    {
+        lista->cap = lista->cap ? 2 * lista->cap : 8;
+        lista->ids = (int *)realloc(lista->ids, lista->cap * sizeof(int));
+    }
+
+    lista->ids[lista->n++] = id;
+}
+
+double _subobjetivos_octil(GrafoSubobjetivos *g, int a, int b)
+{
+    int dx = abs(a % g->l->n_colunas - b % g->l->n_colunas);
+    int dy = abs(a / g->l->n_colunas - b / g->l->n_colunas);
+    int menor = dx < dy ? dx : dy;
+    return (dx + dy - 2 * menor) + M_SQRT2 * menor;
+}
+
+// celula livre com um vizinho cardeal bloqueado que pode ser contornado:
+// ao lado do obstaculo, numa direcao perpendicular, ha uma celula livre
+// alcancavel em diagonal (o movimento diagonal so' exige o destino livre)
+int _subobjetivos_canto(Labirinto *l, int linha, int coluna)
+{
+    for (int o = 0; o < 8; o += 2)
+    {
+        if (!_labirinto_bloqueado(l, linha + directions[o][1], coluna + directions[o][0]))
+            continue;
+
+        for (int lado = 2; lado <= 6; lado += 4)
+        {
+            int p = (o + lado) % 8;
+
+            if (!_labirinto_bloqueado(l, linha + directions[o][1] + directions[p][1], coluna + directions[o][0] + directions[p][0]))
+                return 1;
+        }
+    }
+
+    return 0;
+}
+
+_Inundacao _subobjetivos_inundacao(Labirinto *l)
+{
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+
+    _Inundacao w;
+    w.visitado = (uint64_t *)calloc(n / 64 + 1, sizeof(uint64_t));
+    w.pilha = (int *)malloc(n * sizeof(int));
+    w.tocados = (int *)malloc(n * sizeof(int));
+    w.n_tocados = 0;
+    return w;
+}
+
+void _subobjetivos_liberar_inundacao(_Inundacao *w)
+{
+    free(w->visitado);
+    free(w->pilha);
+    free(w->tocados);
+}
+
+// celulas h-alcancaveis a partir de origem usando so' os movimentos k e
+// k + 1 (um octante). Nao atravessa subobjetivos: os que encontra entram em
+// encontrados.
+void _subobjetivos_inundar(GrafoSubobjetivos *g, _Inundacao *w, int origem, int k, _ListaIds *encontrados)
+{
+    Labirinto *l = g->l;
+    int n_pilha = 0;
+
+    w->pilha[n_pilha++] = origem;
+
+    while (n_pilha > 0)
+    {
+        int u = w->pilha[--n_pilha];
+        int y = u / l->n_colunas, x = u % l->n_colunas;
+
+        for (int m = k; m <= k + 1; m++)
+        {
+            int d = m % 8;
+            int ny = y + directions[d][1], nx = x + directions[d][0];
+
+            if (_labirinto_bloqueado(l, ny, nx))
+                continue;
+
+            int v = ny * l->n_colunas + nx;
+
+            if (v == origem || (w->visitado[v >> 6] >> (v & 63)) & 1)
+                continue;
+
+            w->visitado[v >> 6] |= 1ULL << (v & 63);
+            w->tocados[w->n_tocados++] = v;
+
+            if (g->no_celula[v] >= 0)
+                _subobjetivos_lista_adicionar(encontrados, g->no_celula[v]);
+            else
+                w->pilha[n_pilha++] = v;
+        }
+    }
+
+    for (int i = 0; i < w->n_tocados; i++)
+        w->visitado[w->tocados[i] >> 6] &= ~(1ULL << (w->tocados[i] & 63));
+    w->n_tocados = 0;
+}
+
+void _subobjetivos_vizinhanca(GrafoSubobjetivos *g, _Inundacao *w, int origem, _ListaIds *encontrados)
+{
+    for (int k = 0; k < 8; k++)
+        _subobjetivos_inundar(g, w, origem, k, encontrados);
+}
+
+GrafoSubobjetivos *subobjetivos_construir(Labirinto *l)
+{
+    GrafoSubobjetivos *g = (GrafoSubobjetivos *)calloc(1, sizeof(GrafoSubobjetivos));
+    g->l = l;
+
+    size_t n = (size_t)l->n_linhas * l->n_colunas;
+    g->no_celula = (int *)malloc(n * sizeof(int));
+
+    for (size_t v = 0; v < n; v++)
+    {
+        int y = v / l->n_colunas, x = v % l->n_colunas;
+        g->no_celula[v] = -1;
+
+        if (!_labirinto_bloqueado(l, y, x) && _subobjetivos_canto(l, y, x))
+            g->no_celula[v] = g->n_nos++;
+    }
+
+    g->nos = (NoSubobjetivo *)calloc(g->n_nos > 0 ? g->n_nos : 1, sizeof(NoSubobjetivo));
+    for (size_t v = 0; v < n; v++)
+        if (g->no_celula[v] >= 0)
+            g->nos[g->no_celula[v]].celula = v;
+
+    g->inundacao = _subobjetivos_inundacao(l);
+
+    for (int i = 0; i < g->n_nos; i++)
+    {
+        _ListaIds vizinhos = {0};
+        _subobjetivos_vizinhanca(g, &g->inundacao, g->nos[i].celula, &vizinhos);
+
+        g->nos[i].vizinhos = vizinhos.ids;
+        g->nos[i].n_vizinhos = vizinhos.n;
+        g->nos[i].cap_vizinhos = vizinhos.cap;
+        g->n_arestas += vizinhos.n;
+    }
+
+    return g;
+}
+
+// caminho h-alcancavel de a ate b, gravado em saida (max(|dx|, |dy|) + 1
+// celulas). Todo passo avanca 1 no eixo dominante, entao o estado e' (passo,
+// diagonais usadas); a busca em profundidade descarta estados sem saida.
+// Cada estado e' uma celula distinta do paralelogramo entre a e b, entao os
+// estados mortos sao marcados no mapa de bits das inundacoes e o trabalho e'
+// proporcional as celulas visitadas, nao a area do paralelogramo.
+// Devolve o numero de celulas, ou 0 se nao existe caminho com custo octil.
+int _subobjetivos_trecho(GrafoSubobjetivos *g, int a, int b, Celula *saida)
+{
+    Labirinto *l = g->l;
+    _Inundacao *w = &g->inundacao;
+    int ax = a % l->n_colunas, ay = a / l->n_colunas;
+    int dx = b % l->n_colunas - ax, dy = b / l->n_colunas - ay;
+    int sx = (dx > 0) - (dx < 0), sy = (dy > 0) - (dy < 0);
+
+    int maior = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+    int menor = abs(dx) > abs(dy) ? abs(dy) : abs(dx);
+
+    // movimento diagonal e cardeal (ao longo do eixo dominante) do octante
+    int diag_x = sx, diag_y = sy;
+    int card_x = abs(dx) >= abs(dy) ? sx : 0, card_y = abs(dx) >= abs(dy) ? 0 : sy;
+
+    // diagonais usadas ate cada passo e a proxima opcao a tentar
+    int *diagonais = (int *)malloc((maior + 1) * sizeof(int));
+    unsigned char *opcao = (unsigned char *)malloc((maior + 1) * sizeof(unsigned char));
+
+    int passo = 0;
+    diagonais[0] = 0;
+    opcao[0] = 0;
+
+    while (passo >= 0 && passo < maior)
+    {
+        int j = diagonais[passo];
+
+        if (opcao[passo] == 2)
+        {
+            int v = (ay + j * diag_y + (passo - j) * card_y) * l->n_colunas + ax + j * diag_x + (passo - j) * card_x;
+            w->visitado[v >> 6] |= 1ULL << (v & 63);
+            w->tocados[w->n_tocados++] = v;
+            passo--;
+            continue;
+        }
+
+        // diagonal primeiro; cada tipo de movimento tem um numero fixo de usos
+        int diagonal = opcao[passo]++ == 0;
+        int nj = j + diagonal;
+
+        if (nj > menor || (passo + 1 - nj) > maior - menor)
+            continue;
+
+        int cx = ax + nj * diag_x + (passo + 1 - nj) * card_x;
+        int cy = ay + nj * diag_y + (passo + 1 - nj) * card_y;
+
+        if (_labirinto_bloqueado(l, cy, cx))
+            continue;
+
+        int v = cy * l->n_colunas + cx;
+        if ((w->visitado[v >> 6] >> (v & 63)) & 1)
+            continue;
+
+        passo++;
+        diagonais[passo] = nj;
+        opcao[passo] = 0;
+    }
+
+    int tamanho = 0;
+
+    if (passo == maior)
+    {
+        tamanho = maior + 1;
+
+        for (int p = 0; p <= maior; p++)
+        {
+            saida[p].x = ax + diagonais[p] * diag_x + (p - diagonais[p]) * card_x;
+            saida[p].y = ay + diagonais[p] * diag_y + (p - diagonais[p]) * card_y;
+        }
+    }
+
+    for (int i = 0; i < w->n_tocados; i++)
+        w->visitado[w->tocados[i] >> 6] &= ~(1ULL << (w->tocados[i] & 63));
+    w->n_tocados = 0;
+
+    free(diagonais);
+    free(opcao);
+
+    return tamanho;
+}
+
+ResultData subobjetivos_buscar(GrafoSubobjetivos *g, Celula inicio, Celula fim, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+    Labirinto *l = g->l;
+
+    if (!_labirinto_livre(l, inicio.y, inicio.x) || !_labirinto_livre(l, fim.y, fim.x))
+        return result;
+
+    int origem = inicio.y * l->n_colunas + inicio.x;
+    int alvo = fim.y * l->n_colunas + fim.x;
+
+    // fim h-alcancavel a partir do inicio: a linha octil e' minima. Testado
+    // antes das inundacoes, que param nos subobjetivos e nao acham uma linha
+    // octil que passa por eles; essa so' sairia do A* no grafo, bem mais caro.
+    int maior = abs(fim.x - inicio.x) > abs(fim.y - inicio.y) ? abs(fim.x - inicio.x) : abs(fim.y - inicio.y);
+    Celula *direto = (Celula *)calloc(maior + 1, sizeof(Celula));
+    int tamanho = _subobjetivos_trecho(g, origem, alvo, direto);
+
+    if (tamanho > 0)
+    {
+        result.caminho = direto;
+        result.tamanho_caminho = tamanho;
+        result.custo_caminho = _subobjetivos_octil(g, origem, alvo);
+        result.sucesso = 1;
+        return result;
+    }
+    free(direto);
+
+    // nos temporarios n e n + 1 para inicio e fim que nao sao subobjetivos
+    int n = g->n_nos;
+    int no_inicio = g->no_celula[origem] >= 0 ? g->no_celula[origem] : n;
+    int no_fim = g->no_celula[alvo] >= 0 ? g->no_celula[alvo] : n + 1;
+
+    _ListaIds saidas = {0}, chegadas = {0};
+
+    if (no_inicio == n)
+        _subobjetivos_vizinhanca(g, &g->inundacao, origem, &saidas);
+    if (no_fim == n + 1)
+        _subobjetivos_vizinhanca(g, &g->inundacao, alvo, &chegadas);
+
+    // subobjetivos que alcancam o fim temporario diretamente
+    unsigned char *liga_fim = (unsigned char *)calloc(n + 2, sizeof(unsigned char));
+    for (int i = 0; i < chegadas.n; i++)
+        liga_fim[chegadas.ids[i]] = 1;
+
+    double *custo = (double *)malloc((n + 2) * sizeof(double));
+    int *pai = (int *)malloc((n + 2) * sizeof(int));
+    unsigned char *fechado = (unsigned char *)calloc(n + 2, sizeof(unsigned char));
+    IndexHeap *abertos = index_heap_construct(n + 2);
+
+    for (int i = 0; i < n + 2; i++)
+    {
+        custo[i] = INFINITY;
+        pai[i] = -1;
+    }
+
+    custo[no_inicio] = 0;
+    index_heap_push(abertos, no_inicio, _subobjetivos_octil(g, origem, alvo));
+
+    while (!index_heap_empty(abertos))
+    {
+        if (result.nos_expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        int u = index_heap_pop(abertos);
+        fechado[u] = 1;
+        result.nos_expandidos++;
+
+        if (u == no_fim)
+            break;
+
+        int celula_u = u < n ? g->nos[u].celula : origem;
+        int *vizinhos = u < n ? g->nos[u].vizinhos : saidas.ids;
+        int n_vizinhos = u < n ? g->nos[u].n_vizinhos : saidas.n;
+
+        // o fim temporario entra como mais um vizinho de quem o alcanca
+        for (int i = 0; i <= n_vizinhos; i++)
+        {
+            int v = i < n_vizinhos ? vizinhos[i] : (liga_fim[u] ? no_fim : -1);
+
+            if (v < 0 || fechado[v])
+                continue;
+
+            int celula_v = v < n ? g->nos[v].celula : alvo;
+            double c = custo[u] + _subobjetivos_octil(g, celula_u, celula_v);
+
+            if (c < custo[v])
+            {
+                custo[v] = c;
+                pai[v] = u;
+                index_heap_push(abertos, v, c + _subobjetivos_octil(g, celula_v, alvo));
+            }
+        }
+    }
+
+    if (fechado[no_fim])
+    {
+        // celulas de cada aresta, sem repetir a celula de juncao
+        int n_nos_caminho = 0;
+        for (int v = no_fim; v >= 0; v = pai[v])
+            n_nos_caminho++;
+
+        int *nos_caminho = (int *)malloc(n_nos_caminho * sizeof(int));
+        for (int v = no_fim, i = n_nos_caminho - 1; v >= 0; v = pai[v], i--)
+            nos_caminho[i] = v < n ? g->nos[v].celula : (v == n ? origem : alvo);
+
+        tamanho = 1;
+        for (int i = 1; i < n_nos_caminho; i++)
+        {
+            int dx = abs(nos_caminho[i] % l->n_colunas - nos_caminho[i - 1] % l->n_colunas);
+            int dy = abs(nos_caminho[i] / l->n_colunas - nos_caminho[i - 1] / l->n_colunas);
+            tamanho += dx > dy ? dx : dy;
+        }
+
+        result.caminho = (Celula *)calloc(tamanho, sizeof(Celula));
+        result.caminho[0] = inicio;
+        result.tamanho_caminho = 1;
+
+        for (int i = 1; i < n_nos_caminho; i++)
+        {
+            int t = _subobjetivos_trecho(g, nos_caminho[i - 1], nos_caminho[i], result.caminho + result.tamanho_caminho - 1);
+            result.tamanho_caminho += t - 1;
+        }
+
+        result.custo_caminho = custo[no_fim];
+        result.sucesso = 1;
+        free(nos_caminho);
+    }
+
+    free(saidas.ids);
+    free(chegadas.ids);
+    free(liga_fim);
+    free(custo);
+    free(pai);
+    free(fechado);
+    index_heap_destroy(abertos);
+
+    return result;
+}
+
+int subobjetivos_n_nos(GrafoSubobjetivos *g)
+{
+    return g->n_nos;
+}
+
+int subobjetivos_n_arestas(GrafoSubobjetivos *g)
+{
+    return g->n_arestas;
+}
+
+void subobjetivos_destruir(GrafoSubobjetivos *g)
+{
+    for (int i = 0; i < g->n_nos; i++)
+        free(g->nos[i].vizinhos);
+
+    free(g->nos);
+    free(g->no_celula);
+    _subobjetivos_liberar_inundacao(&g->inundacao);
+    free(g);
+}
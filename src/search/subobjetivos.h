@@ -0,0 +1,31 @@
+#ifndef _SUBOBJETIVOS_H_
+#define _SUBOBJETIVOS_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// Grafo de subobjetivos simples (SSG): os subobjetivos sao as celulas livres
+// junto aos cantos convexos dos obstaculos, onde os caminhos minimos podem
+// dobrar. Dois subobjetivos sao ligados quando um e' diretamente
+// h-alcancavel a partir do outro: existe um caminho com o custo da distancia
+// octil (so' com os dois movimentos de um octante) que nao passa por outro
+// subobjetivo. Como hpa_construir, o grafo e' construido uma vez, nao e'
+// alterado pelas buscas e deve ser reconstruido se o labirinto mudar.
+typedef struct GrafoSubobjetivos GrafoSubobjetivos;
+
+GrafoSubobjetivos *subobjetivos_construir(Labirinto *l);
+
+// liga inicio e fim aos subobjetivos diretamente h-alcancaveis, faz A* no
+// grafo com a distancia octil e expande cada aresta em celulas. O caminho e'
+// minimo. nos_expandidos conta os nos do grafo. Nao marca o labirinto, mas
+// usa memoria de trabalho do grafo: duas buscas nao podem rodar ao mesmo
+// tempo sobre o mesmo grafo. O controle (opcional) e' consultado a cada
+// BUSCA_INTERVALO_CONTROLE nos do grafo, como em a_star_controlado.
+ResultData subobjetivos_buscar(GrafoSubobjetivos *g, Celula inicio, Celula fim, ControleBusca *controle);
+
+int subobjetivos_n_nos(GrafoSubobjetivos *g);
+int subobjetivos_n_arestas(GrafoSubobjetivos *g);
+
+void subobjetivos_destruir(GrafoSubobjetivos *g);
+
+#endif
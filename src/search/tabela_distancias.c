@@ -0,0 +1,178 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tabela_distancias.h"
+#include "dijkstra.h"
+#include "labirinto_interno.h"
+
+TabelaDistancias *distance_table(Labirinto *l, Celula *sources, int m, Celula *targets, int n)
+{
+    TabelaDistancias *t = (TabelaDistancias *)calloc(1, sizeof(TabelaDistancias));
+    t->m = m;
+    t->n = n;
+    t->n_linhas = labirinto_n_linhas(l);
+    t->n_colunas = labirinto_n_colunas(l);
+    t->origens = (Celula *)malloc(m * sizeof(Celula));
+    t->alvos = (Celula *)malloc(n * sizeof(Celula));
+    t->custos = (double *)malloc((size_t)m * n * sizeof(double));
+    t->celula = (int **)calloc(m, sizeof(int *));
+    t->pai = (int **)calloc(m, sizeof(int *));
+    t->no_alvo = (int *)malloc((size_t)m * n * sizeof(int));
+
+    memcpy(t->origens, sources, m * sizeof(Celula));
+    memcpy(t->alvos, targets, n * sizeof(Celula));
+
+    Regiao regiao = regiao_labirinto(l);
+    size_t n_celulas = (size_t)t->n_linhas * t->n_colunas;
+    double *dist = (double *)malloc(n_celulas * sizeof(double));
+    unsigned char *dir = (unsigned char *)malloc(n_celulas * sizeof(unsigned char));
+
+    // alvos fora do mapa ou bloqueados ficam de fora da busca (que senao
+    // nunca os fecharia e exploraria o mapa inteiro) e com custo infinito
+    int *indices = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+    int n_validos = 0;
+
+    for (int j = 0; j < n; j++)
+        if (_labirinto_livre(l, targets[j].y, targets[j].x))
+            indices[n_validos++] = regiao_indice(&regiao, targets[j].y, targets[j].x);
+
+    // no de cada celula na arvore da origem atual, valido onde marca == i + 1
+    int *no = (int *)malloc(n_celulas * sizeof(int));
+    int *marca = (int *)calloc(n_celulas, sizeof(int));
+    int cap_nos = 64, n_nos;
+    int *celula = (int *)malloc(cap_nos * sizeof(int));
+    int *pai = (int *)malloc(cap_nos * sizeof(int));
+
+    for (int i = 0; i < m; i++)
+    {
+        dijkstra_regiao(l, regiao, sources[i].y, sources[i].x, dist, dir, indices, n_validos);
+        n_nos = 0;
+
+        for (int j = 0; j < n; j++)
+        {
+            size_t k = (size_t)i * n + j;
+            t->custos[k] = INFINITY;
+            t->no_alvo[k] = -1;
+
+            if (!_labirinto_livre(l, targets[j].y, targets[j].x))
+                continue;
+
+            int v = regiao_indice(&regiao, targets[j].y, targets[j].x);
+            if (isinf(dist[v]))
+                continue;
+
+            t->custos[k] = dist[v];
+
+            // sobe pelos predecessores ate um no ja' criado ou a origem,
+            // criando os nos do ramo; o pai de cada um e' o no criado a seguir
+            int anterior = -1;
+
+            while (1)
+            {
+                if (marca[v] == i + 1)
+                {
+                    if (anterior >= 0)
+                        pai[anterior] = no[v];
+                    else
+                        t->no_alvo[k] = no[v];
+                    break;
+                }
+
+                if (n_nos == cap_nos)
+                {
+                    cap_nos *= 2;
+                    celula = (int *)realloc(celula, cap_nos * sizeof(int));
+                    pai = (int *)realloc(pai, cap_nos * sizeof(int));
+                }
+
+                marca[v] = i + 1;
+                no[v] = n_nos;
+                celula[n_nos] = v;
+                pai[n_nos] = -1;
+
+                if (anterior >= 0)
+                    pai[anterior] = n_nos;
+                else
+                    t->no_alvo[k] = n_nos;
+
+                anterior = n_nos++;
+
+                if (dir[v] == DIRECAO_NENHUMA)
+                    break;
+
+                v += directions[dir[v]][1] * t->n_colunas + directions[dir[v]][0];
+            }
+        }
+
+        t->celula[i] = (int *)malloc((n_nos > 0 ? n_nos : 1) * sizeof(int));
+        t->pai[i] = (int *)malloc((n_nos > 0 ? n_nos : 1) * sizeof(int));
+        memcpy(t->celula[i], celula, n_nos * sizeof(int));
+        memcpy(t->pai[i], pai, n_nos * sizeof(int));
+    }
+
+    free(celula);
+    free(pai);
+    free(no);
+    free(marca);
+    free(indices);
+    free(dir);
+    free(dist);
+
+    return t;
+}
+
+double tabela_distancias_custo(TabelaDistancias *t, int origem, int alvo)
+{
+    if (origem < 0 || origem >= t->m || alvo < 0 || alvo >= t->n)
+        exit(printf("Indice (%d, %d) invalido para a tabela de distancias.\n", origem, alvo));
+
+    return t->custos[(size_t)origem * t->n + alvo];
+}
+
+ResultData tabela_distancias_caminho(TabelaDistancias *t, int origem, int alvo)
+{
+    ResultData result = _default_result();
+
+    if (isinf(tabela_distancias_custo(t, origem, alvo)))
+        return result;
+
+    int *celula = t->celula[origem], *pai = t->pai[origem];
+    int no_alvo = t->no_alvo[(size_t)origem * t->n + alvo];
+
+    // conta os nos seguindo os pais ate a origem
+    int tamanho = 0;
+    for (int k = no_alvo; k >= 0; k = pai[k])
+        tamanho++;
+
+    result.caminho = (Celula *)calloc(tamanho, sizeof(Celula));
+    result.tamanho_caminho = tamanho;
+    result.custo_caminho = tabela_distancias_custo(t, origem, alvo);
+    result.sucesso = 1;
+
+    int i = tamanho - 1;
+    for (int k = no_alvo; k >= 0; k = pai[k], i--)
+    {
+        result.caminho[i].x = celula[k] % t->n_colunas;
+        result.caminho[i].y = celula[k] / t->n_colunas;
+    }
+
+    return result;
+}
+
+void tabela_distancias_destruir(TabelaDistancias *t)
+{
+    for (int i = 0; i < t->m; i++)
+    {
+        free(t->celula[i]);
+        free(t->pai[i]);
+    }
+
+    free(t->celula);
+    free(t->pai);
+    free(t->no_alvo);
+    free(t->custos);
+    free(t->origens);
+    free(t->alvos);
+    free(t);
+}
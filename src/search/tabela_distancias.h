@@ -0,0 +1,43 @@
+#ifndef _TABELA_DISTANCIAS_H_
+#define _TABELA_DISTANCIAS_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// Custos de M origens para N alvos, calculados com uma busca de Dijkstra por
+// origem. Guarda tambem, de cada busca, so' os ramos da arvore de caminhos
+// minimos que levam aos alvos, para que os caminhos sejam reconstruidos sob
+// demanda sem buscar novamente.
+typedef struct
+{
+    int m, n;
+    Celula *origens;
+    Celula *alvos;
+
+    // matriz m x n por linhas: custos[i * n + j] vai da origem i ao alvo j,
+    // ou INFINITY se nao ha caminho
+    double *custos;
+
+    // por origem i, os nos da arvore: celula[i][k] e' o indice
+    // (linha * n_colunas + coluna) do no k e pai[i][k] o no anterior no
+    // caminho a partir da origem (-1 na propria origem). Os ramos em comum
+    // de varios alvos sao guardados uma vez so'.
+    int **celula;
+    int **pai;
+
+    // matriz m x n com o no do alvo j na arvore da origem i, ou -1
+    int *no_alvo;
+    int n_linhas, n_colunas;
+} TabelaDistancias;
+
+// cada busca para assim que todos os alvos forem fechados
+TabelaDistancias *distance_table(Labirinto *l, Celula *sources, int m, Celula *targets, int n);
+
+double tabela_distancias_custo(TabelaDistancias *t, int origem, int alvo);
+
+// caminho da origem ao alvo, no mesmo formato das outras buscas (o numero
+// de nos expandidos vem zerado)
+ResultData tabela_distancias_caminho(TabelaDistancias *t, int origem, int alvo);
+void tabela_distancias_destruir(TabelaDistancias *t);
+
+#endif
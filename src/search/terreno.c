@@ -0,0 +1,82 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "terreno.h"
+#include "vizinhanca.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+TabelaTerreno terreno_tabela_padrao()
+{
+    TabelaTerreno t;
+
+    for (int v = 0; v < 256; v++)
+    {
+        t.custo[v] = 1.0;
+        t.definido[v] = 0;
+    }
+
+    t.custo[OCUPADO] = INFINITY;
+    t.custo_min = 1.0;
+
+    return t;
+}
+
+void terreno_definir(TabelaTerreno *t, unsigned char valor, double custo)
+{
+    if (valor != LIVRE && valor < TERRENO_MIN)
+        exit(printf("Valor %d nao e' um terreno (use LIVRE ou valores a partir de %d).\n", valor, TERRENO_MIN));
+
+    if (!(custo > 0) || isinf(custo))
+        exit(printf("Custo %lf invalido para o terreno %d.\n", custo, valor));
+
+    t->custo[valor] = custo;
+    t->definido[valor] = 1;
+
+    // as marcas das buscas e os terrenos nao definidos seguem o custo de LIVRE
+    if (valor == LIVRE)
+        for (int v = OCUPADO + 1; v < 256; v++)
+            if (!t->definido[v])
+                t->custo[v] = custo;
+
+    // so' LIVRE e os valores definidos: os outros nao baixam o minimo
+    t->custo_min = t->custo[LIVRE];
+    for (int v = TERRENO_MIN; v < 256; v++)
+        if (t->definido[v] && t->custo[v] < t->custo_min)
+            t->custo_min = t->custo[v];
+}
+
+// menor custo entre os valores presentes no labirinto (LIVRE e terrenos),
+// que cada passo paga ao menos por unidade de comprimento
+double _terreno_escala(Labirinto *l, TabelaTerreno *t)
+{
+    double escala = INFINITY;
+
+    for (int v = 0; v < 256; v++)
+        if (v != OCUPADO && l->n_conteudo[v] > 0 && t->custo[v] < escala)
+            escala = t->custo[v];
+
+    return escala < INFINITY ? escala : t->custo_min;
+}
+
+// o mesmo motor de vizinhanca.c, com 8 vizinhos, o custo de terreno em cada
+// passo e a distancia octil em unidades de escala (ver _terreno_escala)
+#define MOTOR_NOME _a_star_terreno
+#define MOTOR_ARGUMENTOS , TabelaTerreno *terreno, double escala
+#define MOTOR_VIZINHOS _MOTOR_CARDINAIS _MOTOR_DIAGONAIS
+#define MOTOR_QUINA(dx, dy)
+#define MOTOR_CUSTO(dx, dy, comprimento) terreno_custo_passo(terreno, _labirinto_terreno(l, y, x), _labirinto_terreno(l, y + (dy), x + (dx)), (dx) && (dy))
+#define MOTOR_HEURISTICA(cx, cy) (escala * _MOTOR_OCTIL(cx, cy))
+#include "vizinhanca_motor.h"
+
+ResultData a_star_terreno(Labirinto *l, Celula inicio, Celula fim, TabelaTerreno *terreno, ControleBusca *controle)
+{
+    if (!_labirinto_livre(l, inicio.y, inicio.x) || !_labirinto_livre(l, fim.y, fim.x))
+        return _default_result();
+
+    ContextoVizinhanca *contexto = contexto_vizinhanca_criar();
+    ResultData result = _a_star_terreno(l, inicio, fim, terreno, _terreno_escala(l, terreno), contexto, controle);
+    contexto_vizinhanca_destruir(contexto);
+
+    return result;
+}
@@ -0,0 +1,50 @@
+#ifndef _TERRENO_H_
+#define _TERRENO_H_
+
+#include <math.h>
+#include "labirinto.h"
+#include "algorithms.h"
+
+/**
+ * Custo de travessia de cada valor de celula (ver TERRENO_MIN). O custo de
+ * um passo e' o seu comprimento (1 ou sqrt(2)) vezes a media dos custos das
+ * duas celulas, o que mantem os custos simetricos. As buscas leem o terreno
+ * do proprio byte da celula, que as marcas de outras buscas nao cobrem; a
+ * tabela tem 256 posicoes e e' compartilhada pelas buscas.
+ */
+typedef struct
+{
+    // INFINITY para OCUPADO. As marcas das buscas (FRONTEIRA a FIM) e os
+    // terrenos ainda nao definidos custam o mesmo que LIVRE.
+    double custo[256];
+
+    // valores passados a terreno_definir
+    unsigned char definido[256];
+
+    // menor custo entre LIVRE e os terrenos definidos
+    double custo_min;
+} TabelaTerreno;
+
+// todas as celulas livres com custo 1, como nas buscas sem terreno
+TabelaTerreno terreno_tabela_padrao();
+
+// custo (positivo) de LIVRE ou de um terreno (valor >= TERRENO_MIN)
+void terreno_definir(TabelaTerreno *t, unsigned char valor, double custo);
+
+static inline double terreno_custo_passo(TabelaTerreno *t, unsigned char de, unsigned char para, int diagonal)
+{
+    return (diagonal ? M_SQRT2 : 1.0) * 0.5 * (t->custo[de] + t->custo[para]);
+}
+
+/**
+ * @brief A* de 8 vizinhos com os custos de terreno (g) e, como heuristica, a
+ * distancia octil vezes o menor custo entre os valores presentes no
+ * labirinto, o que a mantem admissivel. O caminho e' minimo para os custos
+ * da tabela.
+ * @param controle
+ * Opcional (pode ser NULL), como em a_star_controlado.
+ * Nao marca celulas no labirinto.
+ */
+ResultData a_star_terreno(Labirinto *l, Celula inicio, Celula fim, TabelaTerreno *terreno, ControleBusca *controle);
+
+#endif
@@ -0,0 +1,103 @@
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vizinhanca.h"
+#include "labirinto_interno.h"
+#include "../ed/index_heap.h"
+
+#define MOTOR_NOME _a_star_vizinhanca_4
+#define MOTOR_ARGUMENTOS
+#define MOTOR_VIZINHOS _MOTOR_CARDINAIS
+#define MOTOR_QUINA(dx, dy)
+#define MOTOR_CUSTO(dx, dy, comprimento) (comprimento)
+#define MOTOR_HEURISTICA _MOTOR_MANHATTAN
+#include "vizinhanca_motor.h"
+
+#define MOTOR_NOME _a_star_vizinhanca_8
+#define MOTOR_ARGUMENTOS
+#define MOTOR_VIZINHOS _MOTOR_CARDINAIS _MOTOR_DIAGONAIS
+#define MOTOR_QUINA(dx, dy)
+#define MOTOR_CUSTO(dx, dy, comprimento) (comprimento)
+#define MOTOR_HEURISTICA _MOTOR_OCTIL
+#include "vizinhanca_motor.h"
+
+#define MOTOR_NOME _a_star_vizinhanca_8_sem_quinas
+#define MOTOR_ARGUMENTOS
+#define MOTOR_VIZINHOS _MOTOR_CARDINAIS _MOTOR_DIAGONAIS
+#define MOTOR_QUINA(dx, dy) && !_labirinto_bloqueado(l, y, x + (dx)) && !_labirinto_bloqueado(l, y + (dy), x)
+#define MOTOR_CUSTO(dx, dy, comprimento) (comprimento)
+#define MOTOR_HEURISTICA _MOTOR_OCTIL
+#include "vizinhanca_motor.h"
+
+ContextoVizinhanca *contexto_vizinhanca_criar()
+{
+    return (ContextoVizinhanca *)calloc(1, sizeof(ContextoVizinhanca));
+}
+
+void contexto_vizinhanca_destruir(ContextoVizinhanca *contexto)
+{
+    free(contexto->g);
+    free(contexto->pai);
+    free(contexto->marca);
+    if (contexto->abertos)
+        index_heap_destroy(contexto->abertos);
+    free(contexto);
+}
+
+void _contexto_vizinhanca_preparar(ContextoVizinhanca *contexto, size_t n)
+{
+    if (n > contexto->capacidade)
+    {
+        free(contexto->g);
+        free(contexto->pai);
+        free(contexto->marca);
+        if (contexto->abertos)
+            index_heap_destroy(contexto->abertos);
+
+        contexto->capacidade = n;
+        contexto->g = (double *)malloc(n * sizeof(double));
+        contexto->pai = (int *)malloc(n * sizeof(int));
+        contexto->marca = (unsigned *)calloc(n, sizeof(unsigned));
+        contexto->abertos = index_heap_construct(n);
+        contexto->geracao = 0;
+    }
+
+    // cada busca usa duas marcas; perto do fim dos valores, recomeca do zero
+    if (contexto->geracao >= UINT_MAX - 3)
+    {
+        memset(contexto->marca, 0, contexto->capacidade * sizeof(unsigned));
+        contexto->geracao = 0;
+    }
+
+    contexto->geracao += 2;
+    index_heap_clear(contexto->abertos);
+}
+
+ResultData a_star_vizinhanca(Labirinto *l, Celula inicio, Celula fim, Vizinhanca vizinhanca, ControleBusca *controle)
+{
+    ContextoVizinhanca *contexto = contexto_vizinhanca_criar();
+    ResultData result = a_star_vizinhanca_contexto(l, inicio, fim, vizinhanca, contexto, controle);
+    contexto_vizinhanca_destruir(contexto);
+
+    return result;
+}
+
+ResultData a_star_vizinhanca_contexto(Labirinto *l, Celula inicio, Celula fim, Vizinhanca vizinhanca, ContextoVizinhanca *contexto, ControleBusca *controle)
+{
+    if (!_labirinto_livre(l, inicio.y, inicio.x) || !_labirinto_livre(l, fim.y, fim.x))
+        return _default_result();
+
+    switch (vizinhanca)
+    {
+    case VIZINHANCA_4:
+        return _a_star_vizinhanca_4(l, inicio, fim, contexto, controle);
+    case VIZINHANCA_8:
+        return _a_star_vizinhanca_8(l, inicio, fim, contexto, controle);
+    case VIZINHANCA_8_SEM_QUINAS:
+        return _a_star_vizinhanca_8_sem_quinas(l, inicio, fim, contexto, controle);
+    }
+
+    exit(printf("Erro: vizinhanca %d desconhecida.\n", vizinhanca));
+}
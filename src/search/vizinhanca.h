@@ -0,0 +1,47 @@
+#ifndef _VIZINHANCA_H_
+#define _VIZINHANCA_H_
+
+#include "labirinto.h"
+#include "algorithms.h"
+
+// regra de movimento da busca
+typedef enum
+{
+    // so' os 4 movimentos cardeais, de custo 1
+    VIZINHANCA_4 = 0,
+
+    // cardeais e diagonais (custo M_SQRT2); a diagonal so' exige o destino
+    // livre, como nas outras buscas do modulo
+    VIZINHANCA_8,
+
+    // diagonais tambem exigem livres as duas celulas cardeais ao lado, ou
+    // seja, o caminho nao corta a quina de um obstaculo
+    VIZINHANCA_8_SEM_QUINAS
+} Vizinhanca;
+
+// memoria de trabalho do A* de vizinhanca (custos, pais, heap), reutilizada
+// entre buscas: so' cresce quando o labirinto e' maior que os anteriores, e
+// uma busca nao reinicia os vetores, so' avanca uma marca de geracao. Nao
+// pode ser usada por duas buscas ao mesmo tempo (um contexto por thread).
+typedef struct ContextoVizinhanca ContextoVizinhanca;
+
+ContextoVizinhanca *contexto_vizinhanca_criar();
+void contexto_vizinhanca_destruir(ContextoVizinhanca *contexto);
+
+/**
+ * @brief A* com a regra de movimento escolhida. Cada regra tem o seu proprio
+ * motor, gerado em tempo de compilacao a partir de vizinhanca_motor.h: o laco
+ * de vizinhos e' desenrolado e nao ha testes da regra por vizinho, so' a
+ * escolha do motor na chamada. A heuristica e' a distancia de Manhattan em
+ * VIZINHANCA_4 e a octil nas outras (exatas em um mapa sem obstaculos).
+ * @param controle
+ * Opcional (pode ser NULL), como em a_star_controlado.
+ * Nao marca celulas no labirinto.
+ */
+ResultData a_star_vizinhanca(Labirinto *l, Celula inicio, Celula fim, Vizinhanca vizinhanca, ControleBusca *controle);
+
+// como a_star_vizinhanca, usando a memoria de contexto em vez de alocar e
+// preencher vetores do tamanho do labirinto a cada consulta
+ResultData a_star_vizinhanca_contexto(Labirinto *l, Celula inicio, Celula fim, Vizinhanca vizinhanca, ContextoVizinhanca *contexto, ControleBusca *controle);
+
+#endif
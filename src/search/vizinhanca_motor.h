@@ -0,0 +1,156 @@
+// Modelo do motor de A* de vizinhanca.c e terreno.c, incluido uma vez por
+// motor (o modelo nao tem guarda de inclusao, de proposito; so' as macros
+// auxiliares abaixo tem). Antes de incluir, defina:
+//   MOTOR_NOME        nome da funcao gerada
+//   MOTOR_ARGUMENTOS  parametros extras da funcao, a partir de uma virgula
+//                     (vazia quando nao ha)
+//   MOTOR_VIZINHOS    a lista de vizinhos, com _MOTOR_CARDINAL(dx, dy) e
+//                     _MOTOR_DIAGONAL(dx, dy), desenrolada no laco
+//   MOTOR_QUINA(dx, dy)
+//                     condicao extra de um passo diagonal, a partir de
+//                     && (vazia quando a diagonal pode cortar quinas)
+//   MOTOR_CUSTO(dx, dy, comprimento)
+//                     custo do passo de (x, y) para o vizinho (dx, dy), de
+//                     comprimento 1 ou M_SQRT2
+//   MOTOR_HEURISTICA(x, y)
+//                     estimativa de (x, y) ate fim
+// As macros sao desfeitas no final do arquivo.
+//
+// Os vetores sao indexados pela grade com a borda OCUPADO do labirinto
+// ((linha + 1) * largura + coluna + 1), entao o vizinho (dx, dy) de u e'
+// u + dy * largura + dx, sem testes de limites. Eles vem de um
+// ContextoVizinhanca e nao sao reiniciados a cada busca: g e pai so' valem
+// nas celulas cuja marca e' a geracao da busca (aberta) ou a seguinte
+// (fechada).
+
+#ifndef _VIZINHANCA_MOTOR_AUXILIARES_
+#define _VIZINHANCA_MOTOR_AUXILIARES_
+
+struct ContextoVizinhanca
+{
+    // vetores para ate' capacidade celulas (com a borda)
+    size_t capacidade;
+    double *g;
+    int *pai;
+    unsigned *marca;
+    IndexHeap *abertos;
+
+    // par (geracao, geracao + 1) da busca atual; marcas menores sao de
+    // buscas anteriores
+    unsigned geracao;
+};
+
+// prepara o contexto para uma busca em n celulas: cresce os vetores se
+// preciso, avanca a geracao e esvazia o heap
+void _contexto_vizinhanca_preparar(ContextoVizinhanca *contexto, size_t n);
+
+// passo de u para o vizinho (dx, dy), usando as variaveis locais do motor.
+// Empates de f vao para o maior g, que esta mais perto do fim.
+#define _MOTOR_RELAXAR(dx, dy, custo_passo) \
+    { \
+        int v = u + (dy) * largura + (dx); \
+        double custo = g[u] + (custo_passo); \
+        if (marca[v] != fechado && (marca[v] != aberto || custo < g[v])) \
+        { \
+            marca[v] = aberto; \
+            g[v] = custo; \
+            pai[v] = u; \
+            index_heap_push_tiebreak(abertos, v, custo + MOTOR_HEURISTICA(x + (dx), y + (dy)), -custo); \
+        } \
+    }
+
+#define _MOTOR_CARDINAL(dx, dy) \
+    if (!_labirinto_bloqueado(l, y + (dy), x + (dx))) \
+        _MOTOR_RELAXAR(dx, dy, MOTOR_CUSTO(dx, dy, 1.0))
+
+#define _MOTOR_DIAGONAL(dx, dy) \
+    if (!_labirinto_bloqueado(l, y + (dy), x + (dx)) MOTOR_QUINA(dx, dy)) \
+        _MOTOR_RELAXAR(dx, dy, MOTOR_CUSTO(dx, dy, M_SQRT2))
+
+#define _MOTOR_CARDINAIS \
+    _MOTOR_CARDINAL(0, -1) \
+    _MOTOR_CARDINAL(1, 0) \
+    _MOTOR_CARDINAL(0, 1) \
+    _MOTOR_CARDINAL(-1, 0)
+
+#define _MOTOR_DIAGONAIS \
+    _MOTOR_DIAGONAL(1, -1) \
+    _MOTOR_DIAGONAL(1, 1) \
+    _MOTOR_DIAGONAL(-1, 1) \
+    _MOTOR_DIAGONAL(-1, -1)
+
+#define _MOTOR_MANHATTAN(cx, cy) (abs((cx) - fim.x) + abs((cy) - fim.y))
+
+// com dx e dy as distancias nos eixos: max - min passos retos e min diagonais
+#define _MOTOR_OCTIL(cx, cy) (abs((cx) - fim.x) + abs((cy) - fim.y) + (M_SQRT2 - 2) * (abs((cx) - fim.x) < abs((cy) - fim.y) ? abs((cx) - fim.x) : abs((cy) - fim.y)))
+
+#endif
+
+ResultData MOTOR_NOME(Labirinto *l, Celula inicio, Celula fim MOTOR_ARGUMENTOS, ContextoVizinhanca *contexto, ControleBusca *controle)
+{
+    ResultData result = _default_result();
+
+    int largura = l->n_colunas + 2;
+    size_t n = (size_t)(l->n_linhas + 2) * largura;
+    int origem = (inicio.y + 1) * largura + inicio.x + 1;
+    int alvo = (fim.y + 1) * largura + fim.x + 1;
+
+    _contexto_vizinhanca_preparar(contexto, n);
+
+    double *g = contexto->g;
+    int *pai = contexto->pai;
+    unsigned *marca = contexto->marca;
+    unsigned aberto = contexto->geracao, fechado = aberto + 1;
+    IndexHeap *abertos = contexto->abertos;
+
+    marca[origem] = aberto;
+    g[origem] = 0;
+    pai[origem] = -1;
+    index_heap_push(abertos, origem, MOTOR_HEURISTICA(inicio.x, inicio.y));
+
+    while (!index_heap_empty(abertos))
+    {
+        if (result.nos_expandidos % BUSCA_INTERVALO_CONTROLE == 0 && (result.status = controle_verificar(controle)) != BUSCA_CONCLUIDA)
+            break;
+
+        int u = index_heap_pop(abertos);
+        marca[u] = fechado;
+        result.nos_expandidos++;
+
+        if (u == alvo)
+        {
+            result.sucesso = 1;
+            break;
+        }
+
+        int y = u / largura - 1, x = u % largura - 1;
+
+        MOTOR_VIZINHOS
+    }
+
+    if (result.sucesso)
+    {
+        for (int v = alvo; v >= 0; v = pai[v])
+            result.tamanho_caminho++;
+
+        result.caminho = (Celula *)calloc(result.tamanho_caminho, sizeof(Celula));
+
+        int i = result.tamanho_caminho - 1;
+        for (int v = alvo; v >= 0; v = pai[v], i--)
+        {
+            result.caminho[i].x = v % largura - 1;
+            result.caminho[i].y = v / largura - 1;
+        }
+
+        result.custo_caminho = g[alvo];
+    }
+
+    return result;
+}
+
+#undef MOTOR_NOME
+#undef MOTOR_ARGUMENTOS
+#undef MOTOR_VIZINHOS
+#undef MOTOR_QUINA
+#undef MOTOR_CUSTO
+#undef MOTOR_HEURISTICA
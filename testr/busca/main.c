@@ -0,0 +1,1032 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "labirinto.h"
+#include "algorithms.h"
+#include "dijkstra.h"
+#include "vizinhanca.h"
+#include "terreno.h"
+#include "bidirecional.h"
+#include "ara.h"
+#include "landmarks.h"
+#include "subobjetivos.h"
+#include "hpa.h"
+#include "cpd.h"
+#include "campo.h"
+#include "tabela_distancias.h"
+#include "multialvo.h"
+#include "planejador.h"
+#include "delta.h"
+#include "memoria.h"
+#include "bfs_bits.h"
+#include "onda.h"
+#include "bfs_paralela.h"
+#include "corrida.h"
+#include "qualquer_angulo.h"
+#include "cache.h"
+
+// Compara as buscas com dijkstra_regiao sobre o labirinto inteiro em
+// labirintos aleatorios. Uso: ./main [n_labirintos] [semente]. Imprime as
+// diferencas e termina com 1 se houver alguma.
+
+#define CONSULTAS 30
+#define TOLERANCIA 1e-6
+
+int falhas = 0;
+
+void falha(int semente, char *busca, Celula inicio, Celula fim, double esperado, double obtido)
+{
+    if (falhas++ < 20)
+        printf("semente %d %s (%d,%d)->(%d,%d): esperado %g, obtido %g\n", semente, busca, inicio.y, inicio.x, fim.y, fim.x, esperado, obtido);
+}
+
+// o caminho vai de inicio a fim por celulas livres, em passos de 8 vizinhos,
+// e o custo informado e' a soma dos passos
+int caminho_valido(Labirinto *l, ResultData *r, Celula inicio, Celula fim)
+{
+    double custo = 0;
+
+    if (r->tamanho_caminho < 1)
+        return 0;
+
+    Celula *c = r->caminho;
+    Celula *u = &c[r->tamanho_caminho - 1];
+
+    if (c[0].x != inicio.x || c[0].y != inicio.y || u->x != fim.x || u->y != fim.y)
+        return 0;
+
+    for (int i = 0; i < r->tamanho_caminho; i++)
+    {
+        if (labirinto_bloqueado(l, c[i].y, c[i].x))
+            return 0;
+
+        if (i > 0)
+        {
+            int dx = abs(c[i].x - c[i - 1].x), dy = abs(c[i].y - c[i - 1].y);
+
+            if (dx > 1 || dy > 1 || dx + dy == 0)
+                return 0;
+
+            custo += dx && dy ? M_SQRT2 : 1.0;
+        }
+    }
+
+    return fabs(custo - r->custo_caminho) < TOLERANCIA;
+}
+
+// resultado de uma busca otima: mesmo custo e caminho valido, ou falha
+// quando nao ha caminho
+void conferir(int semente, char *busca, Labirinto *l, ResultData r, Celula inicio, Celula fim, double otimo)
+{
+    if (otimo == INFINITY)
+    {
+        if (r.sucesso)
+            falha(semente, busca, inicio, fim, otimo, r.custo_caminho);
+    }
+    else if (!r.sucesso)
+        falha(semente, busca, inicio, fim, otimo, INFINITY);
+    else if (fabs(r.custo_caminho - otimo) > TOLERANCIA || !caminho_valido(l, &r, inicio, fim))
+        falha(semente, busca, inicio, fim, otimo, r.custo_caminho);
+
+    free(r.caminho);
+}
+
+Labirinto *labirinto_aleatorio(int *n_linhas, int *n_colunas)
+{
+    *n_linhas = 2 + rand() % 40;
+    *n_colunas = 2 + rand() % 40;
+    int densidade = rand() % 45;
+
+    Labirinto *l = labirinto_criar(*n_linhas, *n_colunas);
+
+    for (int i = 0; i < *n_linhas; i++)
+        for (int j = 0; j < *n_colunas; j++)
+            if (rand() % 100 < densidade)
+                labirinto_atribuir(l, i, j, OCUPADO);
+
+    return l;
+}
+
+Celula celula_aleatoria(Labirinto *l, int n_linhas, int n_colunas)
+{
+    Celula c = {0};
+
+    // algumas consultas partem de celulas bloqueadas de proposito
+    do
+    {
+        c.x = rand() % n_colunas;
+        c.y = rand() % n_linhas;
+    } while (labirinto_bloqueado(l, c.y, c.x) && rand() % 8);
+
+    return c;
+}
+
+void testar_labirinto(int semente)
+{
+    int n_linhas, n_colunas;
+
+    srand(semente);
+    Labirinto *l = labirinto_aleatorio(&n_linhas, &n_colunas);
+    int tamanho_cluster = 2 + rand() % 8;
+
+    double *dist = (double *)malloc((size_t)n_linhas * n_colunas * sizeof(double));
+    TabelaTerreno terreno = terreno_tabela_padrao();
+    ConfigARA ara = ara_config_padrao(0);
+    Landmarks *landmarks = landmarks_construir(l, 4);
+    GrafoSubobjetivos *subobjetivos = subobjetivos_construir(l);
+    Hierarquia *hpa = hpa_construir(l, tamanho_cluster);
+    BaseCaminhos *cpd = base_caminhos_construir(l);
+
+    for (int q = 0; q < CONSULTAS; q++)
+    {
+        Celula inicio = celula_aleatoria(l, n_linhas, n_colunas);
+        Celula fim = celula_aleatoria(l, n_linhas, n_colunas);
+        double otimo = INFINITY;
+
+        if (!labirinto_bloqueado(l, inicio.y, inicio.x) && !labirinto_bloqueado(l, fim.y, fim.x))
+        {
+            dijkstra_regiao(l, regiao_labirinto(l), inicio.y, inicio.x, dist, NULL, NULL, 0);
+            otimo = dist[fim.y * n_colunas + fim.x];
+        }
+
+        conferir(semente, "a_star_vizinhanca", l, a_star_vizinhanca(l, inicio, fim, VIZINHANCA_8, NULL), inicio, fim, otimo);
+        conferir(semente, "a_star_terreno", l, a_star_terreno(l, inicio, fim, &terreno, NULL), inicio, fim, otimo);
+        conferir(semente, "busca_bidirecional", l, busca_bidirecional(l, inicio, fim, NULL), inicio, fim, otimo);
+        conferir(semente, "ara_star", l, ara_star(l, inicio, fim, ara, NULL), inicio, fim, otimo);
+
+        // a_star_alt marca as celulas visitadas, como as buscas de algorithms.c
+        conferir(semente, "a_star_alt", l, a_star_alt(l, inicio, fim, landmarks, NULL), inicio, fim, otimo);
+        labirinto_limpar(l);
+
+        conferir(semente, "subobjetivos_buscar", l, subobjetivos_buscar(subobjetivos, inicio, fim, NULL), inicio, fim, otimo);
+        conferir(semente, "base_caminhos_caminho", l, base_caminhos_caminho(cpd, inicio, fim, NULL), inicio, fim, otimo);
+        conferir(semente, "a_star_multialvo", l, a_star_multialvo(l, inicio, &fim, 1, NULL, NULL, NULL), inicio, fim, otimo);
+
+        if (!labirinto_bloqueado(l, fim.y, fim.x))
+        {
+            CampoDistancias *campo = campo_distancias(l, fim, NULL);
+            double custo = labirinto_bloqueado(l, inicio.y, inicio.x) ? INFINITY : campo_distancias_custo(campo, inicio);
+
+            if (fabs(custo - otimo) > TOLERANCIA && custo != otimo)
+                falha(semente, "campo_distancias_custo", inicio, fim, otimo, custo);
+
+            campo_distancias_destruir(campo);
+        }
+
+        if (!labirinto_bloqueado(l, inicio.y, inicio.x) && !labirinto_bloqueado(l, fim.y, fim.x))
+        {
+            TabelaDistancias *tabela = distance_table(l, &inicio, 1, &fim, 1);
+            double custo = tabela_distancias_custo(tabela, 0, 0);
+
+            if (fabs(custo - otimo) > TOLERANCIA && custo != otimo)
+                falha(semente, "tabela_distancias_custo", inicio, fim, otimo, custo);
+
+            tabela_distancias_destruir(tabela);
+        }
+
+        // HPA* nao e' otimo: so' nunca e' mais curto que o otimo e, com os
+        // clusters iguais ou vizinhos, nao e' mais longo que o melhor
+        // caminho dentro deles
+        ResultData r = hpa_buscar(hpa, inicio, fim, NULL);
+
+        if ((otimo < INFINITY) != (r.sucesso == 1) || (r.sucesso && (r.custo_caminho < otimo - TOLERANCIA || !caminho_valido(l, &r, inicio, fim))))
+            falha(semente, "hpa_buscar", inicio, fim, otimo, r.sucesso ? r.custo_caminho : INFINITY);
+        else if (r.sucesso && abs(inicio.y / tamanho_cluster - fim.y / tamanho_cluster) <= 1 && abs(inicio.x / tamanho_cluster - fim.x / tamanho_cluster) <= 1)
+        {
+            Regiao regiao;
+            regiao.linha_min = (inicio.y < fim.y ? inicio.y : fim.y) / tamanho_cluster * tamanho_cluster;
+            regiao.coluna_min = (inicio.x < fim.x ? inicio.x : fim.x) / tamanho_cluster * tamanho_cluster;
+            int linha_max = ((inicio.y > fim.y ? inicio.y : fim.y) / tamanho_cluster + 1) * tamanho_cluster;
+            int coluna_max = ((inicio.x > fim.x ? inicio.x : fim.x) / tamanho_cluster + 1) * tamanho_cluster;
+            regiao.n_linhas = (linha_max < n_linhas ? linha_max : n_linhas) - regiao.linha_min;
+            regiao.n_colunas = (coluna_max < n_colunas ? coluna_max : n_colunas) - regiao.coluna_min;
+
+            dijkstra_regiao(l, regiao, inicio.y, inicio.x, dist, NULL, NULL, 0);
+            double limite = dist[regiao_indice(&regiao, fim.y, fim.x)];
+
+            if (r.custo_caminho > limite + TOLERANCIA)
+                falha(semente, "hpa_buscar (clusters vizinhos)", inicio, fim, limite, r.custo_caminho);
+        }
+
+        free(r.caminho);
+    }
+
+    landmarks_destruir(landmarks);
+    subobjetivos_destruir(subobjetivos);
+    hpa_destruir(hpa);
+    base_caminhos_destruir(cpd);
+    free(dist);
+    labirinto_destruir(l);
+}
+
+// D* Lite: o agente anda pelo caminho do planejador enquanto celulas
+// aleatorias trocam entre LIVRE e OCUPADO, e cada reparo deve ter o custo
+// de uma busca do zero
+void testar_planejador(int semente)
+{
+    srand(semente);
+    int n_linhas = 5 + rand() % 40, n_colunas = 5 + rand() % 40;
+    int densidade = rand() % 35;
+
+    Labirinto *l = labirinto_criar(n_linhas, n_colunas);
+
+    for (int i = 0; i < n_linhas; i++)
+        for (int j = 0; j < n_colunas; j++)
+            if (rand() % 100 < densidade)
+                labirinto_atribuir(l, i, j, OCUPADO);
+
+    Celula inicio = {0}, fim = {0};
+    inicio.x = rand() % n_colunas;
+    inicio.y = rand() % n_linhas;
+    fim.x = rand() % n_colunas;
+    fim.y = rand() % n_linhas;
+    labirinto_atribuir(l, inicio.y, inicio.x, LIVRE);
+    labirinto_atribuir(l, fim.y, fim.x, LIVRE);
+
+    Planejador *p = planejador_criar(l, inicio, fim);
+    double *dist = (double *)malloc((size_t)n_linhas * n_colunas * sizeof(double));
+
+    for (int passo = 0; passo < 80 && (inicio.x != fim.x || inicio.y != fim.y); passo++)
+    {
+        dijkstra_regiao(l, regiao_labirinto(l), inicio.y, inicio.x, dist, NULL, NULL, 0);
+        double otimo = dist[fim.y * n_colunas + fim.x];
+
+        ResultData r = planejador_caminho(p, NULL);
+        Celula proximo = r.sucesso && r.tamanho_caminho > 1 ? r.caminho[1] : inicio;
+        int erro = (otimo < INFINITY) != (r.sucesso == 1) || (r.sucesso && (fabs(r.custo_caminho - otimo) > TOLERANCIA || !caminho_valido(l, &r, inicio, fim)));
+
+        if (erro)
+            falha(semente, "planejador_caminho", inicio, fim, otimo, r.sucesso ? r.custo_caminho : INFINITY);
+
+        free(r.caminho);
+
+        if (erro)
+            break;
+
+        inicio.x = proximo.x;
+        inicio.y = proximo.y;
+        planejador_mover(p, inicio);
+
+        for (int n_trocas = 1 + rand() % 6; n_trocas > 0; n_trocas--)
+        {
+            int y = rand() % n_linhas, x = rand() % n_colunas;
+
+            if ((y == inicio.y && x == inicio.x) || (y == fim.y && x == fim.x))
+                continue;
+
+            labirinto_atribuir(l, y, x, labirinto_bloqueado(l, y, x) ? LIVRE : OCUPADO);
+            planejador_notificar(p, y, x);
+        }
+    }
+
+    planejador_destruir(p);
+    free(dist);
+    labirinto_destruir(l);
+}
+
+// Delta-stepping com varias larguras de balde e numeros de threads: as
+// distancias do mapa inteiro devem ser as do Dijkstra sequencial
+void testar_delta(int semente)
+{
+    int n_linhas, n_colunas;
+    double larguras[] = {0, 0.5, 1.5, 4};
+
+    srand(semente);
+    Labirinto *l = labirinto_aleatorio(&n_linhas, &n_colunas);
+    Celula origem = celula_aleatoria(l, n_linhas, n_colunas);
+    size_t n = (size_t)n_linhas * n_colunas;
+
+    double *esperado = (double *)malloc(n * sizeof(double));
+    double *dist = (double *)malloc(n * sizeof(double));
+
+    dijkstra_regiao(l, regiao_labirinto(l), origem.y, origem.x, esperado, NULL, NULL, 0);
+
+    for (int i = 0; i < (int)(sizeof(larguras) / sizeof(double)); i++)
+    {
+        int n_threads = 1 + rand() % 4;
+        delta_stepping(l, origem, dist, larguras[i], n_threads);
+
+        for (size_t c = 0; c < n; c++)
+        {
+            if (dist[c] != esperado[c] && !(fabs(dist[c] - esperado[c]) <= TOLERANCIA))
+            {
+                Celula alvo = {0};
+                alvo.x = c % n_colunas;
+                alvo.y = c / n_colunas;
+                falha(semente, "delta_stepping", origem, alvo, esperado[c], dist[c]);
+                break;
+            }
+        }
+    }
+
+    free(esperado);
+    free(dist);
+    labirinto_destruir(l);
+}
+
+// IDA* e SMA* com memoria para o mapa inteiro e sem limite de expansoes
+// devem achar o caminho otimo
+void testar_memoria(int semente)
+{
+    int n_linhas, n_colunas;
+
+    srand(semente);
+    Labirinto *l = labirinto_aleatorio(&n_linhas, &n_colunas);
+    double *dist = (double *)malloc((size_t)n_linhas * n_colunas * sizeof(double));
+
+    for (int q = 0; q < CONSULTAS / 3; q++)
+    {
+        Celula inicio = celula_aleatoria(l, n_linhas, n_colunas);
+        Celula fim = celula_aleatoria(l, n_linhas, n_colunas);
+        double otimo = INFINITY;
+
+        if (!labirinto_bloqueado(l, inicio.y, inicio.x) && !labirinto_bloqueado(l, fim.y, fim.x))
+        {
+            dijkstra_regiao(l, regiao_labirinto(l), inicio.y, inicio.x, dist, NULL, NULL, 0);
+            otimo = dist[fim.y * n_colunas + fim.x];
+        }
+
+        conferir(semente, "ida_star", l, ida_star(l, inicio, fim, MEMORIA_NOS_PADRAO, 0, NULL), inicio, fim, otimo);
+        conferir(semente, "sma_star", l, sma_star(l, inicio, fim, MEMORIA_NOS_PADRAO, 0, NULL), inicio, fim, otimo);
+    }
+
+    free(dist);
+    labirinto_destruir(l);
+}
+
+// BFS de mapa de bits: saltos ate o fim e, sem fim, a componente inteira do
+// inicio, comparados com a frente de onda (campo de saltos completo)
+void testar_bfs_bits(int semente)
+{
+    int n_linhas, n_colunas;
+
+    srand(semente);
+    Labirinto *l = labirinto_aleatorio(&n_linhas, &n_colunas);
+    int *saltos = (int *)malloc((size_t)n_linhas * n_colunas * sizeof(int));
+
+    for (int q = 0; q < CONSULTAS / 3; q++)
+    {
+        Celula inicio = celula_aleatoria(l, n_linhas, n_colunas);
+        Celula fim = celula_aleatoria(l, n_linhas, n_colunas);
+        long alcancadas = onda_saltos(l, inicio, saltos);
+
+        int esperado = labirinto_bloqueado(l, fim.y, fim.x) ? -1 : saltos[fim.y * n_colunas + fim.x];
+        Alcance a = bfs_bits(l, inicio, fim);
+
+        if (a.saltos != esperado || a.alcancavel != (esperado >= 0))
+            falha(semente, "bfs_bits", inicio, fim, esperado, a.saltos);
+
+        // fim fora do mapa: percorre a componente e devolve o maior nivel
+        int maior = -1;
+        for (size_t c = 0; c < (size_t)n_linhas * n_colunas; c++)
+            if (saltos[c] > maior)
+                maior = saltos[c];
+
+        Celula fora = {0};
+        fora.x = -1;
+        fora.y = -1;
+        a = bfs_bits(l, inicio, fora);
+
+        if (a.visitadas != alcancadas || (alcancadas > 0 && a.saltos != maior))
+            falha(semente, "bfs_bits (componente)", inicio, fora, alcancadas, a.visitadas);
+    }
+
+    free(saltos);
+    labirinto_destruir(l);
+}
+
+// kernels SIMD da frente de onda contra o escalar: o mesmo campo de saltos
+// e os mesmos rotulos de componentes. Kernels que a CPU nao suporta sao
+// pulados. O campo_saltos tambem deve ter os custos da onda.
+void testar_onda(int semente)
+{
+    int n_linhas, n_colunas;
+
+    srand(semente);
+    Labirinto *l = labirinto_aleatorio(&n_linhas, &n_colunas);
+    Celula inicio = celula_aleatoria(l, n_linhas, n_colunas);
+    size_t n = (size_t)n_linhas * n_colunas;
+
+    int *saltos_escalar = (int *)malloc(n * sizeof(int));
+    int *rotulos_escalar = (int *)malloc(n * sizeof(int));
+    int *saltos = (int *)malloc(n * sizeof(int));
+    int *rotulos = (int *)malloc(n * sizeof(int));
+
+    KernelOnda original = onda_kernel();
+    KernelOnda kernels[] = {ONDA_SSE2, ONDA_AVX2};
+    char *nomes[] = {"onda SSE2", "onda AVX2"};
+
+    onda_definir_kernel(ONDA_ESCALAR);
+    long alcancadas_escalar = onda_saltos(l, inicio, saltos_escalar);
+    int componentes_escalar = onda_componentes(l, rotulos_escalar);
+
+    for (int k = 0; k < 2; k++)
+    {
+        if (!onda_definir_kernel(kernels[k]))
+            continue;
+
+        long alcancadas = onda_saltos(l, inicio, saltos);
+        int componentes = onda_componentes(l, rotulos);
+
+        if (alcancadas != alcancadas_escalar || componentes != componentes_escalar)
+            falha(semente, nomes[k], inicio, inicio, alcancadas_escalar, alcancadas);
+
+        for (size_t c = 0; c < n; c++)
+        {
+            if (saltos[c] != saltos_escalar[c] || rotulos[c] != rotulos_escalar[c])
+            {
+                Celula alvo = {0};
+                alvo.x = c % n_colunas;
+                alvo.y = c / n_colunas;
+                falha(semente, nomes[k], inicio, alvo, saltos_escalar[c], saltos[c]);
+                break;
+            }
+        }
+    }
+
+    onda_definir_kernel(original);
+
+    CampoDistancias *campo = campo_saltos(l, inicio);
+
+    for (size_t c = 0; c < n; c++)
+    {
+        Celula origem = {0};
+        origem.x = c % n_colunas;
+        origem.y = c / n_colunas;
+        double custo = campo_distancias_custo(campo, origem);
+
+        if (saltos_escalar[c] < 0 ? !isinf(custo) : custo != saltos_escalar[c])
+        {
+            falha(semente, "campo_saltos", origem, inicio, saltos_escalar[c], custo);
+            break;
+        }
+    }
+
+    campo_distancias_destruir(campo);
+    free(saltos_escalar);
+    free(rotulos_escalar);
+    free(saltos);
+    free(rotulos);
+    labirinto_destruir(l);
+}
+
+// BFS paralela com 1 a 4 threads: caminho valido com o menor numero de
+// movimentos (o da frente de onda), ou nenhum quando o fim nao e' alcancavel
+void testar_bfs_paralela(int semente)
+{
+    int n_linhas, n_colunas;
+
+    srand(semente);
+    Labirinto *l = labirinto_aleatorio(&n_linhas, &n_colunas);
+    int *saltos = (int *)malloc((size_t)n_linhas * n_colunas * sizeof(int));
+
+    for (int q = 0; q < CONSULTAS / 3; q++)
+    {
+        Celula inicio = celula_aleatoria(l, n_linhas, n_colunas);
+        Celula fim = celula_aleatoria(l, n_linhas, n_colunas);
+        onda_saltos(l, inicio, saltos);
+
+        int esperado = labirinto_bloqueado(l, fim.y, fim.x) ? -1 : saltos[fim.y * n_colunas + fim.x];
+        ResultData r = bfs_paralela(l, inicio, fim, 1 + rand() % 4, NULL);
+
+        if ((esperado >= 0) != (r.sucesso == 1) || (r.sucesso && (r.tamanho_caminho != esperado + 1 || !caminho_valido(l, &r, inicio, fim))))
+            falha(semente, "bfs_paralela", inicio, fim, esperado, r.sucesso ? r.tamanho_caminho - 1 : -1);
+
+        free(r.caminho);
+    }
+
+    free(saltos);
+    labirinto_destruir(l);
+}
+
+// corrida com e sem o ALT: a resposta do vencedor e' otima, o vencedor e'
+// um dos motores inscritos e nenhum motor deixa marcas no labirinto
+void testar_corrida(int semente)
+{
+    int n_linhas, n_colunas;
+
+    srand(semente);
+    Labirinto *l = labirinto_aleatorio(&n_linhas, &n_colunas);
+    Landmarks *landmarks = landmarks_construir(l, 4);
+    double *dist = (double *)malloc((size_t)n_linhas * n_colunas * sizeof(double));
+
+    for (int q = 0; q < CONSULTAS / 3; q++)
+    {
+        Celula inicio = celula_aleatoria(l, n_linhas, n_colunas);
+        Celula fim = celula_aleatoria(l, n_linhas, n_colunas);
+        double otimo = INFINITY;
+
+        if (!labirinto_bloqueado(l, inicio.y, inicio.x) && !labirinto_bloqueado(l, fim.y, fim.x))
+        {
+            dijkstra_regiao(l, regiao_labirinto(l), inicio.y, inicio.x, dist, NULL, NULL, 0);
+            otimo = dist[fim.y * n_colunas + fim.x];
+        }
+
+        Landmarks *inscritos = q % 2 ? landmarks : NULL;
+        MotorCorrida vencedor = CORRIDA_N_MOTORES;
+        conferir(semente, "corrida", l, corrida(l, inicio, fim, inscritos, &vencedor), inicio, fim, otimo);
+
+        if (vencedor < 0 || vencedor >= (inscritos ? CORRIDA_N_MOTORES : CORRIDA_ALT))
+            falha(semente, "corrida (vencedor)", inicio, fim, 0, vencedor);
+
+        for (int y = 0; y < n_linhas; y++)
+            for (int x = 0; x < n_colunas; x++)
+                if (labirinto_obter(l, y, x) != LIVRE && labirinto_obter(l, y, x) != OCUPADO)
+                {
+                    falha(semente, "corrida (marcas)", inicio, fim, LIVRE, labirinto_obter(l, y, x));
+                    labirinto_limpar(l);
+                }
+    }
+
+    landmarks_destruir(landmarks);
+    free(dist);
+    labirinto_destruir(l);
+}
+
+// linha de visao por forca bruta: o segmento entre os centros de a e b
+// atravessa o interior do quadrado de lado 1 em torno de alguma celula
+// OCUPADO. Em um eixo sem deslocamento a coordenada e' inteira e so' esta
+// dentro do quadrado da propria coluna (ou linha); nos outros, o trecho do
+// segmento dentro do quadrado fechado deve ter comprimento positivo.
+int linha_de_visao_forca_bruta(Labirinto *l, Celula a, Celula b, int n_linhas, int n_colunas)
+{
+    for (int y = 0; y < n_linhas; y++)
+        for (int x = 0; x < n_colunas; x++)
+        {
+            if (!labirinto_bloqueado(l, y, x))
+                continue;
+
+            double t0 = 0, t1 = 1;
+            double origem[2] = {a.x, a.y}, passo[2] = {b.x - a.x, b.y - a.y}, centro[2] = {x, y};
+            int cruza = 1;
+
+            for (int e = 0; e < 2 && cruza; e++)
+            {
+                if (passo[e] == 0)
+                    cruza = origem[e] == centro[e];
+                else
+                {
+                    double ta = (centro[e] - 0.5 - origem[e]) / passo[e];
+                    double tb = (centro[e] + 0.5 - origem[e]) / passo[e];
+                    t0 = fmax(t0, fmin(ta, tb));
+                    t1 = fmin(t1, fmax(ta, tb));
+                }
+            }
+
+            if (cruza && t1 - t0 > 1e-9)
+                return 0;
+        }
+
+    return 1;
+}
+
+// Theta*: linha_de_visao igual a forca bruta; caminho com linha de visao
+// entre pontos consecutivos, custo euclidiano entre a distancia em linha
+// reta e o otimo da grade. A suavizacao nao piora um caminho da grade.
+void testar_qualquer_angulo(int semente)
+{
+    int n_linhas, n_colunas;
+
+    srand(semente);
+    Labirinto *l = labirinto_aleatorio(&n_linhas, &n_colunas);
+    double *dist = (double *)malloc((size_t)n_linhas * n_colunas * sizeof(double));
+
+    for (int q = 0; q < CONSULTAS / 3; q++)
+    {
+        Celula inicio = celula_aleatoria(l, n_linhas, n_colunas);
+        Celula fim = celula_aleatoria(l, n_linhas, n_colunas);
+
+        if (labirinto_bloqueado(l, inicio.y, inicio.x) || labirinto_bloqueado(l, fim.y, fim.x))
+            continue;
+
+        if (linha_de_visao(l, inicio, fim) != linha_de_visao_forca_bruta(l, inicio, fim, n_linhas, n_colunas))
+            falha(semente, "linha_de_visao", inicio, fim, !linha_de_visao(l, inicio, fim), linha_de_visao(l, inicio, fim));
+
+        dijkstra_regiao(l, regiao_labirinto(l), inicio.y, inicio.x, dist, NULL, NULL, 0);
+        double otimo = dist[fim.y * n_colunas + fim.x];
+        double reta = hypot(fim.x - inicio.x, fim.y - inicio.y);
+
+        ResultData r = theta_star(l, inicio, fim, NULL);
+        labirinto_limpar(l);
+
+        ResultData grade = a_star_vizinhanca(l, inicio, fim, VIZINHANCA_8, NULL);
+        double custo_grade = grade.custo_caminho;
+        caminho_suavizar(l, &grade);
+
+        ResultData *caminhos[] = {&r, &grade};
+        char *nomes[] = {"theta_star", "caminho_suavizar"};
+
+        for (int k = 0; k < 2; k++)
+        {
+            ResultData *c = caminhos[k];
+
+            if ((otimo < INFINITY) != (c->sucesso == 1))
+            {
+                falha(semente, nomes[k], inicio, fim, otimo, c->sucesso ? c->custo_caminho : INFINITY);
+                continue;
+            }
+
+            if (!c->sucesso)
+                continue;
+
+            double custo = 0;
+            int visivel = c->caminho[0].x == inicio.x && c->caminho[0].y == inicio.y &&
+                          c->caminho[c->tamanho_caminho - 1].x == fim.x && c->caminho[c->tamanho_caminho - 1].y == fim.y;
+
+            for (int i = 1; i < c->tamanho_caminho; i++)
+            {
+                visivel &= linha_de_visao_forca_bruta(l, c->caminho[i - 1], c->caminho[i], n_linhas, n_colunas);
+                custo += hypot(c->caminho[i].x - c->caminho[i - 1].x, c->caminho[i].y - c->caminho[i - 1].y);
+            }
+
+            double limite = k == 0 ? otimo : custo_grade;
+
+            if (!visivel || fabs(custo - c->custo_caminho) > TOLERANCIA || custo < reta - TOLERANCIA || custo > limite + TOLERANCIA)
+                falha(semente, nomes[k], inicio, fim, limite, c->custo_caminho);
+        }
+
+        free(r.caminho);
+        free(grade.caminho);
+    }
+
+    free(dist);
+    labirinto_destruir(l);
+}
+
+// custo de um resultado de a_star_terreno ou da cache, recalculado com os
+// custos de passo da tabela; INFINITY se o caminho nao liga inicio a fim
+double custo_terreno(Labirinto *l, ResultData *r, TabelaTerreno *terreno, Celula inicio, Celula fim)
+{
+    Celula *c = r->caminho;
+    double custo = 0;
+
+    if (r->tamanho_caminho < 1 || c[0].x != inicio.x || c[0].y != inicio.y ||
+        c[r->tamanho_caminho - 1].x != fim.x || c[r->tamanho_caminho - 1].y != fim.y)
+        return INFINITY;
+
+    for (int i = 1; i < r->tamanho_caminho; i++)
+    {
+        int dx = abs(c[i].x - c[i - 1].x), dy = abs(c[i].y - c[i - 1].y);
+
+        if (dx > 1 || dy > 1 || dx + dy == 0 || labirinto_bloqueado(l, c[i].y, c[i].x))
+            return INFINITY;
+
+        custo += terreno_custo_passo(terreno, labirinto_obter(l, c[i - 1].y, c[i - 1].x), labirinto_obter(l, c[i].y, c[i].x), dx && dy);
+    }
+
+    return custo;
+}
+
+// cache de resultados: acertos exatos devolvem o resultado guardado,
+// acertos de subcaminho sao otimos (com e sem terreno) e mudar uma celula
+// invalida as entradas do conteudo antigo ate' ela voltar ao valor original
+void testar_cache(int semente)
+{
+    int n_linhas, n_colunas;
+
+    srand(semente);
+    Labirinto *l = labirinto_aleatorio(&n_linhas, &n_colunas);
+    CacheResultados *cache = cache_resultados_criar(CONSULTAS);
+    double *dist = (double *)malloc((size_t)n_linhas * n_colunas * sizeof(double));
+
+    TabelaTerreno terreno = terreno_tabela_padrao();
+    terreno_definir(&terreno, TERRENO_MIN, 0.5);
+    terreno_definir(&terreno, TERRENO_MIN + 1, 3.0);
+
+    for (int i = 0; i < n_linhas; i++)
+        for (int j = 0; j < n_colunas; j++)
+            if (!labirinto_bloqueado(l, i, j) && rand() % 4 == 0)
+                labirinto_atribuir(l, i, j, TERRENO_MIN + rand() % 2);
+
+    for (int q = 0; q < CONSULTAS / 3; q++)
+    {
+        Celula inicio = celula_aleatoria(l, n_linhas, n_colunas);
+        Celula fim = celula_aleatoria(l, n_linhas, n_colunas);
+        ResultData r, guardado = a_star_vizinhanca(l, inicio, fim, VIZINHANCA_8, NULL);
+
+        cache_resultados_guardar(cache, l, inicio, fim, "a_star", &guardado, 1);
+
+        if (!cache_resultados_buscar(cache, l, inicio, fim, "a_star", &r) || r.sucesso != guardado.sucesso ||
+            r.nos_expandidos != guardado.nos_expandidos || (r.sucesso && !caminho_valido(l, &r, inicio, fim)) ||
+            fabs(r.custo_caminho - guardado.custo_caminho) > TOLERANCIA)
+            falha(semente, "cache (exato)", inicio, fim, guardado.custo_caminho, r.custo_caminho);
+        free(r.caminho);
+
+        if (guardado.sucesso)
+        {
+            // trecho entre duas celulas do caminho guardado, em qualquer ordem
+            Celula a = guardado.caminho[rand() % guardado.tamanho_caminho];
+            Celula b = guardado.caminho[rand() % guardado.tamanho_caminho];
+
+            long subcaminhos = cache_resultados_estatisticas(cache).acertos_subcaminho;
+
+            if (cache_resultados_buscar(cache, l, a, b, "a_star", &r))
+            {
+                dijkstra_regiao(l, regiao_labirinto(l), a.y, a.x, dist, NULL, NULL, 0);
+
+                if (cache_resultados_estatisticas(cache).acertos_subcaminho > subcaminhos && r.nos_expandidos != 0)
+                    falha(semente, "cache (subcaminho)", a, b, 0, r.nos_expandidos);
+                conferir(semente, "cache (subcaminho)", l, r, a, b, dist[b.y * n_colunas + b.x]);
+            }
+
+            // bloquear uma celula do caminho muda o hash; desbloquear o restaura
+            Celula meio = guardado.caminho[guardado.tamanho_caminho / 2];
+            unsigned char valor = labirinto_obter(l, meio.y, meio.x);
+
+            labirinto_atribuir(l, meio.y, meio.x, OCUPADO);
+            if (cache_resultados_buscar(cache, l, inicio, fim, "a_star", &r))
+            {
+                falha(semente, "cache (invalidacao)", inicio, fim, INFINITY, r.custo_caminho);
+                free(r.caminho);
+            }
+
+            labirinto_atribuir(l, meio.y, meio.x, valor);
+            if (!cache_resultados_buscar(cache, l, inicio, fim, "a_star", &r))
+                falha(semente, "cache (restaurado)", inicio, fim, guardado.custo_caminho, INFINITY);
+            free(r.caminho);
+        }
+        free(guardado.caminho);
+
+        // terreno: outra tabela de custos nao encontra as entradas desta
+        guardado = a_star_terreno(l, inicio, fim, &terreno, NULL);
+        cache_resultados_guardar_terreno(cache, l, inicio, fim, "a_star_terreno", &terreno, &guardado, 1);
+
+        TabelaTerreno outro = terreno;
+        terreno_definir(&outro, TERRENO_MIN + 1, 2.0);
+
+        if (cache_resultados_buscar_terreno(cache, l, inicio, fim, "a_star_terreno", &outro, &r))
+        {
+            falha(semente, "cache (tabela)", inicio, fim, INFINITY, r.custo_caminho);
+            free(r.caminho);
+        }
+
+        if (guardado.sucesso)
+        {
+            Celula a = guardado.caminho[rand() % guardado.tamanho_caminho];
+            Celula b = guardado.caminho[rand() % guardado.tamanho_caminho];
+
+            if (cache_resultados_buscar_terreno(cache, l, a, b, "a_star_terreno", &terreno, &r))
+            {
+                ResultData otimo = a_star_terreno(l, a, b, &terreno, NULL);
+                double custo = custo_terreno(l, &r, &terreno, a, b);
+
+                if (!r.sucesso || fabs(custo - r.custo_caminho) > TOLERANCIA || fabs(custo - otimo.custo_caminho) > TOLERANCIA)
+                    falha(semente, "cache (subcaminho de terreno)", a, b, otimo.custo_caminho, r.custo_caminho);
+
+                free(otimo.caminho);
+                free(r.caminho);
+            }
+        }
+        free(guardado.caminho);
+    }
+
+    cache_resultados_destruir(cache);
+    free(dist);
+    labirinto_destruir(l);
+}
+
+// conteudo e hash iguais celula a celula
+int labirintos_iguais(Labirinto *a, Labirinto *b)
+{
+    if (labirinto_n_linhas(a) != labirinto_n_linhas(b) || labirinto_n_colunas(a) != labirinto_n_colunas(b) ||
+        labirinto_hash(a) != labirinto_hash(b))
+        return 0;
+
+    for (int i = 0; i < labirinto_n_linhas(a); i++)
+        for (int j = 0; j < labirinto_n_colunas(a); j++)
+            if (labirinto_obter(a, i, j) != labirinto_obter(b, i, j) || labirinto_bloqueado(a, i, j) != labirinto_bloqueado(b, i, j))
+                return 0;
+
+    return 1;
+}
+
+// formatos em disco: o compactado, com blocos de linhas de tamanho
+// aleatorio, e o bruto carregam de volta o mesmo labirinto. As linhas
+// misturam ruido, obstaculos esparsos, faixas longas e terrenos, para que
+// cada bloco escolha uma codificacao diferente.
+void testar_arquivos(int semente)
+{
+    char arquivo[] = "/tmp/busca_XXXXXX";
+    int n_linhas, n_colunas;
+
+    srand(semente);
+    n_linhas = 1 + rand() % 80;
+    n_colunas = 1 + rand() % 80;
+
+    Labirinto *l = labirinto_criar(n_linhas, n_colunas);
+
+    for (int i = 0; i < n_linhas; i++)
+    {
+        int tipo = rand() % 4;
+
+        for (int j = 0; j < n_colunas; j++)
+        {
+            unsigned char valor = LIVRE;
+
+            if (tipo == 0)
+                valor = rand() % 2 ? OCUPADO : TERRENO_MIN + rand() % 8;
+            else if (tipo == 1)
+                valor = rand() % 3 == 0 ? OCUPADO : LIVRE;
+            else if (tipo == 2)
+                valor = (j / (1 + i % 7)) % 2 ? OCUPADO : LIVRE;
+
+            labirinto_atribuir(l, i, j, valor);
+        }
+    }
+
+    close(mkstemp(arquivo));
+
+    labirinto_salvar_compactado(l, arquivo, 1 + rand() % (n_linhas + 1));
+    Labirinto *lido = labirinto_carregar(arquivo);
+
+    if (!labirintos_iguais(l, lido))
+        falha(semente, "labirinto_salvar_compactado", (Celula){0}, (Celula){0}, labirinto_hash(l), labirinto_hash(lido));
+    labirinto_destruir(lido);
+
+    // bruto: n_linhas, n_colunas e um byte por celula
+    FILE *f = fopen(arquivo, "wb");
+    fwrite(&n_linhas, sizeof(int), 1, f);
+    fwrite(&n_colunas, sizeof(int), 1, f);
+    for (int i = 0; i < n_linhas; i++)
+        for (int j = 0; j < n_colunas; j++)
+            fputc(labirinto_obter(l, i, j), f);
+    fclose(f);
+
+    lido = labirinto_carregar(arquivo);
+
+    if (!labirintos_iguais(l, lido))
+        falha(semente, "labirinto_carregar (bruto)", (Celula){0}, (Celula){0}, labirinto_hash(l), labirinto_hash(lido));
+    labirinto_destruir(lido);
+
+    unlink(arquivo);
+    labirinto_destruir(l);
+}
+
+// layout em blocos: a mesma copia do labirinto nos dois layouts tem o mesmo
+// conteudo, as mesmas mascaras de livres, as mesmas marcas depois de uma
+// busca e os mesmos resultados de busca, inclusive depois de alteracoes e
+// da volta ao layout de linhas. Os mapas passam de um bloco de lado.
+void testar_layout(int semente)
+{
+    srand(semente);
+    int n_linhas = 1 + rand() % (3 * LABIRINTO_BLOCO);
+    int n_colunas = 1 + rand() % (3 * LABIRINTO_BLOCO);
+    int densidade = rand() % 45;
+
+    Labirinto *linhas = labirinto_criar(n_linhas, n_colunas);
+    Labirinto *blocos = labirinto_criar(n_linhas, n_colunas);
+
+    for (int i = 0; i < n_linhas; i++)
+        for (int j = 0; j < n_colunas; j++)
+            if (rand() % 100 < densidade)
+            {
+                labirinto_atribuir(linhas, i, j, OCUPADO);
+                labirinto_atribuir(blocos, i, j, OCUPADO);
+            }
+
+    labirinto_definir_layout(blocos, LAYOUT_BLOCOS);
+
+    for (int q = 0; q < CONSULTAS / 3; q++)
+    {
+        Celula inicio = celula_aleatoria(linhas, n_linhas, n_colunas);
+        Celula fim = celula_aleatoria(linhas, n_linhas, n_colunas);
+
+        if (labirinto_layout(blocos) != LAYOUT_BLOCOS || !labirintos_iguais(linhas, blocos))
+            falha(semente, "labirinto_definir_layout", inicio, fim, LAYOUT_BLOCOS, labirinto_layout(blocos));
+
+        for (int i = 0; i < n_linhas; i++)
+            for (int j = 0; j < n_colunas; j += 1 + rand() % 16)
+                if (labirinto_livres(linhas, i, j) != labirinto_livres(blocos, i, j))
+                    falha(semente, "labirinto_livres (blocos)", (Celula){j, i}, (Celula){j, i}, 0, 0);
+
+        // a_star marca o labirinto; as marcas devem coincidir
+        ResultData a = a_star(linhas, inicio, fim), b = a_star(blocos, inicio, fim);
+
+        if (a.sucesso != b.sucesso || a.nos_expandidos != b.nos_expandidos || fabs(a.custo_caminho - b.custo_caminho) > TOLERANCIA || !labirintos_iguais(linhas, blocos))
+            falha(semente, "a_star (blocos)", inicio, fim, a.custo_caminho, b.custo_caminho);
+        free(a.caminho);
+        free(b.caminho);
+
+        labirinto_limpar(linhas);
+        labirinto_limpar(blocos);
+
+        a = a_star_vizinhanca(linhas, inicio, fim, VIZINHANCA_8, NULL);
+        b = a_star_vizinhanca(blocos, inicio, fim, VIZINHANCA_8, NULL);
+
+        if (a.sucesso != b.sucesso || a.nos_expandidos != b.nos_expandidos || fabs(a.custo_caminho - b.custo_caminho) > TOLERANCIA)
+            falha(semente, "a_star_vizinhanca (blocos)", inicio, fim, a.custo_caminho, b.custo_caminho);
+        free(a.caminho);
+        free(b.caminho);
+
+        // alteracao depois da troca de layout
+        int i = rand() % n_linhas, j = rand() % n_colunas;
+        TipoCelula valor = labirinto_bloqueado(linhas, i, j) ? LIVRE : OCUPADO;
+        labirinto_atribuir(linhas, i, j, valor);
+        labirinto_atribuir(blocos, i, j, valor);
+    }
+
+    labirinto_definir_layout(blocos, LAYOUT_LINHAS);
+
+    if (labirinto_layout(blocos) != LAYOUT_LINHAS || !labirintos_iguais(linhas, blocos))
+        falha(semente, "labirinto_definir_layout (volta)", (Celula){0}, (Celula){0}, LAYOUT_LINHAS, labirinto_layout(blocos));
+
+    labirinto_destruir(linhas);
+    labirinto_destruir(blocos);
+}
+
+// base de caminhos em disco: a base carregada responde com os mesmos
+// caminhos da original, e um labirinto alterado (ou um arquivo inexistente)
+// nao carrega base nenhuma
+void testar_cpd_arquivo(int semente)
+{
+    char arquivo[] = "/tmp/busca_XXXXXX";
+    int n_linhas, n_colunas;
+
+    srand(semente);
+    Labirinto *l = labirinto_aleatorio(&n_linhas, &n_colunas);
+    BaseCaminhos *cpd = base_caminhos_construir(l);
+
+    close(mkstemp(arquivo));
+    base_caminhos_salvar(cpd, arquivo);
+    BaseCaminhos *lida = base_caminhos_carregar(arquivo, l);
+
+    if (lida == NULL || base_caminhos_sequencias(lida) != base_caminhos_sequencias(cpd) || base_caminhos_bytes(lida) != base_caminhos_bytes(cpd))
+        falha(semente, "base_caminhos_carregar", (Celula){0}, (Celula){0}, base_caminhos_sequencias(cpd), lida ? base_caminhos_sequencias(lida) : -1);
+
+    for (int q = 0; lida && q < CONSULTAS / 3; q++)
+    {
+        Celula inicio = celula_aleatoria(l, n_linhas, n_colunas);
+        Celula fim = celula_aleatoria(l, n_linhas, n_colunas);
+
+        ResultData a = base_caminhos_caminho(cpd, inicio, fim, NULL);
+        ResultData b = base_caminhos_caminho(lida, inicio, fim, NULL);
+        int iguais = a.sucesso == b.sucesso && a.tamanho_caminho == b.tamanho_caminho;
+
+        for (int i = 0; iguais && a.sucesso && i < a.tamanho_caminho; i++)
+            iguais = a.caminho[i].x == b.caminho[i].x && a.caminho[i].y == b.caminho[i].y;
+
+        if (!iguais)
+            falha(semente, "base_caminhos_carregar (caminho)", inicio, fim, a.custo_caminho, b.custo_caminho);
+
+        free(a.caminho);
+        free(b.caminho);
+    }
+
+    if (lida)
+        base_caminhos_destruir(lida);
+
+    int i = rand() % n_linhas, j = rand() % n_colunas;
+    labirinto_atribuir(l, i, j, labirinto_bloqueado(l, i, j) ? LIVRE : OCUPADO);
+
+    if ((lida = base_caminhos_carregar(arquivo, l)) != NULL)
+    {
+        falha(semente, "base_caminhos_carregar (alterado)", (Celula){j, i}, (Celula){j, i}, 0, 1);
+        base_caminhos_destruir(lida);
+    }
+
+    unlink(arquivo);
+
+    if ((lida = base_caminhos_carregar(arquivo, l)) != NULL)
+    {
+        falha(semente, "base_caminhos_carregar (inexistente)", (Celula){0}, (Celula){0}, 0, 1);
+        base_caminhos_destruir(lida);
+    }
+
+    base_caminhos_destruir(cpd);
+    labirinto_destruir(l);
+}
+
+int main(int argc, char **argv)
+{
+    int n_labirintos = argc > 1 ? atoi(argv[1]) : 100;
+    int semente = argc > 2 ? atoi(argv[2]) : 1;
+
+    // sementes em que o reparo do D* Lite devolvia custos errados ou nenhum
+    // caminho
+    int sementes_planejador[] = {1185, 2140, 2686, 3575, 3893, 4307};
+
+    for (int i = 0; i < (int)(sizeof(sementes_planejador) / sizeof(int)); i++)
+        testar_planejador(sementes_planejador[i]);
+
+    for (int i = 0; i < n_labirintos; i++)
+    {
+        testar_labirinto(semente + i);
+        testar_planejador(semente + i);
+        testar_delta(semente + i);
+        testar_memoria(semente + i);
+        testar_bfs_bits(semente + i);
+        testar_onda(semente + i);
+        testar_bfs_paralela(semente + i);
+        testar_corrida(semente + i);
+        testar_qualquer_angulo(semente + i);
+        testar_cache(semente + i);
+        testar_arquivos(semente + i);
+        testar_layout(semente + i);
+        testar_cpd_arquivo(semente + i);
+    }
+
+    printf("%d labirintos, %d falhas\n", n_labirintos, falhas);
+
+    return falhas > 0;
+}
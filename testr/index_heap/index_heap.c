@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "index_heap.h"
+
+typedef struct{
+    double priority;
+    double tiebreak;
+    int id;
+} IndexHeapNode;
+
+struct IndexHeap{
+    int capacity;
+    int size;
+    IndexHeapNode *nodes;
+    int *positions;
+};
+
+void _index_heap_place(IndexHeap *heap, int pos, IndexHeapNode node){
+    heap->nodes[pos] = node;
+    heap->positions[node.id] = pos;
+}
+
+// ordem lexicografica (priority, tiebreak)
+bool _index_heap_less(IndexHeapNode *a, IndexHeapNode *b){
+    return a->priority < b->priority || (a->priority == b->priority && a->tiebreak < b->tiebreak);
+}
+
+void _index_heap_up(IndexHeap *heap, int pos){
+    IndexHeapNode aux = heap->nodes[pos];
+
+    while(pos > 0 && _index_heap_less(&aux, &heap->nodes[(pos - 1) / 2])){
+        _index_heap_place(heap, pos, heap->nodes[(pos - 1) / 2]);
+        pos = (pos - 1) / 2;
+    }
+
+    _index_heap_place(heap, pos, aux);
+}
+
+void _index_heap_down(IndexHeap *heap, int pos){
+    IndexHeapNode aux = heap->nodes[pos];
+
+    while(pos < heap->size / 2){
+        int index = 2 * pos + 1;
+
+        if(index + 1 < heap->size && _index_heap_less(&heap->nodes[index + 1], &heap->nodes[index])){
+            index++;
+        }
+
+        if(!_index_heap_less(&heap->nodes[index], &aux)){
+            break;
+        }
+
+        _index_heap_place(heap, pos, heap->nodes[index]);
+        pos = index;
+    }
+
+    _index_heap_place(heap, pos, aux);
+}
+
+IndexHeap *index_heap_construct(int capacity){
+    IndexHeap *heap = (IndexHeap *)calloc(1, sizeof(IndexHeap));
+
+    heap->capacity = capacity;
+    heap->size = 0;
+    heap->nodes = (IndexHeapNode *)malloc(capacity * sizeof(IndexHeapNode));
+    heap->positions = (int *)malloc(capacity * sizeof(int));
+
+    for(int i = 0; i < capacity; i++){
+        heap->positions[i] = -1;
+    }
+
+    return heap;
+}
+
+void index_heap_push(IndexHeap *heap, int id, double priority){
+    index_heap_push_tiebreak(heap, id, priority, 0);
+}
+
+void index_heap_push_tiebreak(IndexHeap *heap, int id, double priority, double tiebreak){
+    if(id < 0 || id >= heap->capacity){
+        printf("ERROR: id %d out of the index heap range [0, %d)\n", id, heap->capacity);
+        exit(1);
+    }
+
+    int pos = heap->positions[id];
+
+    if(pos < 0){
+        pos = heap->size++;
+        _index_heap_place(heap, pos, (IndexHeapNode){priority, tiebreak, id});
+        _index_heap_up(heap, pos);
+        return;
+    }
+
+    IndexHeapNode old = heap->nodes[pos];
+    heap->nodes[pos].priority = priority;
+    heap->nodes[pos].tiebreak = tiebreak;
+
+    if(_index_heap_less(&heap->nodes[pos], &old)){
+        _index_heap_up(heap, pos);
+    }
+    else{
+        _index_heap_down(heap, pos);
+    }
+}
+
+bool index_heap_empty(IndexHeap *heap){
+    return heap->size == 0;
+}
+
+int index_heap_size(IndexHeap *heap){
+    return heap->size;
+}
+
+bool index_heap_contains(IndexHeap *heap, int id){
+    return heap->positions[id] >= 0;
+}
+
+double index_heap_priority(IndexHeap *heap, int id){
+    return heap->nodes[heap->positions[id]].priority;
+}
+
+int index_heap_min(IndexHeap *heap){
+    return heap->nodes[0].id;
+}
+
+double index_heap_min_priority(IndexHeap *heap){
+    return heap->nodes[0].priority;
+}
+
+double index_heap_min_tiebreak(IndexHeap *heap){
+    return heap->nodes[0].tiebreak;
+}
+
+int index_heap_at(IndexHeap *heap, int pos){
+    return heap->nodes[pos].id;
+}
+
+void index_heap_remove(IndexHeap *heap, int id){
+    int pos = heap->positions[id];
+
+    if(pos < 0){
+        return;
+    }
+
+    heap->positions[id] = -1;
+    heap->size--;
+
+    if(pos == heap->size){
+        return;
+    }
+
+    IndexHeapNode old = heap->nodes[pos];
+    _index_heap_place(heap, pos, heap->nodes[heap->size]);
+
+    if(_index_heap_less(&heap->nodes[pos], &old)){
+        _index_heap_up(heap, pos);
+    }
+    else{
+        _index_heap_down(heap, pos);
+    }
+}
+
+int index_heap_pop(IndexHeap *heap){
+    if(heap->size <= 0){
+        printf("ERROR: trying to pop an empty index heap\n");
+        return -1;
+    }
+
+    int id = heap->nodes[0].id;
+    index_heap_remove(heap, id);
+
+    return id;
+}
+
+void index_heap_clear(IndexHeap *heap){
+    for(int i = 0; i < heap->size; i++){
+        heap->positions[heap->nodes[i].id] = -1;
+    }
+
+    heap->size = 0;
+}
+
+void index_heap_destroy(IndexHeap *heap){
+    free(heap->nodes);
+    free(heap->positions);
+    free(heap);
+}
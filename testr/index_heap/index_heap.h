@@ -0,0 +1,40 @@
+
+#ifndef _INDEX_HEAP_H_
+#define _INDEX_HEAP_H_
+
+#include "types.h"
+
+// Heap de minimo sobre identificadores inteiros em [0, capacity), com a
+// posicao de cada identificador guardada em um vetor. Diferente do Heap
+// (que usa uma tabela hash de chaves), atualizar ou remover um item e' O(log n)
+// sem alocacoes, o que serve as buscas sobre grades e grafos indexados.
+typedef struct IndexHeap IndexHeap;
+
+IndexHeap *index_heap_construct(int capacity);
+
+// insere o id ou atualiza a sua prioridade (para cima ou para baixo)
+void index_heap_push(IndexHeap *heap, int id, double priority);
+
+// como index_heap_push, mas empates de priority sao decididos pelo menor
+// tiebreak (ordem lexicografica das duas chaves)
+void index_heap_push_tiebreak(IndexHeap *heap, int id, double priority, double tiebreak);
+
+bool index_heap_empty(IndexHeap *heap);
+int index_heap_size(IndexHeap *heap);
+bool index_heap_contains(IndexHeap *heap, int id);
+double index_heap_priority(IndexHeap *heap, int id);
+int index_heap_min(IndexHeap *heap);
+double index_heap_min_priority(IndexHeap *heap);
+double index_heap_min_tiebreak(IndexHeap *heap);
+
+// id na posicao pos (0 <= pos < size) do vetor do heap, em ordem arbitraria:
+// serve para percorrer os itens sem retira-los
+int index_heap_at(IndexHeap *heap, int pos);
+int index_heap_pop(IndexHeap *heap);
+void index_heap_remove(IndexHeap *heap, int id);
+
+// esvazia o heap em O(tamanho)
+void index_heap_clear(IndexHeap *heap);
+void index_heap_destroy(IndexHeap *heap);
+
+#endif
@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "index_heap.h"
+
+// comandos (o primeiro numero da entrada e' a capacidade, o segundo o numero
+// de comandos):
+//   PUSH id prioridade
+//   TIE id prioridade desempate
+//   POP
+//   REMOVE id
+//   CONTAINS id
+//   ITEMS        (ids do heap em ordem crescente, via index_heap_at)
+//   CLEAR
+
+int cmp_int(const void *a, const void *b)
+{
+    return *(int *)a - *(int *)b;
+}
+
+int main()
+{
+    int i, n, capacity, id;
+    double priority, tiebreak;
+    char cmd[10];
+
+    scanf("%d %d", &capacity, &n);
+
+    IndexHeap *heap = index_heap_construct(capacity);
+
+    for (i = 0; i < n; i++)
+    {
+        scanf("\n%s", cmd);
+
+        if (!strcmp(cmd, "PUSH"))
+        {
+            scanf("%d %lf", &id, &priority);
+            index_heap_push(heap, id, priority);
+        }
+        else if (!strcmp(cmd, "TIE"))
+        {
+            scanf("%d %lf %lf", &id, &priority, &tiebreak);
+            index_heap_push_tiebreak(heap, id, priority, tiebreak);
+        }
+        else if (!strcmp(cmd, "POP"))
+        {
+            if (index_heap_empty(heap))
+            {
+                printf("EMPTY\n");
+                continue;
+            }
+
+            priority = index_heap_min_priority(heap);
+            id = index_heap_pop(heap);
+            printf("%d %g\n", id, priority);
+        }
+        else if (!strcmp(cmd, "REMOVE"))
+        {
+            scanf("%d", &id);
+            index_heap_remove(heap, id);
+        }
+        else if (!strcmp(cmd, "CONTAINS"))
+        {
+            scanf("%d", &id);
+            if (index_heap_contains(heap, id))
+                printf("%d %g\n", id, index_heap_priority(heap, id));
+            else
+                printf("%d ausente\n", id);
+        }
+        else if (!strcmp(cmd, "ITEMS"))
+        {
+            int size = index_heap_size(heap);
+            int *ids = malloc((size + 1) * sizeof(int));
+
+            for (int pos = 0; pos < size; pos++)
+                ids[pos] = index_heap_at(heap, pos);
+
+            qsort(ids, size, sizeof(int), cmp_int);
+
+            printf("%d:", size);
+            for (int pos = 0; pos < size; pos++)
+                printf(" %d", ids[pos]);
+            printf("\n");
+
+            free(ids);
+        }
+        else if (!strcmp(cmd, "CLEAR"))
+            index_heap_clear(heap);
+    }
+
+    index_heap_destroy(heap);
+
+    return 0;
+}
@@ -0,0 +1,309 @@
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "labirinto.h"
+#include "algorithms.h"
+#include "vizinhanca.h"
+#include "../../tools/protocolo_servidor.h"
+
+// Sobe o servidor (../../servidor) com labirintos aleatorios e confere o
+// protocolo: toda resposta casa com um pedido pelo id, os status de
+// labirinto e algoritmo invalidos, os caminhos contra a_star_vizinhanca
+// local, os acertos da cache na repeticao dos pedidos, o fechamento da
+// conexao com um corpo de tamanho errado e o encerramento por SIGTERM.
+// Uso: ./main [n_labirintos [semente]]
+
+#define SERVIDOR "../../servidor"
+#define CONSULTAS 30
+#define TOLERANCIA 1e-6
+
+int falhas = 0;
+
+void falha(char *teste, PedidoServidor *p, double esperado, double obtido)
+{
+    if (falhas++ < 20)
+        printf("pedido %u %s labirinto %u algoritmo %u (%d,%d)->(%d,%d): esperado %g, obtido %g\n", p->id, teste, p->labirinto, p->algoritmo,
+               p->inicio_y, p->inicio_x, p->fim_y, p->fim_x, esperado, obtido);
+}
+
+void escrever_tudo(int fd, void *dados, size_t n)
+{
+    for (size_t escritos = 0; escritos < n;)
+    {
+        ssize_t k = write(fd, (char *)dados + escritos, n - escritos);
+
+        if (k <= 0)
+            exit(printf("Conexao encerrada pelo servidor.\n"));
+
+        escritos += k;
+    }
+}
+
+// 0 se a conexao fechou antes de n bytes
+int ler_tudo(int fd, void *dados, size_t n)
+{
+    for (size_t lidos = 0; lidos < n;)
+    {
+        ssize_t k = read(fd, (char *)dados + lidos, n - lidos);
+
+        if (k <= 0)
+            return 0;
+
+        lidos += k;
+    }
+
+    return 1;
+}
+
+int conectar(char *caminho)
+{
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strncpy(endereco.sun_path, caminho, sizeof(endereco.sun_path) - 1);
+
+    // o servidor pode ainda estar carregando os labirintos
+    for (int tentativa = 0; tentativa < 500; tentativa++)
+    {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (connect(fd, (struct sockaddr *)&endereco, sizeof(endereco)) == 0)
+            return fd;
+
+        close(fd);
+        usleep(10000);
+    }
+
+    exit(printf("Nao foi possivel conectar em %s.\n", caminho));
+}
+
+// o caminho da resposta liga inicio a fim com passos da vizinhanca do
+// algoritmo, e o custo informado e' a soma dos passos
+int caminho_valido(Labirinto *l, PedidoServidor *p, RespostaServidor *r, int32_t *pontos)
+{
+    double custo = 0;
+    int n = r->tamanho_caminho;
+
+    if (n < 1 || pontos[0] != p->inicio_x || pontos[1] != p->inicio_y || pontos[2 * n - 2] != p->fim_x || pontos[2 * n - 1] != p->fim_y)
+        return 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        if (labirinto_bloqueado(l, pontos[2 * i + 1], pontos[2 * i]))
+            return 0;
+
+        if (i > 0)
+        {
+            int dx = abs(pontos[2 * i] - pontos[2 * i - 2]), dy = abs(pontos[2 * i + 1] - pontos[2 * i - 1]);
+
+            if (dx > 1 || dy > 1 || dx + dy == 0 || (dx && dy && p->algoritmo == SERVIDOR_A_STAR_4))
+                return 0;
+
+            custo += dx && dy ? M_SQRT2 : 1.0;
+        }
+    }
+
+    return fabs(custo - r->custo_caminho) < TOLERANCIA;
+}
+
+// envia os pedidos de uma vez e confere as respostas, que podem chegar em
+// qualquer ordem. Na primeira vez, buscados[id] registra se o pedido foi
+// buscado (e guardado na cache); na repeticao, esses pedidos devem vir da
+// cache. Os que vieram de um subcaminho podem nao estar mais indexados.
+void conferir_lote(int fd, Labirinto **labirintos, int n_labirintos, PedidoServidor *pedidos, int n, int repetidos, int *buscados)
+{
+    Vizinhanca vizinhancas[SERVIDOR_N_ALGORITMOS] = {VIZINHANCA_8, VIZINHANCA_4, VIZINHANCA_8_SEM_QUINAS};
+    size_t tamanho = sizeof(uint32_t) + sizeof(PedidoServidor);
+    unsigned char *mensagens = (unsigned char *)malloc(n * tamanho);
+    int *respondidos = (int *)calloc(n, sizeof(int));
+
+    for (int i = 0; i < n; i++)
+    {
+        uint32_t corpo = sizeof(PedidoServidor);
+        memcpy(mensagens + i * tamanho, &corpo, sizeof(uint32_t));
+        memcpy(mensagens + i * tamanho + sizeof(uint32_t), &pedidos[i], sizeof(PedidoServidor));
+    }
+
+    escrever_tudo(fd, mensagens, n * tamanho);
+
+    for (int k = 0; k < n; k++)
+    {
+        uint32_t corpo;
+        RespostaServidor r;
+
+        if (!ler_tudo(fd, &corpo, sizeof(uint32_t)) || corpo < sizeof(r) || !ler_tudo(fd, &r, sizeof(r)))
+            exit(printf("Resposta truncada.\n"));
+
+        int32_t *pontos = (int32_t *)malloc(corpo - sizeof(r) + 1);
+        if (!ler_tudo(fd, pontos, corpo - sizeof(r)))
+            exit(printf("Resposta truncada.\n"));
+
+        if (r.id >= (uint32_t)n || respondidos[r.id]++)
+        {
+            falha("id", &pedidos[0], n, r.id);
+            free(pontos);
+            continue;
+        }
+
+        PedidoServidor *p = &pedidos[r.id];
+
+        if (corpo != sizeof(r) + 2 * sizeof(int32_t) * r.tamanho_caminho)
+            falha("tamanho do corpo", p, sizeof(r) + 2 * sizeof(int32_t) * r.tamanho_caminho, corpo);
+        else if (p->labirinto >= (uint32_t)n_labirintos)
+        {
+            if (r.status != SERVIDOR_LABIRINTO_INVALIDO)
+                falha("status", p, SERVIDOR_LABIRINTO_INVALIDO, r.status);
+        }
+        else if (p->algoritmo >= SERVIDOR_N_ALGORITMOS)
+        {
+            if (r.status != SERVIDOR_ALGORITMO_INVALIDO)
+                falha("status", p, SERVIDOR_ALGORITMO_INVALIDO, r.status);
+        }
+        else
+        {
+            Labirinto *l = labirintos[p->labirinto];
+            Celula inicio = {0}, fim = {0};
+            inicio.x = p->inicio_x;
+            inicio.y = p->inicio_y;
+            fim.x = p->fim_x;
+            fim.y = p->fim_y;
+
+            ResultData esperado = a_star_vizinhanca(l, inicio, fim, vizinhancas[p->algoritmo], NULL);
+
+            if (r.status != SERVIDOR_OK)
+                falha("status", p, SERVIDOR_OK, r.status);
+            else if (r.sucesso != esperado.sucesso || (r.sucesso && (fabs(r.custo_caminho - esperado.custo_caminho) > TOLERANCIA || !caminho_valido(l, p, &r, pontos))))
+                falha("caminho", p, esperado.sucesso ? esperado.custo_caminho : INFINITY, r.sucesso ? r.custo_caminho : INFINITY);
+            else if (repetidos && buscados[r.id] && !r.cache)
+                falha("cache", p, 1, r.cache);
+
+            if (!repetidos)
+                buscados[r.id] = !r.cache;
+
+            free(esperado.caminho);
+        }
+
+        free(pontos);
+    }
+
+    free(mensagens);
+    free(respondidos);
+}
+
+int main(int argc, char **argv)
+{
+    int n_labirintos = argc > 1 ? atoi(argv[1]) : 8;
+    int semente = argc > 2 ? atoi(argv[2]) : 1;
+
+    if (n_labirintos < 1)
+        exit(printf("n_labirintos deve ser positivo.\n"));
+
+    srand(semente);
+
+    char socket_servidor[] = "/tmp/servidor_XXXXXX";
+    close(mkstemp(socket_servidor));
+
+    Labirinto **labirintos = (Labirinto **)malloc(n_labirintos * sizeof(Labirinto *));
+    char **argumentos = (char **)calloc(n_labirintos + 4, sizeof(char *));
+
+    argumentos[0] = SERVIDOR;
+    argumentos[1] = socket_servidor;
+    argumentos[2] = "3";
+
+    for (int m = 0; m < n_labirintos; m++)
+    {
+        int n_linhas = 2 + rand() % 60, n_colunas = 2 + rand() % 60;
+        int densidade = rand() % 45;
+
+        labirintos[m] = labirinto_criar(n_linhas, n_colunas);
+
+        for (int i = 0; i < n_linhas; i++)
+            for (int j = 0; j < n_colunas; j++)
+                if (rand() % 100 < densidade)
+                    labirinto_atribuir(labirintos[m], i, j, OCUPADO);
+
+        argumentos[3 + m] = strdup("/tmp/servidor_lab_XXXXXX");
+        close(mkstemp(argumentos[3 + m]));
+        labirinto_salvar_compactado(labirintos[m], argumentos[3 + m], LABIRINTO_LINHAS_POR_BLOCO);
+    }
+
+    pid_t servidor = fork();
+
+    if (servidor == 0)
+    {
+        // a linha de inicio e as estatisticas da cache nao interessam aqui
+        freopen("/dev/null", "w", stdout);
+        execv(SERVIDOR, argumentos);
+        exit(printf("Nao foi possivel executar %s.\n", SERVIDOR));
+    }
+
+    int fd = conectar(socket_servidor);
+
+    // pedidos validos, com algumas pontas fora do mapa ou bloqueadas, e
+    // alguns com labirinto ou algoritmo invalido
+    int n = n_labirintos * CONSULTAS;
+    PedidoServidor *pedidos = (PedidoServidor *)calloc(n, sizeof(PedidoServidor));
+    int *buscados = (int *)calloc(n, sizeof(int));
+
+    for (int i = 0; i < n; i++)
+    {
+        PedidoServidor *p = &pedidos[i];
+        Labirinto *l = labirintos[i % n_labirintos];
+        int n_linhas = labirinto_n_linhas(l), n_colunas = labirinto_n_colunas(l);
+
+        p->id = i;
+        p->labirinto = rand() % 20 ? i % n_labirintos : n_labirintos + rand() % 3;
+        p->algoritmo = rand() % 20 ? rand() % SERVIDOR_N_ALGORITMOS : SERVIDOR_N_ALGORITMOS + rand() % 3;
+        p->inicio_x = rand() % n_colunas;
+        p->inicio_y = rand() % n_linhas;
+        p->fim_x = rand() % 20 ? rand() % n_colunas : n_colunas;
+        p->fim_y = rand() % 20 ? rand() % n_linhas : -1;
+    }
+
+    conferir_lote(fd, labirintos, n_labirintos, pedidos, n, 0, buscados);
+    conferir_lote(fd, labirintos, n_labirintos, pedidos, n, 1, buscados);
+
+    // um corpo de tamanho errado encerra a conexao sem resposta
+    unsigned char invalido[sizeof(uint32_t) + 3] = {0};
+    uint32_t corpo = 3;
+    memcpy(invalido, &corpo, sizeof(uint32_t));
+    escrever_tudo(fd, invalido, sizeof(invalido));
+
+    if (ler_tudo(fd, &corpo, 1))
+        falha("corpo invalido", &pedidos[0], 0, 1);
+    close(fd);
+
+    // a conexao anterior nao derruba o servidor
+    fd = conectar(socket_servidor);
+    conferir_lote(fd, labirintos, n_labirintos, pedidos, 1, 1, buscados);
+    close(fd);
+
+    int estado;
+    kill(servidor, SIGTERM);
+    waitpid(servidor, &estado, 0);
+
+    if (!WIFEXITED(estado) || WEXITSTATUS(estado) != 0 || access(socket_servidor, F_OK) == 0)
+        falha("encerramento", &pedidos[0], 0, WIFEXITED(estado) ? WEXITSTATUS(estado) : -1);
+
+    for (int m = 0; m < n_labirintos; m++)
+    {
+        unlink(argumentos[3 + m]);
+        free(argumentos[3 + m]);
+        labirinto_destruir(labirintos[m]);
+    }
+
+    free(argumentos);
+    free(labirintos);
+    free(pedidos);
+    free(buscados);
+
+    printf("%d labirintos, %d pedidos, %d falhas\n", n_labirintos, 2 * n + 1, falhas);
+
+    return falhas > 0;
+}
@@ -0,0 +1,50 @@
+// Constroi a base de caminhos comprimida (CPD) de cada labirinto e a salva
+// ao lado dele, trocando a extensao por .cpd.
+// Uso: ./construir_cpd labirinto.bin [outros labirintos...]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../src/search/labirinto.h"
+#include "../src/search/cpd.h"
+
+double _agora()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+        exit(printf("Uso: %s labirinto.bin [outros labirintos...]\n", argv[0]));
+
+    int falhas = 0;
+
+    for (int a = 1; a < argc; a++)
+    {
+        Labirinto *l = labirinto_carregar(argv[a]);
+
+        double t0 = _agora();
+        BaseCaminhos *b = base_caminhos_construir(l);
+
+        if (!b)
+        {
+            printf("%s: mais de %d celulas livres, base nao construida\n", argv[a], CPD_MAX_LIVRES);
+            labirinto_destruir(l);
+            falhas++;
+            continue;
+        }
+
+        char arquivo[1024];
+        base_caminhos_arquivo(argv[a], arquivo, sizeof(arquivo));
+        base_caminhos_salvar(b, arquivo);
+
+        printf("%s: %ld sequencias, %ld bytes em %.2fs\n", arquivo, base_caminhos_sequencias(b), base_caminhos_bytes(b), _agora() - t0);
+
+        base_caminhos_destruir(b);
+        labirinto_destruir(l);
+    }
+
+    return falhas > 0;
+}
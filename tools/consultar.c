@@ -0,0 +1,154 @@
+// Cliente do servidor de caminhos (tools/servidor.c): envia a mesma consulta
+// repeticoes vezes, com ate em_voo pedidos sem resposta, imprime o resultado
+// como o main e o tempo medio por consulta.
+// Uso: ./consultar caminho.sock labirinto algoritmo x0 y0 x1 y1 [repeticoes [em_voo]]
+// labirinto e' a posicao dele na linha de comando do servidor e algoritmo e'
+// A*8, A*4 ou A*8-SEM-QUINAS.
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#include "protocolo_servidor.h"
+
+double _agora()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+void _ler_tudo(int fd, void *dados, size_t n)
+{
+    for (size_t lidos = 0; lidos < n;)
+    {
+        ssize_t k = read(fd, (char *)dados + lidos, n - lidos);
+
+        if (k <= 0)
+            exit(printf("Conexao encerrada pelo servidor.\n"));
+
+        lidos += k;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 8)
+        exit(printf("Uso: %s caminho.sock labirinto algoritmo x0 y0 x1 y1 [repeticoes [em_voo]]\n", argv[0]));
+
+    const char *nomes[SERVIDOR_N_ALGORITMOS] = {"A*8", "A*4", "A*8-SEM-QUINAS"};
+    int algoritmo = 0;
+    while (algoritmo < SERVIDOR_N_ALGORITMOS && strcmp(argv[3], nomes[algoritmo]))
+        algoritmo++;
+
+    if (algoritmo == SERVIDOR_N_ALGORITMOS)
+        exit(printf("Algoritmo desconhecido: %s\n", argv[3]));
+
+    int repeticoes = argc > 8 ? atoi(argv[8]) : 1;
+    int em_voo = argc > 9 ? atoi(argv[9]) : 1;
+    if (repeticoes < 1 || em_voo < 1)
+        exit(printf("repeticoes e em_voo devem ser positivos.\n"));
+
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strncpy(endereco.sun_path, argv[1], sizeof(endereco.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&endereco, sizeof(endereco)) < 0)
+        exit(printf("Nao foi possivel conectar em %s: %s\n", argv[1], strerror(errno)));
+
+    uint32_t corpo = sizeof(PedidoServidor);
+    unsigned char mensagem[sizeof(uint32_t) + sizeof(PedidoServidor)];
+    PedidoServidor p;
+
+    p.labirinto = atoi(argv[2]);
+    p.algoritmo = algoritmo;
+    p.inicio_x = atoi(argv[4]);
+    p.inicio_y = atoi(argv[5]);
+    p.fim_x = atoi(argv[6]);
+    p.fim_y = atoi(argv[7]);
+
+    RespostaServidor r;
+    int32_t *pontos = NULL;
+    int enviados = 0, recebidos = 0, acertos_cache = 0;
+    double t0 = _agora();
+
+    // bytes do pedido atual que ainda faltam ser enviados
+    int faltam = 0;
+
+    while (recebidos < repeticoes)
+    {
+        // o servidor para de ler uma conexao que acumula respostas nao lidas,
+        // entao so' escreve o que o socket aceitar e le assim que houver
+        // resposta, em vez de bloquear em uma escrita
+        if (faltam == 0 && enviados < repeticoes && enviados - recebidos < em_voo)
+        {
+            p.id = enviados++;
+            memcpy(mensagem, &corpo, sizeof(uint32_t));
+            memcpy(mensagem + sizeof(uint32_t), &p, sizeof(p));
+            faltam = sizeof(mensagem);
+        }
+
+        struct pollfd pfd = {fd, POLLIN | (faltam ? POLLOUT : 0), 0};
+        if (poll(&pfd, 1, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            exit(printf("Erro no poll: %s\n", strerror(errno)));
+        }
+
+        if (pfd.revents & POLLOUT)
+        {
+            ssize_t k = send(fd, mensagem + sizeof(mensagem) - faltam, faltam, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+            if (k < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                exit(printf("Erro ao enviar: %s\n", strerror(errno)));
+            if (k > 0)
+                faltam -= k;
+        }
+
+        if (!(pfd.revents & (POLLIN | POLLHUP | POLLERR)))
+            continue;
+
+        uint32_t tamanho;
+        _ler_tudo(fd, &tamanho, sizeof(uint32_t));
+
+        if (tamanho < sizeof(RespostaServidor))
+            exit(printf("Resposta de %u bytes invalida.\n", tamanho));
+
+        _ler_tudo(fd, &r, sizeof(r));
+
+        pontos = (int32_t *)realloc(pontos, tamanho - sizeof(r) + 1);
+        _ler_tudo(fd, pontos, tamanho - sizeof(r));
+
+        acertos_cache += r.cache;
+        recebidos++;
+    }
+
+    double total = _agora() - t0;
+    close(fd);
+
+    if (r.status != SERVIDOR_OK)
+        printf("ERRO %d\n", r.status);
+    else if (!r.sucesso)
+        printf("IMPOSSIVEL\n");
+    else
+    {
+        for (int i = 0; i < r.tamanho_caminho; i++)
+            printf("%d %d\n", pontos[2 * i], pontos[2 * i + 1]);
+
+        printf("%.2lf\n", r.custo_caminho);
+        printf("%d\n", r.tamanho_caminho);
+        printf("%d\n", r.nos_expandidos);
+    }
+
+    fprintf(stderr, "%d consultas em %.3fs (%.1f us cada), %d da cache\n", repeticoes, total, total * 1e6 / repeticoes, acertos_cache);
+
+    free(pontos);
+    return 0;
+}
@@ -0,0 +1,59 @@
+#ifndef _PROTOCOLO_SERVIDOR_H_
+#define _PROTOCOLO_SERVIDOR_H_
+
+// Protocolo do servidor de caminhos (tools/servidor.c) sobre um socket Unix.
+// Cada mensagem e' um uint32_t com o tamanho do corpo seguido do corpo, nos
+// dois sentidos, na ordem de bytes da maquina (o socket e' local). Um cliente
+// pode enviar varios pedidos sem esperar as respostas; como os pedidos sao
+// atendidos por varias threads, as respostas podem chegar fora de ordem e
+// trazem o id do pedido.
+
+#include <stdint.h>
+
+// motores atendidos; nenhum marca celulas, entao os labirintos carregados
+// sao compartilhados entre as threads
+typedef enum
+{
+    SERVIDOR_A_STAR_8 = 0,
+    SERVIDOR_A_STAR_4,
+    SERVIDOR_A_STAR_8_SEM_QUINAS,
+    SERVIDOR_N_ALGORITMOS
+} AlgoritmoServidor;
+
+typedef enum
+{
+    SERVIDOR_OK = 0,
+
+    // labirinto fora da lista carregada pelo servidor
+    SERVIDOR_LABIRINTO_INVALIDO,
+    SERVIDOR_ALGORITMO_INVALIDO
+} StatusServidor;
+
+// corpo de um pedido; um corpo de outro tamanho encerra a conexao
+typedef struct
+{
+    uint32_t id;
+
+    // posicao do labirinto na linha de comando do servidor (a partir de 0)
+    uint32_t labirinto;
+    uint32_t algoritmo;
+    int32_t inicio_x, inicio_y;
+    int32_t fim_x, fim_y;
+} PedidoServidor;
+
+// corpo de uma resposta: o cabecalho seguido de tamanho_caminho pares
+// (x, y) de int32_t
+typedef struct
+{
+    uint32_t id;
+    int32_t status;
+    int32_t sucesso;
+    int32_t nos_expandidos;
+    double custo_caminho;
+    int32_t tamanho_caminho;
+
+    // 1 se a resposta veio da cache de resultados do servidor
+    int32_t cache;
+} RespostaServidor;
+
+#endif
@@ -0,0 +1,630 @@
+// Servidor residente de caminhos: carrega os labirintos uma vez e atende
+// pedidos binarios (tools/protocolo_servidor.h) por um socket Unix. A thread
+// principal faz o laco de eventos com poll (conexoes, leitura e montagem dos
+// pedidos); as buscas rodam em um conjunto de threads, que escrevem as
+// respostas direto no socket. Os resultados passam por uma CacheResultados
+// compartilhada, protegida por um mutex.
+// Uso: ./servidor caminho.sock n_threads labirinto.bin [outros labirintos...]
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../src/search/labirinto.h"
+#include "../src/search/algorithms.h"
+#include "../src/search/cache.h"
+#include "../src/search/vizinhanca.h"
+#include "protocolo_servidor.h"
+
+// bytes lidos de cada vez de um cliente
+#define SERVIDOR_LEITURA 4096
+
+// acima destes limites a conexao deixa de ser lida ate' as respostas
+// andarem: um cliente que envia sem ler nao faz a fila de tarefas nem o
+// buffer de saida crescerem sem limite. Uma leitura ja' feita pode passar
+// de SERVIDOR_MAX_PENDENTES pelos pedidos de um bloco de SERVIDOR_LEITURA.
+#define SERVIDOR_MAX_PENDENTES 1024
+#define SERVIDOR_MAX_SAIDA (1 << 20)
+
+typedef struct
+{
+    // -1 para um espaco livre na tabela de conexoes
+    int fd;
+
+    // muda a cada reuso do espaco, para que respostas de uma conexao ja
+    // fechada nao sejam escritas na seguinte
+    unsigned geracao;
+
+    unsigned char *entrada;
+    int n_entrada, cap_entrada;
+
+    // resposta que o socket nao aceitou de uma vez; a thread principal
+    // termina de enviar quando ele puder ser escrito
+    unsigned char *saida;
+    int n_saida, cap_saida;
+
+    // pedidos enfileirados ainda sem resposta
+    int pendentes;
+
+    // o cliente terminou de enviar (fim de arquivo na leitura): a conexao
+    // fecha depois que as respostas pendentes forem entregues
+    int fim_entrada;
+} _Conexao;
+
+typedef struct
+{
+    int conexao;
+    unsigned geracao;
+    PedidoServidor pedido;
+} _Tarefa;
+
+typedef struct
+{
+    Labirinto **labirintos;
+    int n_labirintos;
+
+    // protege a tabela de conexoes e os buffers de saida
+    pthread_mutex_t mutex;
+    _Conexao *conexoes;
+    int n_conexoes;
+
+    // fila circular de tarefas para as threads de busca
+    pthread_mutex_t mutex_fila;
+    pthread_cond_t tem_tarefa;
+    _Tarefa *fila;
+    int inicio_fila, n_fila, cap_fila;
+    int encerrar;
+
+    pthread_mutex_t mutex_cache;
+    CacheResultados *cache;
+
+    // as threads de busca e os sinais acordam o poll escrevendo aqui
+    int despertar[2];
+} _Servidor;
+
+static volatile sig_atomic_t _encerrar = 0;
+static int _despertar_sinal = -1;
+
+const char *_servidor_nome_algoritmo[SERVIDOR_N_ALGORITMOS] = {"A*8", "A*4", "A*8-SEM-QUINAS"};
+Vizinhanca _servidor_vizinhanca[SERVIDOR_N_ALGORITMOS] = {VIZINHANCA_8, VIZINHANCA_4, VIZINHANCA_8_SEM_QUINAS};
+
+void _servidor_sinal(int sinal)
+{
+    _encerrar = 1;
+
+    int erro = errno;
+    write(_despertar_sinal, "s", 1);
+    errno = erro;
+}
+
+void _servidor_acordar(_Servidor *s)
+{
+    // pipe cheio ja garante que o poll vai acordar
+    write(s->despertar[1], "t", 1);
+}
+
+void _servidor_garantir(unsigned char **buffer, int *cap, int tamanho)
+{
+    if (tamanho <= *cap)
+        return;
+
+    while (*cap < tamanho)
+        *cap = *cap ? 2 * *cap : SERVIDOR_LEITURA;
+
+    *buffer = (unsigned char *)realloc(*buffer, *cap);
+}
+
+// envia o que o socket aceitar sem bloquear; devolve quantos bytes foram
+// enviados, ou -1 se a conexao caiu
+int _servidor_enviar(int fd, unsigned char *dados, int n)
+{
+    int enviados = 0;
+
+    while (enviados < n)
+    {
+        ssize_t k = send(fd, dados + enviados, n - enviados, MSG_NOSIGNAL);
+
+        if (k < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            return -1;
+        }
+
+        enviados += k;
+    }
+
+    return enviados;
+}
+
+void _servidor_responder(_Servidor *s, _Tarefa *t, unsigned char *mensagem, int n)
+{
+    pthread_mutex_lock(&s->mutex);
+
+    _Conexao *c = &s->conexoes[t->conexao];
+
+    if (c->fd >= 0 && c->geracao == t->geracao)
+    {
+        // so' escreve direto se nao ha nada na frente, para nao embaralhar
+        // os bytes de duas respostas
+        int enviados = c->n_saida == 0 ? _servidor_enviar(c->fd, mensagem, n) : 0;
+
+        // uma conexao caida e' fechada pela thread principal no proximo poll
+        if (enviados >= 0 && enviados < n)
+        {
+            _servidor_garantir(&c->saida, &c->cap_saida, c->n_saida + n - enviados);
+            memcpy(c->saida + c->n_saida, mensagem + enviados, n - enviados);
+            c->n_saida += n - enviados;
+            _servidor_acordar(s);
+        }
+
+        // ultima resposta de um cliente que ja parou de enviar, ou a conexao
+        // acabou de voltar para baixo do limite e pode ser lida de novo
+        if (--c->pendentes == 0 && c->fim_entrada)
+            _servidor_acordar(s);
+        else if (c->pendentes == SERVIDOR_MAX_PENDENTES - 1)
+            _servidor_acordar(s);
+    }
+
+    pthread_mutex_unlock(&s->mutex);
+}
+
+void _servidor_atender(_Servidor *s, _Tarefa *t, ContextoVizinhanca *contexto)
+{
+    PedidoServidor *p = &t->pedido;
+    RespostaServidor r;
+    ResultData result = _default_result();
+
+    memset(&r, 0, sizeof(r));
+    r.id = p->id;
+
+    if (p->labirinto >= (uint32_t)s->n_labirintos)
+        r.status = SERVIDOR_LABIRINTO_INVALIDO;
+    else if (p->algoritmo >= SERVIDOR_N_ALGORITMOS)
+        r.status = SERVIDOR_ALGORITMO_INVALIDO;
+    else
+    {
+        Labirinto *l = s->labirintos[p->labirinto];
+        Celula inicio = {0}, fim = {0};
+        inicio.x = p->inicio_x;
+        inicio.y = p->inicio_y;
+        fim.x = p->fim_x;
+        fim.y = p->fim_y;
+
+        const char *nome = _servidor_nome_algoritmo[p->algoritmo];
+
+        pthread_mutex_lock(&s->mutex_cache);
+        r.cache = cache_resultados_buscar(s->cache, l, inicio, fim, nome, &result);
+        pthread_mutex_unlock(&s->mutex_cache);
+
+        if (!r.cache)
+        {
+            result = a_star_vizinhanca_contexto(l, inicio, fim, _servidor_vizinhanca[p->algoritmo], contexto, NULL);
+
+            pthread_mutex_lock(&s->mutex_cache);
+            cache_resultados_guardar(s->cache, l, inicio, fim, nome, &result, 1);
+            pthread_mutex_unlock(&s->mutex_cache);
+        }
+
+        r.status = SERVIDOR_OK;
+        r.sucesso = result.sucesso;
+        r.nos_expandidos = result.nos_expandidos;
+        r.custo_caminho = result.custo_caminho;
+        r.tamanho_caminho = result.sucesso ? result.tamanho_caminho : 0;
+    }
+
+    uint32_t corpo = sizeof(r) + 2 * sizeof(int32_t) * r.tamanho_caminho;
+    unsigned char *mensagem = (unsigned char *)malloc(sizeof(uint32_t) + corpo);
+
+    memcpy(mensagem, &corpo, sizeof(uint32_t));
+    memcpy(mensagem + sizeof(uint32_t), &r, sizeof(r));
+
+    int32_t *pontos = (int32_t *)(mensagem + sizeof(uint32_t) + sizeof(r));
+    for (int i = 0; i < r.tamanho_caminho; i++)
+    {
+        pontos[2 * i] = result.caminho[i].x;
+        pontos[2 * i + 1] = result.caminho[i].y;
+    }
+
+    _servidor_responder(s, t, mensagem, sizeof(uint32_t) + corpo);
+
+    free(mensagem);
+    free(result.caminho);
+}
+
+void *_servidor_trabalhador(void *arg)
+{
+    _Servidor *s = (_Servidor *)arg;
+
+    // memoria de busca da thread, dimensionada pelo maior labirinto ja'
+    // consultado e reaproveitada nas consultas seguintes
+    ContextoVizinhanca *contexto = contexto_vizinhanca_criar();
+
+    while (1)
+    {
+        pthread_mutex_lock(&s->mutex_fila);
+
+        while (s->n_fila == 0 && !s->encerrar)
+            pthread_cond_wait(&s->tem_tarefa, &s->mutex_fila);
+
+        if (s->n_fila == 0)
+        {
+            pthread_mutex_unlock(&s->mutex_fila);
+            contexto_vizinhanca_destruir(contexto);
+            return NULL;
+        }
+
+        _Tarefa t = s->fila[s->inicio_fila];
+        s->inicio_fila = (s->inicio_fila + 1) % s->cap_fila;
+        s->n_fila--;
+
+        pthread_mutex_unlock(&s->mutex_fila);
+
+        _servidor_atender(s, &t, contexto);
+    }
+}
+
+void _servidor_enfileirar(_Servidor *s, _Tarefa *t)
+{
+    pthread_mutex_lock(&s->mutex_fila);
+
+    if (s->n_fila == s->cap_fila)
+    {
+        // desenrola a fila circular no vetor novo
+        int cap = s->cap_fila ? 2 * s->cap_fila : 64;
+        _Tarefa *fila = (_Tarefa *)malloc(cap * sizeof(_Tarefa));
+
+        for (int i = 0; i < s->n_fila; i++)
+            fila[i] = s->fila[(s->inicio_fila + i) % s->cap_fila];
+
+        free(s->fila);
+        s->fila = fila;
+        s->cap_fila = cap;
+        s->inicio_fila = 0;
+    }
+
+    s->fila[(s->inicio_fila + s->n_fila) % s->cap_fila] = *t;
+    s->n_fila++;
+
+    pthread_cond_signal(&s->tem_tarefa);
+    pthread_mutex_unlock(&s->mutex_fila);
+}
+
+void _servidor_fechar(_Servidor *s, int i)
+{
+    pthread_mutex_lock(&s->mutex);
+
+    _Conexao *c = &s->conexoes[i];
+    close(c->fd);
+    c->fd = -1;
+    c->geracao++;
+    c->n_entrada = c->n_saida = 0;
+    c->pendentes = c->fim_entrada = 0;
+
+    pthread_mutex_unlock(&s->mutex);
+}
+
+void _servidor_aceitar(_Servidor *s, int escuta)
+{
+    int fd;
+
+    while ((fd = accept(escuta, NULL, NULL)) >= 0)
+    {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+        pthread_mutex_lock(&s->mutex);
+
+        int i = 0;
+        while (i < s->n_conexoes && s->conexoes[i].fd >= 0)
+            i++;
+
+        if (i == s->n_conexoes)
+        {
+            s->conexoes = (_Conexao *)realloc(s->conexoes, (s->n_conexoes + 1) * sizeof(_Conexao));
+            memset(&s->conexoes[i], 0, sizeof(_Conexao));
+            s->n_conexoes++;
+        }
+
+        s->conexoes[i].fd = fd;
+
+        pthread_mutex_unlock(&s->mutex);
+    }
+}
+
+// le o que chegou e enfileira os pedidos completos. 0 se a conexao deve ser
+// fechada ja' (erro ou mensagem fora do protocolo); o fim da entrada so'
+// marca fim_entrada.
+int _servidor_ler(_Servidor *s, int i)
+{
+    // so' a thread principal mexe na entrada e fecha conexoes, entao c pode
+    // ser lido sem o mutex enquanto a tabela nao cresce
+    _Conexao *c = &s->conexoes[i];
+    int fim = 0;
+    int pendentes = 0;
+
+    do
+    {
+        _servidor_garantir(&c->entrada, &c->cap_entrada, c->n_entrada + SERVIDOR_LEITURA);
+        ssize_t k = recv(c->fd, c->entrada + c->n_entrada, SERVIDOR_LEITURA, 0);
+
+        if (k == 0)
+        {
+            fim = 1;
+            break;
+        }
+
+        if (k < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            return 0;
+        }
+
+        c->n_entrada += k;
+
+        int lidos = 0;
+
+        while (c->n_entrada - lidos >= (int)sizeof(uint32_t))
+        {
+            uint32_t corpo;
+            memcpy(&corpo, c->entrada + lidos, sizeof(uint32_t));
+
+            if (corpo != sizeof(PedidoServidor))
+                return 0;
+
+            if (c->n_entrada - lidos < (int)(sizeof(uint32_t) + corpo))
+                break;
+
+            _Tarefa t;
+            t.conexao = i;
+            t.geracao = c->geracao;
+            memcpy(&t.pedido, c->entrada + lidos + sizeof(uint32_t), sizeof(PedidoServidor));
+
+            // contado antes de enfileirar, para que a resposta nunca chegue antes
+            pthread_mutex_lock(&s->mutex);
+            c->pendentes++;
+            pthread_mutex_unlock(&s->mutex);
+
+            _servidor_enfileirar(s, &t);
+            lidos += sizeof(uint32_t) + corpo;
+        }
+
+        memmove(c->entrada, c->entrada + lidos, c->n_entrada - lidos);
+        c->n_entrada -= lidos;
+
+        // o resto fica no socket ate' o poll voltar a pedir POLLIN
+        pthread_mutex_lock(&s->mutex);
+        pendentes = c->pendentes;
+        pthread_mutex_unlock(&s->mutex);
+    } while (pendentes < SERVIDOR_MAX_PENDENTES);
+
+    if (fim)
+    {
+        pthread_mutex_lock(&s->mutex);
+        c->fim_entrada = 1;
+        pthread_mutex_unlock(&s->mutex);
+    }
+
+    return 1;
+}
+
+// a conexao ainda pode ser lida: o cliente nao terminou de enviar e nem os
+// pedidos pendentes nem a saida acumulada estao acima do limite. Chamada
+// com o mutex.
+int _servidor_aceita_pedidos(_Conexao *c)
+{
+    return !c->fim_entrada && c->pendentes < SERVIDOR_MAX_PENDENTES && c->n_saida < SERVIDOR_MAX_SAIDA;
+}
+
+// o cliente parou de enviar e ja recebeu todas as respostas
+int _servidor_concluida(_Servidor *s, int i)
+{
+    pthread_mutex_lock(&s->mutex);
+
+    _Conexao *c = &s->conexoes[i];
+    int concluida = c->fd >= 0 && c->fim_entrada && c->pendentes == 0 && c->n_saida == 0;
+
+    pthread_mutex_unlock(&s->mutex);
+    return concluida;
+}
+
+// envia as respostas pendentes; 0 se a conexao caiu
+int _servidor_escrever(_Servidor *s, int i)
+{
+    pthread_mutex_lock(&s->mutex);
+
+    _Conexao *c = &s->conexoes[i];
+    int enviados = _servidor_enviar(c->fd, c->saida, c->n_saida);
+
+    if (enviados > 0)
+    {
+        memmove(c->saida, c->saida + enviados, c->n_saida - enviados);
+        c->n_saida -= enviados;
+    }
+
+    pthread_mutex_unlock(&s->mutex);
+    return enviados >= 0;
+}
+
+int _servidor_escutar(char *caminho)
+{
+    struct sockaddr_un endereco;
+
+    if (strlen(caminho) >= sizeof(endereco.sun_path))
+        exit(printf("Caminho de socket muito longo: %s\n", caminho));
+
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    // um socket deixado por uma execucao anterior impediria o bind
+    unlink(caminho);
+
+    if (fd < 0 || bind(fd, (struct sockaddr *)&endereco, sizeof(endereco)) < 0 || listen(fd, SOMAXCONN) < 0)
+        exit(printf("Nao foi possivel escutar em %s: %s\n", caminho, strerror(errno)));
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+        exit(printf("Uso: %s caminho.sock n_threads labirinto.bin [outros labirintos...]\n", argv[0]));
+
+    int n_threads = atoi(argv[2]);
+    if (n_threads < 1)
+        exit(printf("Numero de threads invalido: %s\n", argv[2]));
+
+    _Servidor s;
+    memset(&s, 0, sizeof(s));
+
+    s.n_labirintos = argc - 3;
+    s.labirintos = (Labirinto **)malloc(s.n_labirintos * sizeof(Labirinto *));
+    for (int i = 0; i < s.n_labirintos; i++)
+        s.labirintos[i] = labirinto_carregar(argv[3 + i]);
+
+    s.cache = cache_resultados_criar(CACHE_CAPACIDADE_PADRAO);
+    pthread_mutex_init(&s.mutex, NULL);
+    pthread_mutex_init(&s.mutex_fila, NULL);
+    pthread_mutex_init(&s.mutex_cache, NULL);
+    pthread_cond_init(&s.tem_tarefa, NULL);
+
+    if (pipe(s.despertar) < 0)
+        exit(printf("Nao foi possivel criar o pipe: %s\n", strerror(errno)));
+
+    for (int i = 0; i < 2; i++)
+        fcntl(s.despertar[i], F_SETFL, fcntl(s.despertar[i], F_GETFL) | O_NONBLOCK);
+
+    _despertar_sinal = s.despertar[1];
+
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = _servidor_sinal;
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+
+    int escuta = _servidor_escutar(argv[1]);
+
+    pthread_t *threads = (pthread_t *)malloc(n_threads * sizeof(pthread_t));
+    for (int t = 0; t < n_threads; t++)
+        pthread_create(&threads[t], NULL, _servidor_trabalhador, &s);
+
+    printf("%d labirinto(s) carregado(s), %d thread(s), escutando em %s\n", s.n_labirintos, n_threads, argv[1]);
+    fflush(stdout);
+
+    struct pollfd *pfds = NULL;
+    int *indices = NULL;
+
+    while (!_encerrar)
+    {
+        // a tabela so' cresce na thread principal, entao pode ser lida aqui
+        // sem o mutex; n_saida e' lido sob ele
+        pfds = (struct pollfd *)realloc(pfds, (s.n_conexoes + 2) * sizeof(struct pollfd));
+        indices = (int *)realloc(indices, (s.n_conexoes + 2) * sizeof(int));
+
+        int n = 0;
+        pfds[n++] = (struct pollfd){escuta, POLLIN, 0};
+        pfds[n++] = (struct pollfd){s.despertar[0], POLLIN, 0};
+
+        pthread_mutex_lock(&s.mutex);
+        for (int i = 0; i < s.n_conexoes; i++)
+        {
+            if (s.conexoes[i].fd < 0)
+                continue;
+
+            // depois do fim da entrada, ou enquanto o cliente nao le as
+            // respostas, so' falta escrever
+            indices[n] = i;
+            pfds[n++] = (struct pollfd){s.conexoes[i].fd, (_servidor_aceita_pedidos(&s.conexoes[i]) ? POLLIN : 0) | (s.conexoes[i].n_saida > 0 ? POLLOUT : 0), 0};
+        }
+        pthread_mutex_unlock(&s.mutex);
+
+        if (poll(pfds, n, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            exit(printf("Erro no poll: %s\n", strerror(errno)));
+        }
+
+        if (pfds[1].revents & POLLIN)
+        {
+            char lixo[256];
+            while (read(s.despertar[0], lixo, sizeof(lixo)) > 0)
+                ;
+        }
+
+        for (int k = 2; k < n; k++)
+        {
+            int i = indices[k];
+            int aberta = 1;
+
+            // POLLHUP sem POLLIN pedido: o cliente fechou os dois sentidos e
+            // nao vai ler as respostas que faltam (nem as dos pedidos que
+            // ficaram no socket durante o limite)
+            if (pfds[k].revents & (POLLERR | POLLNVAL) || (pfds[k].revents & POLLHUP && !(pfds[k].events & POLLIN)))
+                aberta = 0;
+            if (aberta && (pfds[k].revents & (POLLIN | POLLHUP)))
+                aberta = _servidor_ler(&s, i);
+            if (aberta && (pfds[k].revents & POLLOUT))
+                aberta = _servidor_escrever(&s, i);
+
+            if (!aberta || _servidor_concluida(&s, i))
+                _servidor_fechar(&s, i);
+        }
+
+        // por ultimo, porque pode realocar a tabela de conexoes
+        if (pfds[0].revents & POLLIN)
+            _servidor_aceitar(&s, escuta);
+    }
+
+    pthread_mutex_lock(&s.mutex_fila);
+    s.encerrar = 1;
+    pthread_cond_broadcast(&s.tem_tarefa);
+    pthread_mutex_unlock(&s.mutex_fila);
+
+    // as tarefas ja na fila sao atendidas antes das threads sairem
+    for (int t = 0; t < n_threads; t++)
+        pthread_join(threads[t], NULL);
+
+    for (int i = 0; i < s.n_conexoes; i++)
+    {
+        if (s.conexoes[i].fd >= 0)
+            close(s.conexoes[i].fd);
+        free(s.conexoes[i].entrada);
+        free(s.conexoes[i].saida);
+    }
+
+    close(escuta);
+    unlink(argv[1]);
+    close(s.despertar[0]);
+    close(s.despertar[1]);
+
+    EstatisticasCache e = cache_resultados_estatisticas(s.cache);
+    printf("cache: %ld acertos, %ld de subcaminho, %ld faltas\n", e.acertos, e.acertos_subcaminho, e.faltas);
+
+    cache_resultados_destruir(s.cache);
+    for (int i = 0; i < s.n_labirintos; i++)
+        labirinto_destruir(s.labirintos[i]);
+
+    free(s.labirintos);
+    free(s.conexoes);
+    free(s.fila);
+    free(threads);
+    free(pfds);
+    free(indices);
+
+    return 0;
+}